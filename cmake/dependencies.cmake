@@ -18,6 +18,9 @@ set(LAYA_BUILD_EXAMPLES OFF CACHE BOOL "Disable laya examples" FORCE)
 set(LAYA_SDL_TARGETS_PROVIDED ON CACHE BOOL "Use parent SDL3 targets for laya" FORCE)
 add_subdirectory("${CMAKE_SOURCE_DIR}/external/laya" EXCLUDE_FROM_ALL)
 
+# The engine runs some systems on a pool of worker threads.
+find_package(Threads REQUIRED)
+
 function(engine_link_external_libraries ENGINE_TARGET_NAME)
   if(NOT TARGET ${ENGINE_TARGET_NAME})
     message(FATAL_ERROR "Target '${ENGINE_TARGET_NAME}' does not exist.")
@@ -31,6 +34,7 @@ function(engine_link_external_libraries ENGINE_TARGET_NAME)
       SDL3::SDL3
       SDL3_image::SDL3_image
       SDL3_ttf::SDL3_ttf
+      Threads::Threads
   )
 
   # Include the header only libs.
@@ -0,0 +1,157 @@
+#include <engine.hxx>
+#include <engine_builder.hxx>
+#include <scene_builder.hxx>
+
+#include <array>
+#include <random>
+#include <string>
+
+// A large field of drifting asteroids that bounce off each other, to measure the collision
+// broadphase and the contact solver in a real scene. Arrow keys move the camera, O and P zoom,
+// and clicking destroys the asteroids under the mouse.
+
+constexpr std::size_t asteroid_count = 100'000;
+constexpr float asteroid_radius = 32.f;
+constexpr float field_half_extent = 20000.f;
+
+struct field_scene_state {
+    float camera_speed;
+};
+
+void scene_on_load(engine::game_scene* scene) {
+    auto* state = scene->get_state<field_scene_state>();
+    engine::game_entities* entities = scene->get_entities();
+    engine::game_resources* resources = scene->get_resources();
+
+    constexpr std::array<std::string_view, 4> asteroid_images = {
+        "assets/space_war/asteroids/ice_1.png", "assets/space_war/asteroids/ice_2.png",
+        "assets/space_war/asteroids/ice_3.png", "assets/space_war/asteroids/ice_4.png"};
+
+    for (std::size_t i = 0; i < asteroid_images.size(); ++i) {
+        auto* sprite =
+            resources->sprite_get_or_create("asteroid_" + std::to_string(i), asteroid_images[i]);
+        sprite->set_size({asteroid_radius * 2.f, asteroid_radius * 2.f});
+        sprite->set_origin(sprite->get_size() * 0.5f);
+    }
+
+    std::mt19937 random{0x5eed};
+    std::uniform_real_distribution<float> position{-field_half_extent, field_half_extent};
+    std::uniform_real_distribution<float> speed{-80.f, 80.f};
+    std::uniform_real_distribution<float> spin{-90.f, 90.f};
+
+    for (std::size_t i = 0; i < asteroid_count; ++i) {
+        const std::string sprite_key = "asteroid_" + std::to_string(i % asteroid_images.size());
+        const entt::entity asteroid = entities->sprite_create_interpolated(sprite_key);
+
+        entities->set_transform_position(asteroid, {position(random), position(random)});
+        entities->set_velocity_linear(asteroid, {speed(random), speed(random)});
+        entities->set_velocity_angular(asteroid, spin(random));
+        entities->set_collider_circle(asteroid, asteroid_radius);
+
+        // Equal masses bouncing without loss or friction, so the field keeps drifting.
+        entities->set_body(asteroid, 1.f, 1.f, 0.f);
+    }
+
+    // Cells of a few asteroids across keep both re-filing and pair tests cheap.
+    entities->set_collision_grid(asteroid_radius * 8.f, 8.f);
+
+    state->camera_speed = 1200.f;
+
+    resources->text_static_get_or_create("stats_text", "Collision: -",
+                                         "assets/helipad/fonts/roboto_regular.ttf", 18.0f);
+}
+
+void scene_on_tick(engine::game_scene* scene, const float tick_interval) {
+    engine::game_entities* entities = scene->get_entities();
+
+    entities->systems_update(tick_interval);
+}
+
+void scene_on_input(engine::game_scene* scene) {
+    engine::game_engine* engine = scene->get_engine();
+    engine::game_camera* camera = scene->get_camera(engine::game_camera::default_name);
+    engine::game_input* input = engine->get_input();
+
+    if (input->is_key_pressed(engine::game_input_key::escape)) {
+        engine->stop_running();
+    }
+
+    if (input->is_key_pressed(engine::game_input_key::o)) {
+        camera->zoom_additive(-0.2f);
+    }
+
+    if (input->is_key_pressed(engine::game_input_key::p)) {
+        camera->zoom_additive(0.2f);
+    }
+}
+
+void scene_on_frame(engine::game_scene* scene, const float frame_interval) {
+    auto* state = scene->get_state<field_scene_state>();
+    engine::game_entities* entities = scene->get_entities();
+    engine::game_camera* camera = scene->get_camera(engine::game_camera::default_name);
+    engine::game_viewport* viewport = scene->get_viewport(engine::game_viewport::default_name);
+    engine::game_input* input = scene->get_engine()->get_input();
+
+    camera->move_position(input->get_movement_arrows() * state->camera_speed * frame_interval);
+
+    if (input->is_key_pressed(engine::game_input_key::mouse_left) == true) {
+        const glm::vec2 mouse_world_position =
+            viewport->screen_to_world(*camera, input->get_mouse_position());
+
+        std::array<entt::entity, 16> picked;
+        const std::size_t picked_count = entities->query_point(mouse_world_position, picked);
+        for (std::size_t i = 0; i < picked_count; ++i) {
+            entities->destroy(picked[i]);
+        }
+    }
+}
+
+void scene_on_draw(engine::game_scene* scene, float fraction_to_next_tick) {
+    engine::game_entities* entities = scene->get_entities();
+    engine::game_resources* resources = scene->get_resources();
+    engine::game_engine* engine = scene->get_engine();
+
+    entities->system_renderer_update(engine->get_renderer(), *resources, fraction_to_next_tick);
+
+    if (auto* stats_text = resources->text_static_get("stats_text")) {
+        const engine::game_system_stats collision = entities->systems().get_stats("collision");
+        const engine::game_system_stats solver = entities->systems().get_stats("solver");
+        stats_text->set_text("Collision: {:.2f} ms, {} candidates, solver: {:.2f} ms, {} contacts",
+                             collision.last_seconds * 1e3, entities->get_collision_pairs().size(),
+                             solver.last_seconds * 1e3, entities->get_solver_stats().contacts);
+        stats_text->set_origin_centered();
+
+        const glm::vec2 output_size = engine->get_renderer()->get_output_size();
+        engine->get_renderer()->text_draw_screen(stats_text, {output_size.x * 0.5f, 20.f});
+    }
+}
+
+struct field_engine_state {
+    field_scene_state field_scene;
+};
+
+void game_entry_point() {
+    auto engine_state = std::make_unique<field_engine_state>();
+
+    auto game = engine::engine_builder()
+        .window("Asteroid Field", {1280, 720})
+        .state(engine_state.get())
+        .on_start([](engine::game_engine& engine) {
+            auto* state = engine::engine_builder::get_user_state<field_engine_state>(engine);
+
+            engine::scene_builder("field_scene")
+                .state(&state->field_scene)
+                .on_load([](engine::game_scene& s) { scene_on_load(&s); })
+                .on_input([](engine::game_scene& s) { scene_on_input(&s); })
+                .on_tick([](engine::game_scene& s, float dt) { scene_on_tick(&s, dt); })
+                .on_frame([](engine::game_scene& s, float dt) { scene_on_frame(&s, dt); })
+                .on_draw([](engine::game_scene& s, float f) { scene_on_draw(&s, f); })
+                .register_with(engine.get_scenes(), true);
+        })
+        .on_end([](engine::game_engine& engine) {
+            engine.get_scenes()->unload_scene("field_scene");
+        })
+        .build();
+
+    game->start_running();
+}
@@ -0,0 +1,88 @@
+/**
+ * @file benchmark.hxx
+ * @brief Tiny timing harness shared by the benchmark suites.
+ */
+
+#pragma once
+
+#include <engine.hxx>
+#include <laya/logging/log.hpp>
+
+#include <cstdint>
+#include <random>
+#include <string_view>
+
+namespace benchmark {
+    /**
+     * @brief Deterministic random source so every run measures the same scene.
+     */
+    inline std::mt19937& random_engine() {
+        static std::mt19937 engine{0x5eed};
+        return engine;
+    }
+
+    inline float random_range(const float min, const float max) {
+        return std::uniform_real_distribution<float>{min, max}(random_engine());
+    }
+
+    /**
+     * @brief Fill `entities` with drifting, spinning interpolated sprites.
+     */
+    inline void populate_asteroids(engine::game_entities& entities, const std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            const entt::entity asteroid = entities.sprite_create_interpolated("asteroid");
+            entities.set_transform_position(
+                asteroid, {random_range(-5000.f, 5000.f), random_range(-5000.f, 5000.f)});
+            entities.set_velocity_linear(asteroid,
+                                         {random_range(-80.f, 80.f), random_range(-80.f, 80.f)});
+            entities.set_velocity_linear_drag(asteroid, random_range(0.f, 0.2f));
+            entities.set_velocity_linear_max(asteroid, 100.f);
+            entities.set_velocity_angular(asteroid, random_range(-90.f, 90.f));
+            entities.set_velocity_angular_max(asteroid, 360.f);
+        }
+    }
+
+    /**
+     * @brief Run `func` once to warm caches, then time `repeat` further calls.
+     * @return Average seconds per call.
+     */
+    template <class Func>
+    [[nodiscard]] double measure_seconds(const int repeat, Func&& func) {
+        func();
+
+        const std::uint64_t start = engine::performance_counter_value_current();
+        for (int i = 0; i < repeat; ++i) {
+            func();
+        }
+
+        return static_cast<double>(engine::performance_counter_seconds_since(start)) / repeat;
+    }
+
+    /**
+     * @brief Log one result line with the total and per-item cost.
+     */
+    inline void report(std::string_view suite, std::string_view name, const std::size_t items,
+                       const double seconds) {
+        const double nanoseconds_per_item = seconds * 1e9 / static_cast<double>(items);
+        laya::log_info("[{}] {:<28} {:>9} items {:>10.3f} ms {:>8.2f} ns/item", suite, name, items,
+                       seconds * 1e3, nanoseconds_per_item);
+    }
+
+    void run_physics();
+    void run_physics_parallel();
+    void run_lifetime();
+    void run_spawn();
+    void run_pool();
+    void run_hierarchy();
+    void run_scheduler();
+    void run_lod();
+    void run_jobs();
+    void run_collision();
+    void run_spatial();
+    void run_solver();
+    void run_tiles();
+    void run_flocking();
+    void run_flow_fields();
+    void run_particles();
+    void run_render();
+}  // namespace benchmark
@@ -0,0 +1,188 @@
+/**
+ * @file collision.cxx
+ * @brief Finding overlapping asteroids, pairwise over a view versus the spatial hash broadphase,
+ *        and bullets hitting small asteroids, at the end of each tick versus swept.
+ */
+
+#include "benchmark.hxx"
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace benchmark {
+    namespace {
+        constexpr float tick_interval = 1.f / 32.f;
+        constexpr int ticks_per_sample = 64;
+        constexpr float asteroid_radius = 32.f;
+        constexpr float pebble_radius = 6.f;
+        constexpr float bullet_radius = 2.f;
+        constexpr float bullet_speed = 1000.f;
+        constexpr std::uint32_t bullet_layer = 2;
+
+        /**
+         * @brief Drifting asteroids with circle colliders, as dense as 100k asteroids over
+         *        40000 x 40000 units, where each one overlaps about one other.
+         */
+        void populate_field(engine::game_entities& entities, const std::size_t count) {
+            const float half_extent = 20000.f * std::sqrt(static_cast<float>(count) / 100'000.f);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                const entt::entity asteroid = entities.sprite_create_interpolated("asteroid");
+                entities.set_transform_position(asteroid,
+                                                {random_range(-half_extent, half_extent),
+                                                 random_range(-half_extent, half_extent)});
+                entities.set_velocity_linear(
+                    asteroid, {random_range(-80.f, 80.f), random_range(-80.f, 80.f)});
+                entities.set_collider_circle(asteroid, asteroid_radius);
+            }
+        }
+
+        /**
+         * @brief What games did before the broadphase existed.
+         */
+        std::size_t collide_pairwise(engine::game_entities& entities,
+                                     std::vector<entt::entity>& bodies) {
+            bodies.clear();
+            for (const entt::entity entity : entities.view<engine::component_transform>()) {
+                bodies.push_back(entity);
+            }
+
+            std::size_t pairs = 0;
+            for (std::size_t i = 0; i < bodies.size(); ++i) {
+                const glm::vec2 first =
+                    entities.get<engine::component_transform>(bodies[i]).position;
+
+                for (std::size_t j = i + 1; j < bodies.size(); ++j) {
+                    const glm::vec2 offset =
+                        entities.get<engine::component_transform>(bodies[j]).position - first;
+
+                    if (glm::dot(offset, offset) <= 4.f * asteroid_radius * asteroid_radius) {
+                        ++pairs;
+                    }
+                }
+            }
+
+            return pairs;
+        }
+
+        /**
+         * @brief Bullets among the candidate pairs that overlap a pebble at the end of the tick,
+         *        which is all a discrete test can see.
+         */
+        std::size_t count_overlapping_bullets(engine::game_entities& entities) {
+            std::size_t hits = 0;
+            for (const engine::game_collision_pair& pair : entities.get_collision_pairs()) {
+                const bool is_bullet_pair =
+                    (entities.get<engine::component_collider>(pair.first).layers |
+                     entities.get<engine::component_collider>(pair.second).layers) == 3;
+                const glm::vec2 offset = entities.get_transform_position(pair.second) -
+                                         entities.get_transform_position(pair.first);
+                const float reach = pebble_radius + bullet_radius;
+
+                if (is_bullet_pair == true && glm::dot(offset, offset) <= reach * reach) {
+                    ++hits;
+                }
+            }
+
+            return hits;
+        }
+
+        /**
+         * @brief At 32 ticks per second a bullet moves 31 units per tick, far more than the
+         *        pebbles it should hit are wide.
+         */
+        void run_bullets(const std::size_t pebble_count, const std::size_t bullet_count) {
+            engine::game_entities entities;
+            const float half_extent =
+                20000.f * std::sqrt(static_cast<float>(pebble_count) / 100'000.f);
+
+            for (std::size_t i = 0; i < pebble_count; ++i) {
+                const entt::entity pebble = entities.sprite_create("pebble");
+                entities.set_transform_position(pebble, {random_range(-half_extent, half_extent),
+                                                         random_range(-half_extent, half_extent)});
+                entities.set_collider_circle(pebble, pebble_radius, 1, bullet_layer);
+            }
+
+            std::vector<entt::entity> bullets;
+            for (std::size_t i = 0; i < bullet_count; ++i) {
+                const entt::entity bullet = entities.sprite_create_interpolated("bullet");
+                const float angle = random_range(0.f, 6.2831853f);
+                entities.set_transform_position(bullet, {random_range(-half_extent, half_extent),
+                                                         random_range(-half_extent, half_extent)});
+                entities.set_velocity_linear(
+                    bullet, glm::vec2{std::cos(angle), std::sin(angle)} * bullet_speed);
+                entities.set_collider_circle(bullet, bullet_radius, bullet_layer, 1);
+                bullets.push_back(bullet);
+            }
+
+            std::size_t discrete_hits = 0;
+            double discrete_seconds = 0.0;
+            for (int tick = 0; tick < ticks_per_sample; ++tick) {
+                entities.system_physics_update(tick_interval);
+
+                const std::uint64_t start = engine::performance_counter_value_current();
+                entities.system_collision_update();
+                discrete_seconds += engine::performance_counter_seconds_since(start);
+                discrete_hits += count_overlapping_bullets(entities);
+            }
+
+            for (const entt::entity bullet : bullets) {
+                entities.set_collider_continuous(bullet, true);
+            }
+
+            std::size_t swept_hits = 0;
+            double swept_seconds = 0.0;
+            for (int tick = 0; tick < ticks_per_sample; ++tick) {
+                entities.system_physics_update(tick_interval);
+
+                const std::uint64_t start = engine::performance_counter_value_current();
+                entities.system_collision_update();
+                swept_seconds += engine::performance_counter_seconds_since(start);
+                swept_hits += entities.get_collision_contacts().size();
+            }
+
+            report("collision", "bullets/discrete (before)", pebble_count + bullet_count,
+                   discrete_seconds / ticks_per_sample);
+            report("collision", "bullets/swept (after)", pebble_count + bullet_count,
+                   swept_seconds / ticks_per_sample);
+            laya::log_info("[collision] bullet hits over {} ticks: {} discrete, {} swept",
+                           ticks_per_sample, discrete_hits, swept_hits);
+        }
+    }  // namespace
+
+    void run_collision() {
+        constexpr std::array<std::size_t, 3> body_counts = {2'000, 10'000, 100'000};
+        constexpr std::size_t pairwise_limit = 10'000;
+
+        for (const std::size_t count : body_counts) {
+            engine::game_entities entities;
+            populate_field(entities, count);
+
+            if (count <= pairwise_limit) {
+                std::vector<entt::entity> bodies;
+                std::size_t pairs = 0;
+                const double pairwise_seconds =
+                    measure_seconds(4, [&] { pairs = collide_pairwise(entities, bodies); });
+                report("collision", "pairwise (before)", count, pairwise_seconds);
+                laya::log_info("[collision] {} overlapping pairs", pairs);
+            }
+
+            // Physics moves the field between samples, as it would in a game.
+            entities.system_collision_update();
+            double broadphase_seconds = 0.0;
+            for (int tick = 0; tick < ticks_per_sample; ++tick) {
+                entities.system_physics_update(tick_interval);
+
+                const std::uint64_t start = engine::performance_counter_value_current();
+                entities.system_collision_update();
+                broadphase_seconds += engine::performance_counter_seconds_since(start);
+            }
+
+            report("collision", "broadphase (after)", count, broadphase_seconds / ticks_per_sample);
+            laya::log_info("[collision] {} candidate pairs", entities.get_collision_pairs().size());
+        }
+
+        run_bullets(100'000, 2'000);
+    }
+}  // namespace benchmark
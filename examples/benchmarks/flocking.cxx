@@ -0,0 +1,126 @@
+/**
+ * @file flocking.cxx
+ * @brief Neighbourhood queries for swarms, every pair tested versus the counting sort grid, and
+ *        the throughput of flocking across worker threads.
+ */
+
+#include "benchmark.hxx"
+
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace benchmark {
+    namespace {
+        constexpr float tick_interval = 1.f / 32.f;
+        constexpr int ticks_per_sample = 32;
+        constexpr float agent_spacing = 24.f;
+
+        /**
+         * @brief Agents spread over a square about `agent_spacing` apart, so each sees around
+         *        twenty others within the default radius.
+         */
+        void populate_swarm(engine::game_entities& entities, const std::size_t count) {
+            const float half_extent = std::sqrt(static_cast<float>(count)) * agent_spacing * 0.5f;
+
+            for (std::size_t i = 0; i < count; ++i) {
+                const entt::entity agent = entities.create();
+                entities.add<engine::component_transform>(agent);
+                entities.set_transform_position(agent, {random_range(-half_extent, half_extent),
+                                                        random_range(-half_extent, half_extent)});
+                entities.set_flock(agent, static_cast<std::uint32_t>(i % 4));
+                entities.set_velocity_linear(
+                    agent, {random_range(-100.f, 100.f), random_range(-100.f, 100.f)});
+            }
+        }
+
+        /**
+         * @brief What the neighbourhood replaces: every agent tested against every other one.
+         */
+        std::size_t count_neighbors_naive(engine::game_entities& entities, const float radius) {
+            std::vector<glm::vec2> positions;
+            for (auto [entity, flock, transform] :
+                 entities.registry()
+                     .view<engine::component_flock, engine::component_transform>()
+                     .each()) {
+                positions.push_back(transform.position);
+            }
+
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < positions.size(); ++i) {
+                for (std::size_t j = 0; j < positions.size(); ++j) {
+                    const glm::vec2 offset = positions[j] - positions[i];
+                    if (i != j && glm::dot(offset, offset) <= radius * radius) {
+                        ++count;
+                    }
+                }
+            }
+
+            return count;
+        }
+    }  // namespace
+
+    void run_flocking() {
+        // The naive pass is quadratic, so it only runs at the smaller sizes.
+        constexpr std::array<std::size_t, 3> agent_counts = {5'000, 20'000, 50'000};
+        constexpr std::size_t naive_limit = 20'000;
+
+        for (const std::size_t count : agent_counts) {
+            random_engine().seed(0x5eed);
+
+            engine::game_entities entities;
+            populate_swarm(entities, count);
+            engine::system_flocking_settings& settings = entities.get_flocking_settings();
+            settings.max_neighbors = 0;
+
+            if (count <= naive_limit) {
+                std::size_t naive_neighbors = 0;
+                report("flocking", "all pairs (before)", count, measure_seconds(1, [&] {
+                           naive_neighbors = count_neighbors_naive(entities, settings.radius);
+                       }));
+                laya::log_info("[flocking] {} neighbours found by testing all pairs",
+                               naive_neighbors);
+            }
+
+            // Steering too, since the grid is rebuilt inside every update.
+            report("flocking", "grid + steering (after)", count, measure_seconds(4, [&] {
+                       entities.system_flocking_update(tick_interval);
+                   }));
+            laya::log_info("[flocking] {} neighbours found through the grid",
+                           entities.get_flocking_stats().neighbors);
+        }
+
+        // Throughput of a moving swarm as threads are added.
+        constexpr std::size_t swarm_size = 50'000;
+        std::vector<std::size_t> thread_counts;
+        for (std::size_t threads = 1; threads < engine::game_workers::default_thread_count();
+             threads *= 2) {
+            thread_counts.push_back(threads);
+        }
+        thread_counts.push_back(engine::game_workers::default_thread_count());
+
+        for (const std::size_t threads : thread_counts) {
+            random_engine().seed(0x5eed);
+
+            engine::game_workers workers{threads};
+            engine::game_entities entities;
+            populate_swarm(entities, swarm_size);
+            entities.get_flocking_settings().workers = &workers;
+
+            double seconds = 0.0;
+            for (int tick = 0; tick < ticks_per_sample; ++tick) {
+                const std::uint64_t start = engine::performance_counter_value_current();
+                entities.system_flocking_update(tick_interval);
+                seconds += engine::performance_counter_seconds_since(start);
+
+                entities.system_physics_update(tick_interval);
+            }
+
+            report("flocking", std::to_string(threads) + " threads", swarm_size,
+                   seconds / ticks_per_sample);
+            laya::log_info("[flocking] {} agents per second",
+                           static_cast<double>(swarm_size) * ticks_per_sample / seconds);
+        }
+    }
+}  // namespace benchmark
@@ -0,0 +1,217 @@
+/**
+ * @file flow_fields.cxx
+ * @brief Pathfinding for many agents, A* per agent versus shared flow fields, and the cost of
+ *        building and repairing fields by grid size.
+ */
+
+#include "benchmark.hxx"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace benchmark {
+    namespace {
+        constexpr float tick_interval = 1.f / 32.f;
+        constexpr float tile_size = 32.f;
+        constexpr int room_size = 16;
+        constexpr std::size_t goal_count = 8;
+
+        /**
+         * @brief Rooms of `room_size` tiles with a door in the middle of each wall, so paths
+         *        wind through doors rather than run straight.
+         */
+        void populate_rooms(engine::game_flow_fields& fields, const int size) {
+            fields.resize({size, size}, tile_size);
+            for (int line = 0; line < size; line += room_size) {
+                fields.fill_cost({line, 0}, {line, size - 1}, engine::game_flow_fields::blocked);
+                fields.fill_cost({0, line}, {size - 1, line}, engine::game_flow_fields::blocked);
+            }
+            for (int line = 0; line < size; line += room_size) {
+                for (int door = room_size / 2; door < size; door += room_size) {
+                    fields.set_cost({line, door}, 1);
+                    fields.set_cost({door, line}, 1);
+                }
+            }
+        }
+
+        glm::ivec2 random_open_tile(const engine::game_flow_fields& fields) {
+            const glm::ivec2 dimensions = fields.get_dimensions();
+            glm::ivec2 tile = {0, 0};
+            do {
+                tile = {static_cast<int>(random_range(0.f, static_cast<float>(dimensions.x))),
+                        static_cast<int>(random_range(0.f, static_cast<float>(dimensions.y)))};
+            } while (fields.get_cost(tile) == engine::game_flow_fields::blocked);
+
+            return tile;
+        }
+
+        /**
+         * @brief What the fields replace: one A* search per agent, over the same costs and steps.
+         * @return Length of the path found, in step costs.
+         */
+        std::uint32_t find_path_a_star(const engine::game_flow_fields& fields,
+                                       const glm::ivec2& start, const glm::ivec2& goal) {
+            constexpr std::array<glm::ivec2, 8> offsets = {{
+                {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}}};
+            const glm::ivec2 dimensions = fields.get_dimensions();
+            const auto index_of = [&](const glm::ivec2& tile) {
+                return static_cast<std::uint32_t>((tile.y * dimensions.x) + tile.x);
+            };
+            const auto estimate = [&](const glm::ivec2& tile) {
+                const int dx = std::abs(goal.x - tile.x);
+                const int dy = std::abs(goal.y - tile.y);
+                return static_cast<std::uint32_t>((5 * (dx + dy)) - (3 * std::min(dx, dy)));
+            };
+
+            std::vector<std::uint32_t> distances(
+                static_cast<std::size_t>(dimensions.x) * static_cast<std::size_t>(dimensions.y),
+                engine::game_flow_fields::unreachable);
+            std::vector<std::uint64_t> open;
+            distances[index_of(start)] = 0;
+            open.push_back((static_cast<std::uint64_t>(estimate(start)) << 32) | index_of(start));
+
+            while (open.empty() == false) {
+                std::pop_heap(open.begin(), open.end(), std::greater<>{});
+                const auto index = static_cast<std::uint32_t>(open.back());
+                open.pop_back();
+
+                const glm::ivec2 tile = {static_cast<int>(index) % dimensions.x,
+                                         static_cast<int>(index) / dimensions.x};
+                if (tile == goal) {
+                    return distances[index];
+                }
+
+                for (std::size_t step = 0; step < offsets.size(); ++step) {
+                    const glm::ivec2 next = tile + offsets[step];
+                    const std::uint8_t cost = fields.get_cost(next);
+                    if (cost == engine::game_flow_fields::blocked ||
+                        (step % 2 == 1 &&
+                         (fields.get_cost({next.x, tile.y}) == engine::game_flow_fields::blocked ||
+                          fields.get_cost({tile.x, next.y}) ==
+                              engine::game_flow_fields::blocked))) {
+                        continue;
+                    }
+
+                    const std::uint32_t candidate =
+                        distances[index] + ((step % 2 == 1 ? 7u : 5u) * cost);
+                    if (candidate < distances[index_of(next)]) {
+                        distances[index_of(next)] = candidate;
+                        open.push_back(
+                            (static_cast<std::uint64_t>(candidate + estimate(next)) << 32) |
+                            index_of(next));
+                        std::push_heap(open.begin(), open.end(), std::greater<>{});
+                    }
+                }
+            }
+
+            return engine::game_flow_fields::unreachable;
+        }
+    }  // namespace
+
+    void run_flow_fields() {
+        // A* per agent grows with both the grid and the agents, so it only runs on smaller grids.
+        constexpr std::array<int, 4> grid_sizes = {64, 128, 256, 512};
+        constexpr int a_star_limit = 256;
+        constexpr std::size_t agent_count = 256;
+
+        engine::game_workers workers{engine::game_workers::default_thread_count()};
+
+        for (const int size : grid_sizes) {
+            random_engine().seed(0x5eed);
+
+            engine::game_flow_fields fields;
+            populate_rooms(fields, size);
+            const std::size_t tile_count = static_cast<std::size_t>(size) * size;
+            const std::string grid = std::to_string(size) + "x" + std::to_string(size);
+
+            std::vector<glm::ivec2> goals;
+            for (std::size_t i = 0; i < goal_count; ++i) {
+                goals.push_back(random_open_tile(fields));
+            }
+
+            if (size <= a_star_limit) {
+                std::vector<glm::ivec2> starts;
+                for (std::size_t i = 0; i < agent_count; ++i) {
+                    starts.push_back(random_open_tile(fields));
+                }
+
+                report("flow_fields", grid + " a* per agent (before)", agent_count,
+                       measure_seconds(1, [&] {
+                           for (std::size_t i = 0; i < agent_count; ++i) {
+                               static_cast<void>(
+                                   find_path_a_star(fields, starts[i], goals[i % goal_count]));
+                           }
+                       }));
+                report("flow_fields", grid + " fields for all (after)", agent_count,
+                       measure_seconds(1, [&] {
+                           fields.clear();
+                           for (const glm::ivec2& goal : goals) {
+                               static_cast<void>(fields.request(goal));
+                           }
+                           fields.build();
+                       }));
+            }
+
+            report("flow_fields", grid + " field build", tile_count, measure_seconds(4, [&] {
+                       fields.clear();
+                       static_cast<void>(fields.request(goals.front()));
+                       fields.build();
+                   }));
+
+            report("flow_fields", grid + " fields on workers", tile_count * goal_count,
+                   measure_seconds(4, [&] {
+                       fields.clear();
+                       for (const glm::ivec2& goal : goals) {
+                           static_cast<void>(fields.request(goal));
+                       }
+                       fields.build(&workers);
+                   }));
+
+            // A door of the first room shutting and opening again, seen by every cached field.
+            bool is_door_shut = false;
+            report("flow_fields", grid + " repair after door", goal_count,
+                   measure_seconds(8, [&] {
+                       is_door_shut = is_door_shut == false;
+                       fields.set_cost({room_size / 2, room_size},
+                                       is_door_shut == true ? engine::game_flow_fields::blocked
+                                                            : 1);
+                       fields.build(&workers);
+                   }));
+            laya::log_info("[flow_fields] {} tiles settled repairing {} fields",
+                           fields.get_stats().settled, fields.get_stats().repaired);
+        }
+
+        // Agents sampling their fields every tick, with all the fields cached.
+        constexpr std::array<std::size_t, 2> swarm_sizes = {1'000, 20'000};
+        for (const std::size_t count : swarm_sizes) {
+            random_engine().seed(0x5eed);
+
+            engine::game_entities entities;
+            engine::game_flow_fields& fields = entities.get_flow_fields();
+            populate_rooms(fields, 256);
+            entities.get_flow_settings().workers = &workers;
+
+            std::vector<glm::vec2> destinations;
+            for (std::size_t i = 0; i < goal_count; ++i) {
+                destinations.push_back(fields.get_tile_center(random_open_tile(fields)));
+            }
+
+            for (std::size_t i = 0; i < count; ++i) {
+                const entt::entity agent = entities.create();
+                entities.add<engine::component_transform>(agent);
+                entities.set_transform_position(
+                    agent, fields.get_tile_center(random_open_tile(fields)));
+                entities.set_flow_destination(agent, destinations[i % goal_count], 120.f);
+            }
+
+            report("flow_fields", "agents following fields", count, measure_seconds(32, [&] {
+                       entities.system_flow_update(tick_interval);
+                       entities.system_physics_update(tick_interval);
+                   }));
+        }
+    }
+}  // namespace benchmark
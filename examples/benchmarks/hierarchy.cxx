@@ -0,0 +1,94 @@
+/**
+ * @file hierarchy.cxx
+ * @brief Cost of keeping attachments (turrets, labels, flames) glued to their ships.
+ */
+
+#include "benchmark.hxx"
+
+#include <array>
+#include <vector>
+
+namespace benchmark {
+    namespace {
+        constexpr int ticks_per_sample = 64;
+        constexpr std::size_t attachments_per_ship = 3;
+
+        const std::array<glm::vec2, attachments_per_ship> attachment_offsets = {
+            glm::vec2{0.f, 12.f}, glm::vec2{0.f, 30.f}, glm::vec2{0.f, -20.f}};
+
+        struct fleet {
+            std::vector<entt::entity> ships;
+            std::vector<entt::entity> attachments;
+        };
+
+        fleet populate_fleet(engine::game_entities& entities, const std::size_t ship_count,
+                             const bool is_attached) {
+            fleet result;
+            populate_asteroids(entities, ship_count);
+
+            for (const entt::entity ship : entities.view<engine::component_velocity_linear>()) {
+                result.ships.push_back(ship);
+
+                for (const glm::vec2& offset : attachment_offsets) {
+                    const entt::entity attachment = entities.sprite_create("turret");
+                    entities.set_transform_position(attachment, offset);
+                    result.attachments.push_back(attachment);
+
+                    if (is_attached == true) {
+                        entities.attach(attachment, ship);
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        /**
+         * @brief What scenes did by hand before attachments existed.
+         */
+        void follow_by_hand(engine::game_entities& entities, const fleet& ships) {
+            for (std::size_t i = 0; i < ships.attachments.size(); ++i) {
+                const entt::entity ship = ships.ships[i / attachments_per_ship];
+                const glm::vec2 offset = attachment_offsets[i % attachments_per_ship];
+                const glm::vec2 ship_position = entities.get_interpolated_position(ship, 1.f);
+
+                entities.set_transform_position(ships.attachments[i], ship_position + offset);
+            }
+        }
+    }  // namespace
+
+    void run_hierarchy() {
+        constexpr std::array<std::size_t, 3> ship_counts = {1'000, 10'000, 100'000};
+
+        for (const std::size_t count : ship_counts) {
+            const std::size_t items = count * attachments_per_ship;
+
+            engine::game_entities manual_entities;
+            const fleet manual_fleet = populate_fleet(manual_entities, count, false);
+
+            const double manual_seconds = measure_seconds(
+                ticks_per_sample, [&] { follow_by_hand(manual_entities, manual_fleet); });
+            report("hierarchy", "follow/by hand (before)", items, manual_seconds);
+
+            engine::game_entities attached_entities;
+            populate_fleet(attached_entities, count, true);
+
+            // Every ship moves each tick, so every attachment is recomposed.
+            auto& registry = attached_entities.registry();
+            const double moving_seconds = measure_seconds(ticks_per_sample, [&] {
+                auto ships = registry.view<engine::component_transform,
+                                           engine::component_velocity_linear>();
+                for (const entt::entity ship : ships) {
+                    ships.get<engine::component_transform>(ship).position.x += 1.f;
+                }
+                engine::system_hierarchy::update(registry);
+            });
+            report("hierarchy", "follow/moving (after)", items, moving_seconds);
+
+            // Nothing moves, so the sweep only compares inputs.
+            const double still_seconds = measure_seconds(
+                ticks_per_sample, [&] { engine::system_hierarchy::update(registry); });
+            report("hierarchy", "follow/still (after)", items, still_seconds);
+        }
+    }
+}  // namespace benchmark
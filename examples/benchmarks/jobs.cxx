@@ -0,0 +1,94 @@
+/**
+ * @file jobs.cxx
+ * @brief A large rebuild run in one tick versus time-sliced over several.
+ */
+
+#include "benchmark.hxx"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace benchmark {
+    namespace {
+        /**
+         * @brief Stand-in for a spatial rebuild: bucket every asteroid position into a coarse
+         *        grid, a fixed number of asteroids per step.
+         */
+        struct rebuild_job {
+            static constexpr std::size_t step_size = 1024;
+
+            engine::game_entities* entities;
+            std::vector<entt::entity> bodies;
+            std::vector<std::uint32_t> cells;
+            std::size_t next = 0;
+        };
+
+        float rebuild_step(void* user_data) {
+            auto* job = static_cast<rebuild_job*>(user_data);
+            const std::size_t last =
+                std::min(job->next + rebuild_job::step_size, job->bodies.size());
+
+            for (; job->next < last; ++job->next) {
+                const glm::vec2 position =
+                    job->entities->get<engine::component_transform>(job->bodies[job->next])
+                        .position;
+                const auto x = static_cast<std::uint32_t>((position.x + 5000.f) / 64.f);
+                const auto y = static_cast<std::uint32_t>((position.y + 5000.f) / 64.f);
+                job->cells[job->next] = (y << 16) | x;
+            }
+
+            return static_cast<float>(job->next) / static_cast<float>(job->bodies.size());
+        }
+
+        void prepare_job(rebuild_job& job, engine::game_entities& entities) {
+            job.entities = &entities;
+            job.bodies.clear();
+            for (const entt::entity entity :
+                 entities.registry().view<engine::component_transform>()) {
+                job.bodies.push_back(entity);
+            }
+            job.cells.assign(job.bodies.size(), 0);
+            job.next = 0;
+        }
+    }  // namespace
+
+    void run_jobs() {
+        constexpr std::array<std::size_t, 2> body_counts = {100'000, 1'000'000};
+        constexpr std::uint32_t budget_microseconds = 2'000;
+
+        for (const std::size_t count : body_counts) {
+            engine::game_entities entities;
+            populate_asteroids(entities, count);
+
+            rebuild_job job;
+            prepare_job(job, entities);
+            const double spike_seconds = measure_seconds(1, [&] {
+                job.next = 0;
+                while (rebuild_step(&job) < 1.0f) {
+                }
+            });
+            report("jobs", "rebuild/one tick (before)", count, spike_seconds);
+
+            // Slice the same rebuild, timing each tick's share.
+            engine::game_jobs jobs;
+            prepare_job(job, entities);
+            jobs.add("rebuild", &rebuild_step, budget_microseconds, engine::game_job_phase::tick,
+                     &job);
+
+            double slowest_seconds = 0.0;
+            while (jobs.is_finished("rebuild") == false) {
+                const std::uint64_t start = engine::performance_counter_value_current();
+                jobs.run(engine::game_job_phase::tick);
+                const double seconds = engine::performance_counter_seconds_since(start);
+                slowest_seconds = std::max(slowest_seconds, seconds);
+            }
+
+            const engine::game_job_stats stats = jobs.get_stats("rebuild");
+            report("jobs", "rebuild/sliced (after)", count, stats.total_seconds);
+            laya::log_info("[jobs] {} slices, slowest {:.3f} ms, {} overruns (max {:.3f} ms)",
+                           stats.slice_count, slowest_seconds * 1e3, stats.overrun_count,
+                           stats.overrun_seconds_max * 1e3);
+        }
+    }
+}  // namespace benchmark
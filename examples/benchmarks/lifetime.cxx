@@ -0,0 +1,71 @@
+/**
+ * @file lifetime.cxx
+ * @brief Per-tick cost of expiring short-lived entities.
+ */
+
+#include "benchmark.hxx"
+
+#include <array>
+#include <vector>
+
+namespace benchmark {
+    namespace {
+        constexpr float tick_interval = 1.f / 32.f;
+        constexpr int ticks_per_sample = 64;
+
+        /**
+         * @brief Bullets living between 1 and 10 seconds, so a few expire on every tick.
+         */
+        void populate_bullets(engine::game_entities& entities, const std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) {
+                const entt::entity bullet = entities.create();
+                entities.add<engine::component_lifetime>(bullet, random_range(1.f, 10.f));
+            }
+        }
+
+        /**
+         * @brief The countdown loop `system_lifetime` used before the timing wheel, kept here as
+         *        the baseline.
+         */
+        void lifetime_countdown(entt::registry& registry, const float interval) {
+            auto view = registry.view<engine::component_lifetime>();
+            std::vector<entt::entity> entities_to_destroy;
+
+            for (auto [entity, lifetime] : view.each()) {
+                lifetime.remaining_seconds -= interval;
+
+                if (lifetime.remaining_seconds <= 0.0f) {
+                    entities_to_destroy.push_back(entity);
+                }
+            }
+
+            for (auto entity : entities_to_destroy) {
+                registry.destroy(entity);
+            }
+        }
+    }  // namespace
+
+    void run_lifetime() {
+        constexpr std::array<std::size_t, 3> entity_counts = {10'000, 50'000, 100'000};
+
+        for (const std::size_t count : entity_counts) {
+            engine::game_entities countdown_entities;
+            populate_bullets(countdown_entities, count);
+
+            const double countdown_seconds = measure_seconds(ticks_per_sample, [&] {
+                lifetime_countdown(countdown_entities.registry(), tick_interval);
+            });
+            report("lifetime", "expire/countdown (before)", count, countdown_seconds);
+
+            engine::game_entities wheel_entities;
+            populate_bullets(wheel_entities, count);
+
+            // The first update files every new lifetime, which is not part of the steady state.
+            wheel_entities.system_lifetime_update(tick_interval);
+
+            const double wheel_seconds = measure_seconds(
+                ticks_per_sample, [&] { wheel_entities.system_lifetime_update(tick_interval); });
+            report("lifetime", "expire/timing wheel (after)", count, wheel_seconds);
+        }
+    }
+}  // namespace benchmark
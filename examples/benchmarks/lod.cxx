@@ -0,0 +1,63 @@
+/**
+ * @file lod.cxx
+ * @brief Physics over a wide asteroid field, every body each tick versus update-rate LOD.
+ */
+
+#include "benchmark.hxx"
+
+#include <algorithm>
+#include <array>
+
+namespace benchmark {
+    namespace {
+        constexpr float tick_interval = 1.f / 32.f;
+        constexpr int ticks_per_sample = 64;
+
+        /**
+         * @brief Time each tick separately, the slowest one shows whether buckets stay staggered.
+         */
+        void measure_ticks(engine::game_entities& entities, std::string_view name,
+                           const std::size_t count) {
+            double total_seconds = 0.0;
+            double slowest_seconds = 0.0;
+
+            for (int tick = 0; tick < ticks_per_sample; ++tick) {
+                const std::uint64_t start = engine::performance_counter_value_current();
+                entities.system_physics_update(tick_interval);
+                const double seconds = engine::performance_counter_seconds_since(start);
+
+                total_seconds += seconds;
+                slowest_seconds = std::max(slowest_seconds, seconds);
+            }
+
+            const double average_seconds = total_seconds / ticks_per_sample;
+            report("lod", name, count, average_seconds);
+            laya::log_info("[lod] {:<28} slowest tick {:>8.3f} ms ({:.2f}x average)", name,
+                           slowest_seconds * 1e3, slowest_seconds / average_seconds);
+        }
+    }  // namespace
+
+    void run_lod() {
+        constexpr std::array<std::size_t, 3> body_counts = {10'000, 100'000, 500'000};
+
+        for (const std::size_t count : body_counts) {
+            // Asteroids spread over 10000 units, one camera in the middle.
+            engine::game_entities full_rate;
+            populate_asteroids(full_rate, count);
+            full_rate.system_physics_update(tick_interval);
+            measure_ticks(full_rate, "field/every tick (before)", count);
+
+            engine::game_entities reduced_rate;
+            populate_asteroids(reduced_rate, count);
+            engine::system_physics_settings& settings = reduced_rate.get_physics_settings();
+            settings.is_lod_enabled = true;
+            settings.lod_focus = {{0.f, 0.f}};
+
+            // Let every body settle into its bucket before sampling.
+            for (int tick = 0; tick < 8; ++tick) {
+                reduced_rate.system_physics_update(tick_interval);
+            }
+            measure_ticks(reduced_rate, "field/lod (after)", count);
+        }
+    }
+}  // namespace benchmark
@@ -0,0 +1,30 @@
+#include "benchmark.hxx"
+
+#include <config.hxx>
+
+void game_entry_point() {
+    laya::log_info("Running helipad benchmarks (build type: {})", engine::build_type);
+
+    if constexpr (engine::is_debug_build) {
+        laya::log_warn("Debug build detected, configure with -DCMAKE_BUILD_TYPE=Release for "
+                       "meaningful numbers.");
+    }
+
+    benchmark::run_physics();
+    benchmark::run_physics_parallel();
+    benchmark::run_lifetime();
+    benchmark::run_spawn();
+    benchmark::run_pool();
+    benchmark::run_hierarchy();
+    benchmark::run_scheduler();
+    benchmark::run_lod();
+    benchmark::run_jobs();
+    benchmark::run_collision();
+    benchmark::run_spatial();
+    benchmark::run_solver();
+    benchmark::run_tiles();
+    benchmark::run_flocking();
+    benchmark::run_flow_fields();
+    benchmark::run_particles();
+    benchmark::run_render();
+}
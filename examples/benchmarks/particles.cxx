@@ -0,0 +1,111 @@
+/**
+ * @file particles.cxx
+ * @brief Per-tick cost of short-lived particles, one entity each versus emitter pools.
+ */
+
+#include "benchmark.hxx"
+
+#include <array>
+#include <string>
+
+namespace benchmark {
+    namespace {
+        constexpr float tick_interval = 1.f / 32.f;
+        constexpr int ticks_per_sample = 32;
+        constexpr std::size_t emitter_count = 16;
+
+        // Particles live 1 to 3 seconds, so a steady population of `count` spawns count / 2 a
+        // second.
+        constexpr float lifetime_min = 1.f;
+        constexpr float lifetime_max = 3.f;
+        constexpr float lifetime_mean = (lifetime_min + lifetime_max) * 0.5f;
+
+        entt::entity spawn_particle_entity(engine::game_entities& entities,
+                                           const float remaining_seconds) {
+            const entt::entity particle = entities.sprite_create_interpolated("spark");
+            entities.set_transform_position(
+                particle, {random_range(-500.f, 500.f), random_range(-500.f, 500.f)});
+            entities.set_velocity_linear(particle,
+                                         {random_range(-64.f, 64.f), random_range(-64.f, 64.f)});
+            entities.set_velocity_linear_drag(particle, 0.5f);
+            entities.add<engine::component_lifetime>(particle, remaining_seconds);
+            return particle;
+        }
+
+        /**
+         * @brief What emitters replace: each particle an interpolated sprite entity, moved by
+         *        physics and destroyed by its lifetime.
+         */
+        void run_entities(const std::size_t count) {
+            random_engine().seed(0x5eed);
+
+            engine::game_entities entities;
+            for (std::size_t i = 0; i < count; ++i) {
+                static_cast<void>(
+                    spawn_particle_entity(entities, random_range(0.f, lifetime_max)));
+            }
+
+            const float spawn_per_tick = static_cast<float>(count) * tick_interval / lifetime_mean;
+            float pending = 0.f;
+            report("particles", std::to_string(count) + " entities (before)", count,
+                   measure_seconds(ticks_per_sample, [&] {
+                       pending += spawn_per_tick;
+                       for (; pending >= 1.f; pending -= 1.f) {
+                           static_cast<void>(spawn_particle_entity(
+                               entities, random_range(lifetime_min, lifetime_max)));
+                       }
+                       entities.system_lifetime_update(tick_interval);
+                       entities.system_physics_update(tick_interval);
+                   }));
+        }
+
+        void run_emitters(const std::size_t count, engine::game_workers* workers,
+                          const std::string& name) {
+            engine::game_entities entities;
+            entities.get_particles_settings().max_particles = count;
+            entities.get_particles_settings().workers = workers;
+
+            engine::component_emitter emitter;
+            emitter.budget = static_cast<std::uint32_t>(count / emitter_count);
+            emitter.rate = static_cast<float>(emitter.budget) / lifetime_mean;
+            emitter.lifetime_min = lifetime_min;
+            emitter.lifetime_max = lifetime_max;
+            emitter.motion.drag = 0.5f;
+            emitter.motion.acceleration = {0.f, 98.f};
+            emitter.motion.size_end = 1.f;
+            for (std::size_t i = 0; i < emitter_count; ++i) {
+                const entt::entity source = entities.create();
+                entities.add<engine::component_transform>(source);
+                entities.set_transform_position(
+                    source, {random_range(-500.f, 500.f), random_range(-500.f, 500.f)});
+                entities.set_emitter(source, emitter);
+            }
+
+            // Fill the pools to their steady population before measuring.
+            const auto warmup_ticks = static_cast<int>(lifetime_max / tick_interval);
+            for (int tick = 0; tick < warmup_ticks; ++tick) {
+                entities.system_particles_update(tick_interval);
+            }
+
+            const std::size_t alive = entities.get_particles_stats().particles;
+            report("particles", std::to_string(count) + name, alive,
+                   measure_seconds(ticks_per_sample,
+                                   [&] { entities.system_particles_update(tick_interval); }));
+        }
+    }  // namespace
+
+    void run_particles() {
+        constexpr std::array<std::size_t, 3> particle_counts = {1'000, 10'000, 100'000};
+
+        engine::game_workers workers{engine::game_workers::default_thread_count()};
+
+        for (const std::size_t count : particle_counts) {
+            run_entities(count);
+            run_emitters(count, nullptr, " emitter pools (after)");
+            run_emitters(count, &workers, " pools on workers");
+        }
+
+        laya::log_info("[particles] pools draw as {} geometry calls a frame, one per emitter",
+                       emitter_count);
+    }
+}  // namespace benchmark
@@ -0,0 +1,126 @@
+/**
+ * @file physics.cxx
+ * @brief Per-entity cost of the physics tick.
+ */
+
+#include "benchmark.hxx"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+
+namespace benchmark {
+    namespace {
+        constexpr float tick_interval = 1.f / 32.f;
+        constexpr int ticks_per_sample = 64;
+
+        /**
+         * @brief The per-entity `try_get` loop that `system_physics` used before owning groups,
+         *        kept here as the baseline.
+         */
+        void integrate_velocity_lookup(entt::registry& registry, const float interval) {
+            auto view = registry.view<engine::component_transform>();
+
+            for (auto [entity, transform] : view.each()) {
+                if (auto* interpolation = registry.try_get<engine::component_interpolation>(entity)) {
+                    interpolation->previous_position = transform.position;
+                    interpolation->previous_rotation = transform.rotation;
+                }
+
+                if (auto* linear = registry.try_get<engine::component_velocity_linear>(entity)) {
+                    glm::vec2 velocity = linear->value;
+
+                    if (linear->drag > 0.0f) {
+                        velocity *= std::max(0.0f, 1.0f - (linear->drag * interval));
+                        linear->value = velocity;
+                    }
+
+                    if (linear->max_speed > 0.0f) {
+                        const float speed = glm::length(velocity);
+                        if (speed > linear->max_speed) {
+                            velocity = (velocity / speed) * linear->max_speed;
+                            linear->value = velocity;
+                        }
+                    }
+
+                    transform.position += velocity * interval;
+                }
+
+                if (auto* angular = registry.try_get<engine::component_velocity_angular>(entity)) {
+                    float velocity = angular->value;
+
+                    if (angular->drag > 0.0f) {
+                        velocity *= std::max(0.0f, 1.0f - (angular->drag * interval));
+                        angular->value = velocity;
+                    }
+
+                    if (angular->max_speed > 0.0f && std::abs(velocity) > angular->max_speed) {
+                        velocity = std::copysign(angular->max_speed, velocity);
+                        angular->value = velocity;
+                    }
+
+                    transform.rotation += velocity * interval;
+
+                    while (transform.rotation >= 360.0f) {
+                        transform.rotation -= 360.0f;
+                    }
+
+                    while (transform.rotation < 0.0f) {
+                        transform.rotation += 360.0f;
+                    }
+                }
+            }
+        }
+    }  // namespace
+
+    void run_physics() {
+        constexpr std::array<std::size_t, 3> entity_counts = {10'000, 50'000, 100'000};
+
+        for (const std::size_t count : entity_counts) {
+            engine::game_entities lookup_entities;
+            populate_asteroids(lookup_entities, count);
+
+            const double lookup_seconds = measure_seconds(ticks_per_sample, [&] {
+                integrate_velocity_lookup(lookup_entities.registry(), tick_interval);
+            });
+            report("physics", "integrate/try_get (before)", count, lookup_seconds);
+
+            engine::game_entities grouped_entities;
+            populate_asteroids(grouped_entities, count);
+
+            const double grouped_seconds = measure_seconds(
+                ticks_per_sample, [&] { grouped_entities.system_physics_update(tick_interval); });
+            report("physics", "integrate/groups (after)", count, grouped_seconds);
+
+            // The same bodies without interpolation, to price the previous-transform snapshot.
+            engine::game_entities plain_entities;
+            populate_asteroids(plain_entities, count);
+            plain_entities.registry().clear<engine::component_interpolation>();
+
+            const double plain_seconds = measure_seconds(
+                ticks_per_sample, [&] { plain_entities.system_physics_update(tick_interval); });
+            report("physics", "integrate/groups plain", count, plain_seconds);
+
+            // Same scene, one line per instruction set the CPU can run.
+            constexpr std::array<engine::physics_kernel, 4> kernels = {
+                engine::physics_kernel::scalar, engine::physics_kernel::sse2,
+                engine::physics_kernel::avx2, engine::physics_kernel::deterministic};
+
+            for (const engine::physics_kernel kernel : kernels) {
+                if (engine::physics_kernel_is_supported(kernel) == false) {
+                    continue;
+                }
+
+                grouped_entities.get_physics_settings().kernel = kernel;
+
+                const double kernel_seconds = measure_seconds(
+                    ticks_per_sample, [&] { grouped_entities.system_physics_update(tick_interval); });
+                report("physics",
+                       std::string{"integrate/kernel "} +
+                           std::string{engine::physics_kernel_name(kernel)},
+                       count, kernel_seconds);
+            }
+        }
+    }
+}  // namespace benchmark
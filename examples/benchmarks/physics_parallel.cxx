@@ -0,0 +1,85 @@
+/**
+ * @file physics_parallel.cxx
+ * @brief Scaling of the physics tick across worker threads.
+ */
+
+#include "benchmark.hxx"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace benchmark {
+    namespace {
+        constexpr float tick_interval = 1.f / 32.f;
+        constexpr int ticks_per_sample = 16;
+
+        /**
+         * @brief FNV-1a over every transform, used to prove that thread count does not change
+         *        the simulation.
+         */
+        std::uint64_t hash_transforms(engine::game_entities& entities) {
+            std::uint64_t hash = 14695981039346656037ull;
+
+            for (auto [entity, transform] :
+                 entities.registry().view<engine::component_transform>().each()) {
+                unsigned char bytes[sizeof(transform)];
+                std::memcpy(bytes, &transform, sizeof(transform));
+
+                for (const unsigned char byte : bytes) {
+                    hash = (hash ^ byte) * 1099511628211ull;
+                }
+            }
+
+            return hash;
+        }
+
+        /**
+         * @brief 1, 2, 4, ... up to and including the number of logical cores.
+         */
+        std::vector<std::size_t> thread_counts() {
+            const std::size_t max_threads = engine::game_workers::default_thread_count();
+
+            std::vector<std::size_t> counts;
+            for (std::size_t threads = 1; threads < max_threads; threads *= 2) {
+                counts.push_back(threads);
+            }
+            counts.push_back(max_threads);
+
+            return counts;
+        }
+    }  // namespace
+
+    void run_physics_parallel() {
+        constexpr std::array<std::size_t, 3> entity_counts = {10'000, 100'000, 1'000'000};
+
+        for (const std::size_t count : entity_counts) {
+            std::uint64_t reference_hash = 0;
+
+            for (const std::size_t threads : thread_counts()) {
+                engine::game_workers workers{threads};
+
+                random_engine().seed(0x5eed);
+                auto entities = std::make_unique<engine::game_entities>();
+                populate_asteroids(*entities, count);
+                entities->get_physics_settings().workers = &workers;
+
+                const double seconds = measure_seconds(
+                    ticks_per_sample, [&] { entities->system_physics_update(tick_interval); });
+                report("physics_parallel", "integrate/" + std::to_string(threads) + " threads",
+                       count, seconds);
+
+                // Same seed and tick count for every thread count, so the state must match.
+                const std::uint64_t hash = hash_transforms(*entities);
+                if (threads == 1) {
+                    reference_hash = hash;
+                } else if (hash != reference_hash) {
+                    laya::log_error("[physics_parallel] {} threads diverged from 1 thread", threads);
+                }
+            }
+        }
+    }
+}  // namespace benchmark
@@ -0,0 +1,72 @@
+/**
+ * @file pool.cxx
+ * @brief Steady churn of short-lived projectiles, created fresh versus drawn from a pool.
+ */
+
+#include "benchmark.hxx"
+
+#include <array>
+
+namespace benchmark {
+    namespace {
+        constexpr float tick_interval = 1.f / 32.f;
+        constexpr int ticks_per_sample = 64;
+
+        /**
+         * @brief Fire `count` projectiles living half a second to a second and a half, then run
+         *        the systems they pass through.
+         */
+        template <class Spawn>
+        void churn_tick(engine::game_entities& entities, const std::size_t count, Spawn spawn) {
+            for (std::size_t i = 0; i < count; ++i) {
+                const entt::entity projectile = spawn();
+                entities.set_velocity_linear(
+                    projectile, {random_range(-400.f, 400.f), random_range(-400.f, 400.f)});
+                entities.add<engine::component_lifetime>(projectile, random_range(0.5f, 1.5f));
+            }
+
+            entities.system_physics_update(tick_interval);
+            entities.system_lifetime_update(tick_interval);
+        }
+    }  // namespace
+
+    void run_pool() {
+        constexpr std::array<std::size_t, 3> spawns_per_tick = {100, 1'000, 5'000};
+
+        for (const std::size_t count : spawns_per_tick) {
+            const std::size_t items = count * ticks_per_sample;
+
+            // Run a couple of seconds first so both scenes reach the steady state.
+            engine::game_entities created;
+            const auto create = [&] { return created.sprite_create_interpolated("bullet"); };
+            for (int tick = 0; tick < 64; ++tick) {
+                churn_tick(created, count, create);
+            }
+
+            const double create_seconds = measure_seconds(1, [&] {
+                for (int tick = 0; tick < ticks_per_sample; ++tick) {
+                    churn_tick(created, count, create);
+                }
+            });
+            report("pool", "churn/create (before)", items, create_seconds);
+
+            engine::game_entities pooled;
+            const auto spawn = [&] { return pooled.pool_spawn("bullet"); };
+            for (int tick = 0; tick < 64; ++tick) {
+                churn_tick(pooled, count, spawn);
+            }
+
+            const double pool_seconds = measure_seconds(1, [&] {
+                for (int tick = 0; tick < ticks_per_sample; ++tick) {
+                    churn_tick(pooled, count, spawn);
+                }
+            });
+            report("pool", "churn/pool (after)", items, pool_seconds);
+
+            const engine::game_pool_stats stats = pooled.get_pool_stats("bullet");
+            laya::log_info("[pool] capacity {} active {} high water {} reused {} of {} spawns",
+                           stats.capacity, stats.active, stats.high_water, stats.reused,
+                           stats.spawned);
+        }
+    }
+}  // namespace benchmark
@@ -0,0 +1,205 @@
+/**
+ * @file render.cxx
+ * @brief Cost of blending every drawable to the frame, inline while drawing versus its own pass.
+ */
+
+#include "benchmark.hxx"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BENCHMARK_RENDER_HAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define BENCHMARK_RENDER_HAS_SSE2 0
+#endif
+
+namespace benchmark {
+    namespace {
+        constexpr int frames_per_sample = 64;
+        constexpr float fraction_to_next_tick = 0.37f;
+
+        /**
+         * @brief What the draw loop did before the pass: look up and blend each entity of the
+         *        render list on its own, with the wrap-around as a branch.
+         */
+        float blend_inline(entt::registry& registry, const std::vector<entt::entity>& drawn) {
+            const auto& transforms = registry.storage<engine::component_transform>();
+            const auto& interpolations = registry.storage<engine::component_interpolation>();
+
+            float checksum = 0.f;
+            for (const entt::entity entity : drawn) {
+                const engine::component_transform& transform = transforms.get(entity);
+                const engine::component_interpolation& interp = interpolations.get(entity);
+
+                const float fraction = interp.get_fraction(fraction_to_next_tick);
+                const glm::vec2 position =
+                    glm::mix(interp.previous_position, transform.position, fraction);
+
+                float difference = transform.rotation - interp.previous_rotation;
+                if (difference > 180.f) {
+                    difference -= 360.f;
+                } else if (difference < -180.f) {
+                    difference += 360.f;
+                }
+                const float rotation = interp.previous_rotation + (difference * fraction);
+
+                checksum += position.x + position.y + rotation;
+            }
+
+            return checksum;
+        }
+
+#if BENCHMARK_RENDER_HAS_SSE2
+        /**
+         * @brief The structure-of-arrays layout the SSE2 blend reads and writes, sized once.
+         */
+        struct blend_arrays {
+            std::vector<float> previous_x, previous_y, previous_rotation;
+            std::vector<float> x, y, rotation, fraction;
+            std::vector<float> blended_x, blended_y, blended_rotation;
+
+            explicit blend_arrays(const std::size_t count)
+                : previous_x(count),
+                  previous_y(count),
+                  previous_rotation(count),
+                  x(count),
+                  y(count),
+                  rotation(count),
+                  fraction(count),
+                  blended_x(count),
+                  blended_y(count),
+                  blended_rotation(count) {
+            }
+        };
+
+        /**
+         * @brief Fill `arrays` from the components, the lookups that feed the SSE2 blend.
+         */
+        void gather_arrays(entt::registry& registry, const std::vector<entt::entity>& drawn,
+                           blend_arrays& arrays) {
+            const auto& transforms = registry.storage<engine::component_transform>();
+            const auto& interpolations = registry.storage<engine::component_interpolation>();
+
+            for (std::size_t i = 0; i < drawn.size(); ++i) {
+                const engine::component_transform& transform = transforms.get(drawn[i]);
+                const engine::component_interpolation& interp = interpolations.get(drawn[i]);
+
+                arrays.previous_x[i] = interp.previous_position.x;
+                arrays.previous_y[i] = interp.previous_position.y;
+                arrays.previous_rotation[i] = interp.previous_rotation;
+                arrays.x[i] = transform.position.x;
+                arrays.y[i] = transform.position.y;
+                arrays.rotation[i] = transform.rotation;
+                arrays.fraction[i] = interp.get_fraction(fraction_to_next_tick);
+            }
+        }
+
+        /**
+         * @brief Blend four entities per step, with the wrap-around done by masks.
+         */
+        void blend_sse2(blend_arrays& arrays) {
+            const std::size_t count = arrays.x.size();
+            const __m128 half_turn = _mm_set1_ps(180.f);
+            const __m128 negative_half_turn = _mm_set1_ps(-180.f);
+            const __m128 full_turn = _mm_set1_ps(360.f);
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                const __m128 fraction = _mm_loadu_ps(&arrays.fraction[i]);
+
+                const __m128 previous_x = _mm_loadu_ps(&arrays.previous_x[i]);
+                const __m128 previous_y = _mm_loadu_ps(&arrays.previous_y[i]);
+                _mm_storeu_ps(&arrays.blended_x[i],
+                              _mm_add_ps(previous_x,
+                                         _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&arrays.x[i]),
+                                                               previous_x),
+                                                    fraction)));
+                _mm_storeu_ps(&arrays.blended_y[i],
+                              _mm_add_ps(previous_y,
+                                         _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&arrays.y[i]),
+                                                               previous_y),
+                                                    fraction)));
+
+                const __m128 previous_rotation = _mm_loadu_ps(&arrays.previous_rotation[i]);
+                __m128 difference =
+                    _mm_sub_ps(_mm_loadu_ps(&arrays.rotation[i]), previous_rotation);
+                difference = _mm_sub_ps(
+                    difference, _mm_and_ps(_mm_cmpgt_ps(difference, half_turn), full_turn));
+                difference = _mm_add_ps(
+                    difference,
+                    _mm_and_ps(_mm_cmplt_ps(difference, negative_half_turn), full_turn));
+                _mm_storeu_ps(&arrays.blended_rotation[i],
+                              _mm_add_ps(previous_rotation, _mm_mul_ps(difference, fraction)));
+            }
+
+            for (; i < count; ++i) {
+                const float fraction = arrays.fraction[i];
+                arrays.blended_x[i] =
+                    arrays.previous_x[i] + ((arrays.x[i] - arrays.previous_x[i]) * fraction);
+                arrays.blended_y[i] =
+                    arrays.previous_y[i] + ((arrays.y[i] - arrays.previous_y[i]) * fraction);
+
+                float difference = arrays.rotation[i] - arrays.previous_rotation[i];
+                if (difference > 180.f) {
+                    difference -= 360.f;
+                } else if (difference < -180.f) {
+                    difference += 360.f;
+                }
+                arrays.blended_rotation[i] = arrays.previous_rotation[i] + (difference * fraction);
+            }
+        }
+#endif
+    }  // namespace
+
+    void run_render() {
+        constexpr std::array<std::size_t, 3> sprite_counts = {1'000, 10'000, 100'000};
+
+        for (const std::size_t count : sprite_counts) {
+            random_engine().seed(0x5eed);
+
+            engine::game_entities entities;
+            populate_asteroids(entities, count);
+
+            // Two ticks so that previous and current transforms differ.
+            entities.system_physics_update(1.f / 32.f);
+            entities.system_physics_update(1.f / 32.f);
+
+            auto& registry = entities.registry();
+            engine::system_renderer::prepare(registry);
+
+            // Creation order, which is the order the render list holds them in.
+            std::vector<entt::entity> drawn;
+            for (const entt::entity entity : entities.view<engine::component_interpolation>()) {
+                drawn.push_back(entity);
+            }
+            std::sort(drawn.begin(), drawn.end());
+
+            volatile float sink = 0.f;
+            report("render", "blend/inline (before)", count,
+                   measure_seconds(frames_per_sample,
+                                   [&] { sink = blend_inline(registry, drawn); }));
+            report("render", "blend/render pass (after)", count,
+                   measure_seconds(frames_per_sample, [&] {
+                       engine::system_renderer::interpolate(registry, fraction_to_next_tick);
+                   }));
+
+#if BENCHMARK_RENDER_HAS_SSE2
+            // The SIMD structure-of-arrays pass that was adapted out: the blend on its own, then
+            // with the lookups that feed it, to compare against the scalar pass above.
+            blend_arrays arrays{drawn.size()};
+            gather_arrays(registry, drawn, arrays);
+            report("render", "blend/sse2 soa blend only", count,
+                   measure_seconds(frames_per_sample, [&] { blend_sse2(arrays); }));
+            report("render", "blend/sse2 soa with gather", count,
+                   measure_seconds(frames_per_sample, [&] {
+                       gather_arrays(registry, drawn, arrays);
+                       blend_sse2(arrays);
+                   }));
+#endif
+            static_cast<void>(sink);
+        }
+    }
+}  // namespace benchmark
@@ -0,0 +1,89 @@
+/**
+ * @file scheduler.cxx
+ * @brief Gameplay systems with disjoint component access, run one by one or overlapped.
+ */
+
+#include "benchmark.hxx"
+
+#include <array>
+#include <cmath>
+#include <memory>
+
+namespace benchmark {
+    namespace {
+        constexpr float tick_interval = 1.f / 32.f;
+        constexpr int ticks_per_sample = 16;
+
+        struct heat {
+            float value = 0.f;
+        };
+
+        struct shield {
+            float value = 100.f;
+        };
+
+        struct ammo {
+            float value = 50.f;
+        };
+
+        /**
+         * @brief Some per-entity arithmetic heavy enough that overlapping systems pays off.
+         */
+        template <typename Component>
+        void decay_system(engine::game_entities& entities, const float interval,
+                          [[maybe_unused]] void* user_data) {
+            for (auto [entity, component] : entities.registry().view<Component>().each()) {
+                component.value = std::sqrt(component.value * component.value + interval) * 0.999f;
+            }
+        }
+
+        void populate_crew(engine::game_entities& entities, const std::size_t count) {
+            populate_asteroids(entities, count);
+
+            for (const entt::entity entity : entities.view<engine::component_transform>()) {
+                entities.add<heat>(entity);
+                entities.add<shield>(entity);
+                entities.add<ammo>(entity);
+            }
+
+            auto& systems = entities.systems();
+            systems.add("heat", &decay_system<heat>, engine::game_system_access{}.writes<heat>());
+            systems.add("shield", &decay_system<shield>,
+                        engine::game_system_access{}.writes<shield>());
+            systems.add("ammo", &decay_system<ammo>, engine::game_system_access{}.writes<ammo>());
+        }
+    }  // namespace
+
+    void run_scheduler() {
+        constexpr std::array<std::size_t, 2> entity_counts = {100'000, 1'000'000};
+        const auto workers =
+            std::make_unique<engine::game_workers>(engine::game_workers::default_thread_count());
+
+        for (const std::size_t count : entity_counts) {
+            engine::game_entities serial_entities;
+            populate_crew(serial_entities, count);
+
+            const double serial_seconds = measure_seconds(
+                ticks_per_sample, [&] { serial_entities.systems_update(tick_interval); });
+            report("scheduler", "tick/one by one (before)", count, serial_seconds);
+
+            engine::game_entities parallel_entities;
+            populate_crew(parallel_entities, count);
+            parallel_entities.get_physics_settings().workers = workers.get();
+            parallel_entities.systems().set_workers(workers.get());
+
+            const double parallel_seconds = measure_seconds(
+                ticks_per_sample, [&] { parallel_entities.systems_update(tick_interval); });
+            report("scheduler", "tick/scheduled (after)", count, parallel_seconds);
+
+            constexpr std::array<const char*, 6> names = {"lifetime", "physics", "hierarchy",
+                                                          "heat",     "shield",  "ammo"};
+            for (const char* name : names) {
+                const engine::game_system_stats stats = parallel_entities.systems().get_stats(name);
+                laya::log_info("[scheduler] {:<10} {:>8.3f} ms average over {} runs", name,
+                               stats.total_seconds * 1e3 / static_cast<double>(stats.run_count),
+                               stats.run_count);
+            }
+        }
+    }
+}  // namespace benchmark
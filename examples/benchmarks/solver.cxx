@@ -0,0 +1,132 @@
+/**
+ * @file solver.cxx
+ * @brief Resolving a crowd of bodies packed into a walled arena, one impulse per contact versus
+ *        iterated and warm started sequential impulses.
+ */
+
+#include "benchmark.hxx"
+
+#include <array>
+#include <cmath>
+#include <string_view>
+
+namespace benchmark {
+    namespace {
+        constexpr float tick_interval = 1.f / 32.f;
+        constexpr int ticks_per_sample = 256;
+        constexpr float body_radius = 8.f;
+        constexpr float wall_thickness = 50.f;
+
+        struct solver_variant {
+            std::string_view name;
+            std::uint32_t iterations;
+            bool is_warm_starting;
+        };
+
+        /**
+         * @brief Bodies covering 70% of a square arena, so most of them touch a few others.
+         */
+        void populate_arena(engine::game_entities& entities, const std::size_t count) {
+            const float half_extent =
+                std::sqrt(static_cast<float>(count) * 3.1416f * body_radius * body_radius / 0.7f) *
+                0.5f;
+
+            for (int side = 0; side < 4; ++side) {
+                const float sign = side % 2 == 0 ? -1.f : 1.f;
+                const float offset = sign * (half_extent + wall_thickness);
+                const float length = half_extent + (2.f * wall_thickness);
+
+                const entt::entity wall = entities.create();
+                entities.add<engine::component_transform>(wall);
+                if (side < 2) {
+                    entities.set_transform_position(wall, {offset, 0.f});
+                    entities.set_collider_box(wall, {wall_thickness, length});
+                } else {
+                    entities.set_transform_position(wall, {0.f, offset});
+                    entities.set_collider_box(wall, {length, wall_thickness});
+                }
+            }
+
+            const float spawn_extent = half_extent - body_radius;
+            for (std::size_t i = 0; i < count; ++i) {
+                const entt::entity body = entities.sprite_create_interpolated("asteroid");
+                entities.set_transform_position(body, {random_range(-spawn_extent, spawn_extent),
+                                                       random_range(-spawn_extent, spawn_extent)});
+                entities.set_velocity_linear(
+                    body, {random_range(-60.f, 60.f), random_range(-60.f, 60.f)});
+                entities.set_velocity_linear_drag(body, 0.5f);
+                entities.set_velocity_angular_drag(body, 0.5f);
+                entities.set_collider_circle(body, body_radius);
+                entities.set_body(body, 1.f, 0.3f, 0.4f);
+            }
+
+            // Cells a few bodies across keep the broadphase out of the measurement.
+            entities.set_collision_grid(body_radius * 4.f, 2.f);
+        }
+
+        /**
+         * @brief How deep touching bodies sink into each other, on average.
+         */
+        float measure_penetration(engine::game_entities& entities) {
+            float total = 0.f;
+            std::size_t count = 0;
+            for (const engine::game_collision_pair& pair : entities.get_collision_pairs()) {
+                if (entities.has<engine::component_body>(pair.first) == false ||
+                    entities.has<engine::component_body>(pair.second) == false) {
+                    continue;
+                }
+
+                const float distance = glm::length(entities.get_transform_position(pair.second) -
+                                                   entities.get_transform_position(pair.first));
+                if (distance < 2.f * body_radius) {
+                    total += (2.f * body_radius) - distance;
+                    ++count;
+                }
+            }
+
+            return count > 0 ? total / static_cast<float>(count) : 0.f;
+        }
+    }  // namespace
+
+    void run_solver() {
+        constexpr std::array<std::size_t, 2> body_counts = {2'000, 10'000};
+        constexpr std::array<solver_variant, 3> variants = {
+            solver_variant{"naive (before)", 1, false},
+            solver_variant{"iterated, cold", 8, false},
+            solver_variant{"iterated, warm (after)", 8, true},
+        };
+
+        for (const std::size_t count : body_counts) {
+            for (const solver_variant& variant : variants) {
+                // Every variant starts from the same arena.
+                random_engine().seed(0x5eed);
+
+                engine::game_entities entities;
+                populate_arena(entities, count);
+                entities.get_solver_settings().iterations = variant.iterations;
+                entities.get_solver_settings().is_warm_starting = variant.is_warm_starting;
+
+                double solver_seconds = 0.0;
+                double penetration = 0.0;
+                std::size_t contacts = 0;
+                for (int tick = 0; tick < ticks_per_sample; ++tick) {
+                    entities.system_physics_update(tick_interval);
+                    entities.system_collision_update();
+
+                    const std::uint64_t start = engine::performance_counter_value_current();
+                    entities.system_solver_update(tick_interval);
+                    solver_seconds += engine::performance_counter_seconds_since(start);
+
+                    penetration += measure_penetration(entities);
+                    contacts += entities.get_solver_stats().contacts;
+                }
+
+                report("solver", variant.name, count, solver_seconds / ticks_per_sample);
+                laya::log_info("[solver] {} contacts per tick, {:.3f} mean penetration, {} of {} "
+                               "bodies asleep",
+                               contacts / ticks_per_sample, penetration / ticks_per_sample,
+                               entities.get_physics_counts().sleeping, count);
+            }
+        }
+    }
+}  // namespace benchmark
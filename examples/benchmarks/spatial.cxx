@@ -0,0 +1,125 @@
+/**
+ * @file spatial.cxx
+ * @brief Region, point and ray queries, scanning the registry versus the spatial tree.
+ */
+
+#include "benchmark.hxx"
+
+#include <array>
+#include <vector>
+
+namespace benchmark {
+    namespace {
+        constexpr float tick_interval = 1.f / 32.f;
+        constexpr int ticks_per_sample = 32;
+        constexpr std::size_t queries_per_sample = 256;
+        constexpr float asteroid_radius = 32.f;
+
+        struct query_inputs {
+            std::vector<glm::vec2> corners;  ///< Top left of each area, 400 x 400 units.
+            std::vector<glm::vec2> points;
+            std::vector<glm::vec2> ray_ends;  ///< Rays run from each point to its end.
+        };
+
+        query_inputs make_inputs() {
+            query_inputs inputs;
+            for (std::size_t i = 0; i < queries_per_sample; ++i) {
+                inputs.corners.push_back(
+                    {random_range(-5000.f, 4600.f), random_range(-5000.f, 4600.f)});
+                inputs.points.push_back(
+                    {random_range(-5000.f, 5000.f), random_range(-5000.f, 5000.f)});
+                inputs.ray_ends.push_back(inputs.points.back() +
+                                          glm::vec2{random_range(-1000.f, 1000.f),
+                                                    random_range(-1000.f, 1000.f)});
+            }
+
+            return inputs;
+        }
+
+        /**
+         * @brief What area damage did before the tree existed.
+         */
+        std::size_t query_rect_scan(engine::game_entities& entities, const glm::vec2& min,
+                                    const glm::vec2& max, std::span<entt::entity> out) {
+            std::size_t count = 0;
+            auto view = entities.view<engine::component_transform>();
+            for (auto [entity, transform] : view.each()) {
+                const glm::vec2 near = transform.position - glm::vec2{asteroid_radius};
+                const glm::vec2 far = transform.position + glm::vec2{asteroid_radius};
+                const bool is_inside =
+                    far.x >= min.x && near.x <= max.x && far.y >= min.y && near.y <= max.y;
+
+                if (is_inside == true && count < out.size()) {
+                    out[count++] = entity;
+                }
+            }
+
+            return count;
+        }
+    }  // namespace
+
+    void run_spatial() {
+        constexpr std::array<std::size_t, 2> body_counts = {10'000, 100'000};
+
+        for (const std::size_t count : body_counts) {
+            engine::game_entities entities;
+            populate_asteroids(entities, count);
+            for (const entt::entity entity : entities.view<engine::component_transform>()) {
+                entities.set_collider_circle(entity, asteroid_radius);
+            }
+
+            const query_inputs inputs = make_inputs();
+            std::vector<entt::entity> found(count);
+            std::array<engine::game_raycast_hit, 8> hits;
+            std::size_t found_total = 0;
+
+            const double scan_seconds = measure_seconds(4, [&] {
+                found_total = 0;
+                for (const glm::vec2& corner : inputs.corners) {
+                    found_total += query_rect_scan(entities, corner,
+                                                   corner + glm::vec2{400.f, 400.f}, found);
+                }
+            });
+            report("spatial", "rect/scan (before)", queries_per_sample, scan_seconds);
+            laya::log_info("[spatial] {} entities found by the scan", found_total);
+
+            entities.system_spatial_update();
+            const double rect_seconds = measure_seconds(4, [&] {
+                found_total = 0;
+                for (const glm::vec2& corner : inputs.corners) {
+                    found_total += entities.query_rect(corner, corner + glm::vec2{400.f, 400.f},
+                                                       found);
+                }
+            });
+            report("spatial", "rect/tree (after)", queries_per_sample, rect_seconds);
+            laya::log_info("[spatial] {} entities found by the tree", found_total);
+
+            const double point_seconds = measure_seconds(4, [&] {
+                found_total = 0;
+                for (const glm::vec2& point : inputs.points) {
+                    found_total += entities.query_point(point, found);
+                }
+            });
+            report("spatial", "point/tree", queries_per_sample, point_seconds);
+
+            const double ray_seconds = measure_seconds(4, [&] {
+                found_total = 0;
+                for (std::size_t i = 0; i < queries_per_sample; ++i) {
+                    found_total += entities.raycast(inputs.points[i], inputs.ray_ends[i], hits);
+                }
+            });
+            report("spatial", "raycast/tree (nearest 8)", queries_per_sample, ray_seconds);
+
+            // Keeping the tree in sync as the field drifts.
+            double update_seconds = 0.0;
+            for (int tick = 0; tick < ticks_per_sample; ++tick) {
+                entities.system_physics_update(tick_interval);
+
+                const std::uint64_t start = engine::performance_counter_value_current();
+                entities.system_spatial_update();
+                update_seconds += engine::performance_counter_seconds_since(start);
+            }
+            report("spatial", "update", count, update_seconds / ticks_per_sample);
+        }
+    }
+}  // namespace benchmark
@@ -0,0 +1,71 @@
+/**
+ * @file spawn.cxx
+ * @brief Cost of spawning a wave of asteroids.
+ */
+
+#include "benchmark.hxx"
+
+#include <array>
+#include <vector>
+
+namespace benchmark {
+    namespace {
+        constexpr int waves_per_sample = 8;
+
+        struct wave {
+            std::vector<glm::vec2> positions;
+            std::vector<glm::vec2> velocities;
+            std::vector<float> rotations;
+        };
+
+        wave make_wave(const std::size_t count) {
+            wave result;
+            result.positions.reserve(count);
+            result.velocities.reserve(count);
+            result.rotations.reserve(count);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                result.positions.push_back(
+                    {random_range(-5000.f, 5000.f), random_range(-5000.f, 5000.f)});
+                result.velocities.push_back({random_range(-80.f, 80.f), random_range(-80.f, 80.f)});
+                result.rotations.push_back(random_range(0.f, 360.f));
+            }
+
+            return result;
+        }
+
+        void spawn_one_by_one(engine::game_entities& entities, const wave& asteroids) {
+            for (std::size_t i = 0; i < asteroids.positions.size(); ++i) {
+                const entt::entity asteroid = entities.sprite_create_interpolated("asteroid");
+                entities.set_transform_position(asteroid, asteroids.positions[i]);
+                entities.set_velocity_linear(asteroid, asteroids.velocities[i]);
+                entities.get<engine::component_transform>(asteroid).rotation =
+                    asteroids.rotations[i];
+            }
+        }
+    }  // namespace
+
+    void run_spawn() {
+        constexpr std::array<std::size_t, 3> entity_counts = {1'000, 20'000, 100'000};
+
+        for (const std::size_t count : entity_counts) {
+            const wave asteroids = make_wave(count);
+            std::vector<entt::entity> spawned(count);
+
+            // Each wave lands in a fresh scene, so pools start out empty like a level load.
+            const double single_seconds = measure_seconds(waves_per_sample, [&] {
+                engine::game_entities entities;
+                spawn_one_by_one(entities, asteroids);
+            });
+            report("spawn", "wave/one by one (before)", count, single_seconds);
+
+            const double batch_seconds = measure_seconds(waves_per_sample, [&] {
+                engine::game_entities entities;
+                entities.sprite_create_interpolated_batch("asteroid", spawned, asteroids.positions,
+                                                          asteroids.velocities,
+                                                          asteroids.rotations);
+            });
+            report("spawn", "wave/batch (after)", count, batch_seconds);
+        }
+    }
+}  // namespace benchmark
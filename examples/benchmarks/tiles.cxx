@@ -0,0 +1,173 @@
+/**
+ * @file tiles.cxx
+ * @brief Movers inside a walled maze, walls as static box colliders versus solid tiles.
+ */
+
+#include "benchmark.hxx"
+
+#include <array>
+
+namespace benchmark {
+    namespace {
+        constexpr float tick_interval = 1.f / 32.f;
+        constexpr int ticks_per_sample = 128;
+        constexpr float tile_size = 32.f;
+        constexpr float mover_radius = 8.f;
+
+        /**
+         * @brief Tiles per side of the maze, and of the rooms it is split into.
+         */
+        constexpr int maze_size = 256;
+        constexpr int room_size = 16;
+
+        constexpr std::uint32_t wall_layer = 1;
+        constexpr std::uint32_t mover_layer = 2;
+
+        /**
+         * @brief Rooms with walls on every side and a door in the middle of each wall.
+         */
+        bool is_wall(const int x, const int y) {
+            const bool is_door_x = x % room_size == room_size / 2;
+            const bool is_door_y = y % room_size == room_size / 2;
+            const bool is_border = x == 0 || y == 0 || x == maze_size || y == maze_size;
+
+            return (x % room_size == 0 && (is_door_y == false || is_border == true)) ||
+                   (y % room_size == 0 && (is_door_x == false || is_border == true));
+        }
+
+        /**
+         * @brief Whether a mover at `position` touches no wall.
+         */
+        bool is_clear(const glm::vec2& position) {
+            const int min_x = static_cast<int>((position.x - mover_radius) / tile_size);
+            const int max_x = static_cast<int>((position.x + mover_radius) / tile_size);
+            const int min_y = static_cast<int>((position.y - mover_radius) / tile_size);
+            const int max_y = static_cast<int>((position.y + mover_radius) / tile_size);
+
+            return is_wall(min_x, min_y) == false && is_wall(max_x, min_y) == false &&
+                   is_wall(min_x, max_y) == false && is_wall(max_x, max_y) == false;
+        }
+
+        /**
+         * @brief Walls as one immovable box collider per tile, as before tiles.
+         * @return Number of wall entities.
+         */
+        std::size_t populate_wall_entities(engine::game_entities& entities) {
+            std::size_t count = 0;
+            for (int y = 0; y <= maze_size; ++y) {
+                for (int x = 0; x <= maze_size; ++x) {
+                    if (is_wall(x, y) == false) {
+                        continue;
+                    }
+
+                    // Walls pair with movers only, never with the walls next to them.
+                    const entt::entity wall = entities.create();
+                    entities.add<engine::component_transform>(wall);
+                    entities.set_transform_position(
+                        wall, {(static_cast<float>(x) + 0.5f) * tile_size,
+                               (static_cast<float>(y) + 0.5f) * tile_size});
+                    entities.set_collider_box(wall, {tile_size * 0.5f, tile_size * 0.5f},
+                                              wall_layer, mover_layer);
+                    ++count;
+                }
+            }
+
+            return count;
+        }
+
+        void populate_wall_tiles(engine::game_entities& entities) {
+            engine::game_tile_grid& grid = entities.get_tile_grid();
+            grid.set_tile_size(tile_size);
+            for (int y = 0; y <= maze_size; ++y) {
+                for (int x = 0; x <= maze_size; ++x) {
+                    if (is_wall(x, y) == true) {
+                        grid.set_solid({x, y}, true);
+                    }
+                }
+            }
+            entities.set_tile_layers(wall_layer);
+        }
+
+        /**
+         * @brief Movers spread over the rooms, pairing with walls but not with each other.
+         */
+        void populate_movers(engine::game_entities& entities, const std::size_t count,
+                             const bool is_body) {
+            constexpr float extent = static_cast<float>(maze_size) * tile_size;
+
+            for (std::size_t i = 0; i < count; ++i) {
+                glm::vec2 position = {0.f, 0.f};
+                do {
+                    position = {random_range(tile_size, extent - tile_size),
+                                random_range(tile_size, extent - tile_size)};
+                } while (is_clear(position) == false);
+
+                const entt::entity mover = entities.sprite_create_interpolated("asteroid");
+                entities.set_transform_position(mover, position);
+                entities.set_velocity_linear(
+                    mover, {random_range(-120.f, 120.f), random_range(-120.f, 120.f)});
+                entities.set_collider_circle(mover, mover_radius, mover_layer, wall_layer);
+                if (is_body == true) {
+                    entities.set_body(mover, 1.f, 0.f, 0.f);
+                }
+            }
+
+            entities.set_collision_grid(tile_size * 2.f, 2.f);
+        }
+    }  // namespace
+
+    void run_tiles() {
+        constexpr std::array<std::size_t, 2> mover_counts = {2'000, 20'000};
+
+        for (const std::size_t count : mover_counts) {
+            double entities_seconds = 0.0;
+            std::size_t wall_count = 0;
+            {
+                random_engine().seed(0x5eed);
+
+                engine::game_entities entities;
+                wall_count = populate_wall_entities(entities);
+                populate_movers(entities, count, true);
+
+                for (int tick = 0; tick < ticks_per_sample; ++tick) {
+                    entities.system_physics_update(tick_interval);
+
+                    const std::uint64_t start = engine::performance_counter_value_current();
+                    entities.system_collision_update();
+                    entities.system_solver_update(tick_interval);
+                    entities_seconds += engine::performance_counter_seconds_since(start);
+                }
+            }
+
+            double tiles_seconds = 0.0;
+            std::size_t tile_bytes = 0;
+            {
+                random_engine().seed(0x5eed);
+
+                engine::game_entities entities;
+                populate_wall_tiles(entities);
+                populate_movers(entities, count, false);
+                tile_bytes = entities.get_tile_grid().get_memory_size();
+
+                for (int tick = 0; tick < ticks_per_sample; ++tick) {
+                    entities.system_physics_update(tick_interval);
+
+                    const std::uint64_t start = engine::performance_counter_value_current();
+                    entities.system_tiles_update(tick_interval);
+                    entities.system_collision_update();
+                    tiles_seconds += engine::performance_counter_seconds_since(start);
+                }
+            }
+
+            report("tiles", "wall entities (before)", count, entities_seconds / ticks_per_sample);
+            report("tiles", "solid tiles (after)", count, tiles_seconds / ticks_per_sample);
+
+            // Components alone, leaving out the registry and broadphase overhead of each wall.
+            const std::size_t entity_bytes =
+                wall_count * (sizeof(entt::entity) + sizeof(engine::component_transform) +
+                              sizeof(engine::component_collider));
+            laya::log_info("[tiles] {} walls: at least {} bytes as entities, {} bytes as tiles",
+                           wall_count, entity_bytes, tile_bytes);
+        }
+    }
+}  // namespace benchmark
@@ -38,9 +38,11 @@ void scene_on_load(engine::game_scene* scene) {
         "player_label", "player", "assets/helipad/fonts/roboto_regular.ttf", 64.0f);
     player_label->set_origin_centered();
 
+    // Attached labels keep their transform as an offset from the player, without turning with it.
     state->player_label = entities->create_text_dynamic("player_label");
-    entities->set_transform_position(state->player_label, {200, 230});
+    entities->set_transform_position(state->player_label, {0, 30});
     entities->set_transform_scale(state->player_label, {0.25f, 0.25f});
+    entities->attach(state->player_label, state->player, false);
 
     auto* asteroid_sprite =
         resources->sprite_get_or_create("asteroid_sprite", "assets/space_war/asteroids/ice_1.png");
@@ -62,8 +64,7 @@ void scene_on_tick(engine::game_scene* scene, const float tick_interval) {
     engine::game_entities* entities = scene->get_entities();
 
     // Update ECS systems at fixed tick rate.
-    entities->system_lifetime_update(tick_interval);
-    entities->system_physics_update(tick_interval);
+    entities->systems_update(tick_interval);
 }
 
 void scene_on_input(engine::game_scene* scene) {
@@ -130,11 +131,6 @@ void scene_on_frame(engine::game_scene* scene, const float frame_interval) {
         // Move the asteroid to where we clicked.
         entities->set_transform_position(state->asteroid, mouse_click_position);
     }
-
-    // Update player label to follow player
-    const glm::vec2 player_position =
-        entities->get_interpolated_position(state->player, engine->get_fraction_to_next_tick());
-    entities->set_transform_position(state->player_label, player_position + glm::vec2{0.f, 30.f});
 }
 
 void scene_on_draw(engine::game_scene* scene, float fraction_to_next_tick) {
@@ -0,0 +1,404 @@
+/**
+ * @file aabb_tree.cxx
+ * @brief Dynamic AABB tree implementation.
+ */
+
+#include "aabb_tree.hxx"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace engine {
+    namespace {
+        /**
+         * @brief Traversal stack that lives on the call stack, only spilling to the heap for
+         *        trees far deeper than balancing allows in practice.
+         */
+        class node_stack {
+        public:
+            explicit node_stack(const std::int32_t height) {
+                // A depth-first walk holds at most one pending sibling per level.
+                const auto capacity = static_cast<std::size_t>(height) + 2;
+                if (capacity > m_fixed.size()) {
+                    m_spill.resize(capacity);
+                    m_data = m_spill.data();
+                }
+            }
+
+            void push(const std::int32_t index) noexcept {
+                m_data[m_size++] = index;
+            }
+
+            [[nodiscard]] std::int32_t pop() noexcept {
+                return m_data[--m_size];
+            }
+
+            [[nodiscard]] bool is_empty() const noexcept {
+                return m_size == 0;
+            }
+
+        private:
+            std::array<std::int32_t, 64> m_fixed;
+            std::vector<std::int32_t> m_spill;
+            std::int32_t* m_data = m_fixed.data();
+            std::size_t m_size = 0;
+        };
+
+        game_aabb merge(const game_aabb& left, const game_aabb& right) {
+            return {glm::min(left.min, right.min), glm::max(left.max, right.max)};
+        }
+
+        float get_perimeter(const game_aabb& bounds) {
+            const glm::vec2 size = bounds.max - bounds.min;
+            return 2.0f * (size.x + size.y);
+        }
+
+        /**
+         * @brief Clip the segment `origin + direction * t`, t in [0, max_fraction], to `bounds`.
+         * @param fraction Receives where the segment enters, 0 if it starts inside.
+         */
+        bool intersect_segment(const game_aabb& bounds, const glm::vec2& origin,
+                               const glm::vec2& direction, const float max_fraction,
+                               float& fraction) {
+            float enter = 0.0f;
+            float exit = max_fraction;
+
+            for (int axis = 0; axis < 2; ++axis) {
+                if (std::abs(direction[axis]) < std::numeric_limits<float>::epsilon()) {
+                    if (origin[axis] < bounds.min[axis] || origin[axis] > bounds.max[axis]) {
+                        return false;
+                    }
+                    continue;
+                }
+
+                const float inverse = 1.0f / direction[axis];
+                float near = (bounds.min[axis] - origin[axis]) * inverse;
+                float far = (bounds.max[axis] - origin[axis]) * inverse;
+                if (near > far) {
+                    std::swap(near, far);
+                }
+
+                enter = std::max(enter, near);
+                exit = std::min(exit, far);
+                if (enter > exit) {
+                    return false;
+                }
+            }
+
+            fraction = enter;
+            return true;
+        }
+
+        bool is_nearer(const game_raycast_hit& left, const game_raycast_hit& right) {
+            return left.fraction < right.fraction;
+        }
+    }  // namespace
+
+    std::int32_t game_aabb_tree::insert(const game_aabb& bounds, const entt::entity entity) {
+        const std::int32_t leaf = allocate_node();
+        node& created = m_nodes[static_cast<std::size_t>(leaf)];
+
+        const glm::vec2 margin = {m_margin, m_margin};
+        created.bounds = {bounds.min - margin, bounds.max + margin};
+        created.exact = bounds;
+        created.entity = entity;
+        created.height = 0;
+
+        insert_leaf(leaf);
+        ++m_leaf_count;
+
+        return leaf;
+    }
+
+    void game_aabb_tree::remove(const std::int32_t leaf) {
+        remove_leaf(leaf);
+        free_node(leaf);
+        --m_leaf_count;
+    }
+
+    bool game_aabb_tree::move(const std::int32_t leaf, const game_aabb& bounds,
+                              const bool is_predicted) {
+        node& moved = m_nodes[static_cast<std::size_t>(leaf)];
+        const glm::vec2 displacement = (bounds.min + bounds.max - moved.exact.min -
+                                        moved.exact.max) *
+                                       0.5f;
+        moved.exact = bounds;
+
+        if (moved.bounds.contains(bounds) == true) {
+            return false;
+        }
+
+        remove_leaf(leaf);
+
+        const glm::vec2 margin = {m_margin, m_margin};
+        game_aabb enlarged = {bounds.min - margin, bounds.max + margin};
+        if (is_predicted == true) {
+            const glm::vec2 ahead = displacement * prediction_moves;
+            enlarged.min += glm::min(ahead, glm::vec2{0.0f, 0.0f});
+            enlarged.max += glm::max(ahead, glm::vec2{0.0f, 0.0f});
+        }
+
+        m_nodes[static_cast<std::size_t>(leaf)].bounds = enlarged;
+        insert_leaf(leaf);
+
+        return true;
+    }
+
+    void game_aabb_tree::clear() {
+        m_nodes.clear();
+        m_root = null_node;
+        m_free = null_node;
+        m_leaf_count = 0;
+    }
+
+    std::size_t game_aabb_tree::query_rect(const game_aabb& area,
+                                           std::span<entt::entity> out) const {
+        if (m_root == null_node || out.empty() == true) {
+            return 0;
+        }
+
+        std::size_t count = 0;
+        node_stack stack(get_height());
+        stack.push(m_root);
+
+        while (stack.is_empty() == false && count < out.size()) {
+            const node& current = m_nodes[static_cast<std::size_t>(stack.pop())];
+            if (current.bounds.overlaps(area) == false) {
+                continue;
+            }
+
+            if (current.is_leaf() == false) {
+                stack.push(current.first);
+                stack.push(current.second);
+            } else if (current.exact.overlaps(area) == true) {
+                out[count++] = current.entity;
+            }
+        }
+
+        return count;
+    }
+
+    std::size_t game_aabb_tree::query_point(const glm::vec2& point,
+                                            std::span<entt::entity> out) const {
+        return query_rect({point, point}, out);
+    }
+
+    std::size_t game_aabb_tree::raycast(const glm::vec2& origin, const glm::vec2& end,
+                                        std::span<game_raycast_hit> out) const {
+        if (m_root == null_node || out.empty() == true) {
+            return 0;
+        }
+
+        const glm::vec2 direction = end - origin;
+        float max_fraction = 1.0f;
+        std::size_t count = 0;
+
+        node_stack stack(get_height());
+        stack.push(m_root);
+
+        while (stack.is_empty() == false) {
+            const node& current = m_nodes[static_cast<std::size_t>(stack.pop())];
+
+            float fraction = 0.0f;
+            if (intersect_segment(current.bounds, origin, direction, max_fraction, fraction) ==
+                false) {
+                continue;
+            }
+
+            if (current.is_leaf() == false) {
+                stack.push(current.first);
+                stack.push(current.second);
+                continue;
+            }
+
+            if (intersect_segment(current.exact, origin, direction, max_fraction, fraction) ==
+                false) {
+                continue;
+            }
+
+            // Once full, a nearer hit replaces the farthest, and the ray is cut short behind
+            // the farthest hit that is kept.
+            if (count < out.size()) {
+                out[count++] = {current.entity, fraction};
+                if (count < out.size()) {
+                    continue;
+                }
+            } else {
+                *std::max_element(out.begin(), out.end(), &is_nearer) = {current.entity, fraction};
+            }
+
+            max_fraction = std::max_element(out.begin(), out.end(), &is_nearer)->fraction;
+        }
+
+        std::sort(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(count), &is_nearer);
+
+        return count;
+    }
+
+    std::int32_t game_aabb_tree::allocate_node() {
+        if (m_free == null_node) {
+            m_nodes.emplace_back();
+            return static_cast<std::int32_t>(m_nodes.size() - 1);
+        }
+
+        const std::int32_t index = m_free;
+        m_free = m_nodes[static_cast<std::size_t>(index)].parent;
+        m_nodes[static_cast<std::size_t>(index)] = {};
+
+        return index;
+    }
+
+    void game_aabb_tree::free_node(const std::int32_t index) {
+        node& freed = m_nodes[static_cast<std::size_t>(index)];
+        freed = {};
+        freed.parent = m_free;
+        freed.height = -1;
+        m_free = index;
+    }
+
+    void game_aabb_tree::insert_leaf(const std::int32_t leaf) {
+        if (m_root == null_node) {
+            m_root = leaf;
+            m_nodes[static_cast<std::size_t>(leaf)].parent = null_node;
+            return;
+        }
+
+        // Walk down while pushing the leaf into a child is cheaper than pairing it with the
+        // current node, counting the growth of every ancestor on the way.
+        const game_aabb bounds = m_nodes[static_cast<std::size_t>(leaf)].bounds;
+        std::int32_t sibling = m_root;
+
+        while (m_nodes[static_cast<std::size_t>(sibling)].is_leaf() == false) {
+            const node& current = m_nodes[static_cast<std::size_t>(sibling)];
+            const float combined = get_perimeter(merge(current.bounds, bounds));
+            const float pair_cost = 2.0f * combined;
+            const float inherited_cost = 2.0f * (combined - get_perimeter(current.bounds));
+
+            const auto get_descent_cost = [&](const std::int32_t child) {
+                const node& candidate = m_nodes[static_cast<std::size_t>(child)];
+                const float grown = get_perimeter(merge(candidate.bounds, bounds));
+                return inherited_cost +
+                       (candidate.is_leaf() == true ? grown
+                                                    : grown - get_perimeter(candidate.bounds));
+            };
+
+            const float first_cost = get_descent_cost(current.first);
+            const float second_cost = get_descent_cost(current.second);
+            if (pair_cost < first_cost && pair_cost < second_cost) {
+                break;
+            }
+
+            sibling = first_cost < second_cost ? current.first : current.second;
+        }
+
+        const std::int32_t old_parent = m_nodes[static_cast<std::size_t>(sibling)].parent;
+        const std::int32_t new_parent = allocate_node();
+
+        node& parent = m_nodes[static_cast<std::size_t>(new_parent)];
+        parent.parent = old_parent;
+        parent.bounds = merge(m_nodes[static_cast<std::size_t>(sibling)].bounds, bounds);
+        parent.height = m_nodes[static_cast<std::size_t>(sibling)].height + 1;
+        parent.first = sibling;
+        parent.second = leaf;
+        m_nodes[static_cast<std::size_t>(sibling)].parent = new_parent;
+        m_nodes[static_cast<std::size_t>(leaf)].parent = new_parent;
+
+        if (old_parent == null_node) {
+            m_root = new_parent;
+        } else {
+            node& grandparent = m_nodes[static_cast<std::size_t>(old_parent)];
+            (grandparent.first == sibling ? grandparent.first : grandparent.second) = new_parent;
+        }
+
+        refit_ancestors(new_parent);
+    }
+
+    void game_aabb_tree::remove_leaf(const std::int32_t leaf) {
+        if (leaf == m_root) {
+            m_root = null_node;
+            return;
+        }
+
+        // The sibling takes the place of the shared parent, which is freed.
+        const std::int32_t parent = m_nodes[static_cast<std::size_t>(leaf)].parent;
+        const node& removed = m_nodes[static_cast<std::size_t>(parent)];
+        const std::int32_t grandparent = removed.parent;
+        const std::int32_t sibling = removed.first == leaf ? removed.second : removed.first;
+
+        free_node(parent);
+        m_nodes[static_cast<std::size_t>(sibling)].parent = grandparent;
+
+        if (grandparent == null_node) {
+            m_root = sibling;
+            return;
+        }
+
+        node& above = m_nodes[static_cast<std::size_t>(grandparent)];
+        (above.first == parent ? above.first : above.second) = sibling;
+
+        refit_ancestors(grandparent);
+    }
+
+    void game_aabb_tree::refit_ancestors(std::int32_t index) {
+        while (index != null_node) {
+            index = balance(index);
+
+            node& current = m_nodes[static_cast<std::size_t>(index)];
+            const node& first = m_nodes[static_cast<std::size_t>(current.first)];
+            const node& second = m_nodes[static_cast<std::size_t>(current.second)];
+            current.height = 1 + std::max(first.height, second.height);
+            current.bounds = merge(first.bounds, second.bounds);
+
+            index = current.parent;
+        }
+    }
+
+    std::int32_t game_aabb_tree::balance(const std::int32_t index) {
+        node& top = m_nodes[static_cast<std::size_t>(index)];
+        if (top.is_leaf() == true || top.height < 2) {
+            return index;
+        }
+
+        const std::int32_t difference = m_nodes[static_cast<std::size_t>(top.second)].height -
+                                        m_nodes[static_cast<std::size_t>(top.first)].height;
+        if (difference >= -1 && difference <= 1) {
+            return index;
+        }
+
+        // The taller child takes the place of `top`, keeps its own taller child and hands the
+        // shorter one down to `top`.
+        const std::int32_t lifted = difference > 1 ? top.second : top.first;
+        node& raised = m_nodes[static_cast<std::size_t>(lifted)];
+        const bool is_first_kept = m_nodes[static_cast<std::size_t>(raised.first)].height >
+                                   m_nodes[static_cast<std::size_t>(raised.second)].height;
+        const std::int32_t kept = is_first_kept == true ? raised.first : raised.second;
+        const std::int32_t lowered = is_first_kept == true ? raised.second : raised.first;
+
+        raised.parent = top.parent;
+        if (raised.parent == null_node) {
+            m_root = lifted;
+        } else {
+            node& above = m_nodes[static_cast<std::size_t>(raised.parent)];
+            (above.first == index ? above.first : above.second) = lifted;
+        }
+
+        raised.first = index;
+        raised.second = kept;
+        top.parent = lifted;
+        (top.first == lifted ? top.first : top.second) = lowered;
+        m_nodes[static_cast<std::size_t>(lowered)].parent = index;
+
+        const node& top_first = m_nodes[static_cast<std::size_t>(top.first)];
+        const node& top_second = m_nodes[static_cast<std::size_t>(top.second)];
+        top.bounds = merge(top_first.bounds, top_second.bounds);
+        top.height = 1 + std::max(top_first.height, top_second.height);
+
+        const node& kept_node = m_nodes[static_cast<std::size_t>(kept)];
+        raised.bounds = merge(top.bounds, kept_node.bounds);
+        raised.height = 1 + std::max(top.height, kept_node.height);
+
+        return lifted;
+    }
+}  // namespace engine
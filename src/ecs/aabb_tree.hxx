@@ -0,0 +1,176 @@
+/**
+ * @file aabb_tree.hxx
+ * @brief Dynamic bounding volume tree for region, point and ray queries over entities.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+namespace engine {
+    /**
+     * @brief Axis-aligned box in world units, `min` and `max` inclusive.
+     */
+    struct game_aabb {
+        glm::vec2 min = {0.0f, 0.0f};
+        glm::vec2 max = {0.0f, 0.0f};
+
+        [[nodiscard]] bool overlaps(const game_aabb& other) const noexcept {
+            return min.x <= other.max.x && other.min.x <= max.x && min.y <= other.max.y &&
+                   other.min.y <= max.y;
+        }
+
+        [[nodiscard]] bool contains(const game_aabb& other) const noexcept {
+            return min.x <= other.min.x && min.y <= other.min.y && other.max.x <= max.x &&
+                   other.max.y <= max.y;
+        }
+    };
+
+    /**
+     * @brief One entity hit by `game_aabb_tree::raycast`.
+     */
+    struct game_raycast_hit {
+        entt::entity entity = entt::null;
+        float fraction = 0.0f;  ///< Where the box is entered, 0 at the ray's origin, 1 at its end.
+    };
+
+    /**
+     * @brief Dynamic AABB tree with one leaf per entity.
+     *
+     * Leaves are filed with their bounds enlarged by a margin, and `move` only re-inserts a leaf
+     * once its exact bounds leave the enlarged ones, so small movements cost a containment test.
+     * Leaves that keep moving are also stretched a few moves ahead along their last displacement,
+     * so steady movers are re-inserted several times less often.
+     * Inserts pick the sibling that grows the tree's perimeter the least and removals rebalance
+     * with rotations, keeping queries logarithmic however entities come and go.
+     *
+     * Queries test the exact bounds kept in each leaf, so they report what overlaps and not
+     * what is merely close. They write into caller storage and never allocate.
+     */
+    class game_aabb_tree {
+    public:
+        static constexpr std::int32_t null_node = -1;
+
+        /**
+         * @brief How many displacements ahead a predicted leaf is stretched.
+         */
+        static constexpr float prediction_moves = 4.0f;
+
+        /**
+         * @brief Add a leaf for `entity` with exact bounds `bounds`.
+         * @return Handle of the leaf, stable until it is removed.
+         */
+        std::int32_t insert(const game_aabb& bounds, entt::entity entity);
+
+        void remove(std::int32_t leaf);
+
+        /**
+         * @brief Update the exact bounds of a leaf, re-inserting it if they left its enlarged
+         *        bounds.
+         * @param is_predicted Whether to stretch the enlarged bounds along the displacement since
+         *        the last move. Pass false for teleports, which are no hint of where it goes next.
+         * @return Whether the leaf was re-inserted.
+         */
+        bool move(std::int32_t leaf, const game_aabb& bounds, bool is_predicted = true);
+
+        void clear();
+
+        /**
+         * @brief How far bounds are enlarged when a leaf is filed, applied from the next insert.
+         */
+        void set_margin(float margin) noexcept;
+        [[nodiscard]] float get_margin() const noexcept;
+
+        [[nodiscard]] entt::entity get_entity(std::int32_t leaf) const;
+        [[nodiscard]] const game_aabb& get_bounds(std::int32_t leaf) const;
+
+        [[nodiscard]] std::size_t size() const noexcept;
+        [[nodiscard]] std::int32_t get_height() const noexcept;
+
+        /**
+         * @brief Entities whose bounds overlap `area`.
+         * @return Number of entities written to `out`, the query stops once it is full.
+         */
+        std::size_t query_rect(const game_aabb& area, std::span<entt::entity> out) const;
+
+        /**
+         * @brief Entities whose bounds contain `point`.
+         * @return Number of entities written to `out`, the query stops once it is full.
+         */
+        std::size_t query_point(const glm::vec2& point, std::span<entt::entity> out) const;
+
+        /**
+         * @brief Entities whose bounds the segment from `origin` to `end` passes through.
+         * @return Number of hits written to `out`, nearest first. When there are more hits than
+         *         fit, the nearest ones are kept, so a single element span finds the first hit.
+         */
+        std::size_t raycast(const glm::vec2& origin, const glm::vec2& end,
+                            std::span<game_raycast_hit> out) const;
+
+    private:
+        struct node {
+            game_aabb bounds;  ///< Enlarged for leaves, the union of both children otherwise.
+            game_aabb exact;   ///< Leaves only.
+            entt::entity entity = entt::null;
+            std::int32_t parent = null_node;  ///< Next free node while on the free list.
+            std::int32_t first = null_node;
+            std::int32_t second = null_node;
+            std::int32_t height = 0;  ///< 0 for leaves, -1 while on the free list.
+
+            [[nodiscard]] bool is_leaf() const noexcept {
+                return first == null_node;
+            }
+        };
+
+        std::int32_t allocate_node();
+        void free_node(std::int32_t index);
+
+        void insert_leaf(std::int32_t leaf);
+        void remove_leaf(std::int32_t leaf);
+
+        /**
+         * @brief Refit bounds and heights from `index` up to the root, rotating where needed.
+         */
+        void refit_ancestors(std::int32_t index);
+
+        /**
+         * @brief Rotate the taller grandchild up if `index` is out of balance.
+         * @return The node now in the place of `index`.
+         */
+        std::int32_t balance(std::int32_t index);
+
+        std::vector<node> m_nodes;
+        std::int32_t m_root = null_node;
+        std::int32_t m_free = null_node;
+        std::size_t m_leaf_count = 0;
+        float m_margin = 16.0f;
+    };
+
+    inline void game_aabb_tree::set_margin(const float margin) noexcept {
+        m_margin = margin;
+    }
+
+    inline float game_aabb_tree::get_margin() const noexcept {
+        return m_margin;
+    }
+
+    inline entt::entity game_aabb_tree::get_entity(const std::int32_t leaf) const {
+        return m_nodes[static_cast<std::size_t>(leaf)].entity;
+    }
+
+    inline const game_aabb& game_aabb_tree::get_bounds(const std::int32_t leaf) const {
+        return m_nodes[static_cast<std::size_t>(leaf)].exact;
+    }
+
+    inline std::size_t game_aabb_tree::size() const noexcept {
+        return m_leaf_count;
+    }
+
+    inline std::int32_t game_aabb_tree::get_height() const noexcept {
+        return m_root == null_node ? 0 : m_nodes[static_cast<std::size_t>(m_root)].height;
+    }
+}  // namespace engine
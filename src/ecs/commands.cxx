@@ -0,0 +1,200 @@
+/**
+ * @file commands.cxx
+ * @brief Deferred entity command buffer implementation.
+ */
+
+#include "commands.hxx"
+
+#include <algorithm>
+#include "components.hxx"
+#include "systems.hxx"
+
+namespace engine {
+    namespace {
+        using traits = entt::entt_traits<entt::entity>;
+
+        // Live entities never carry the tombstone version, so placeholders cannot collide.
+        constexpr auto placeholder_version = static_cast<traits::version_type>(traits::version_mask);
+
+        // Every index but the last, which with the tombstone version would be `entt::null`.
+        constexpr std::uint64_t placeholder_indices = traits::entity_mask;
+
+        constexpr std::size_t payload_block_size = 16 * 1024;
+
+        std::uint64_t next_buffer_id() {
+            static std::atomic<std::uint64_t> counter{0};
+            return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+    }  // namespace
+
+    game_commands::game_commands()
+        : m_id(next_buffer_id()),
+          m_logs_mutex(),
+          m_logs(),
+          m_next_placeholder(0),
+          m_flushed_placeholder(0),
+          m_created(),
+          m_sorted() {
+    }
+
+    game_commands::~game_commands() {
+        for (const auto& log : m_logs) {
+            for (const command& entry : log->commands) {
+                if (entry.discard != nullptr) {
+                    entry.discard(entry.payload);
+                }
+            }
+        }
+    }
+
+    entt::entity game_commands::create() {
+        const std::uint64_t serial = m_next_placeholder.fetch_add(1, std::memory_order_relaxed);
+        const auto index = static_cast<traits::entity_type>(serial % placeholder_indices);
+        const entt::entity placeholder = traits::construct(index, placeholder_version);
+
+        record({command_phase::create, 0, placeholder, nullptr, nullptr, nullptr});
+
+        return placeholder;
+    }
+
+    void game_commands::destroy(const entt::entity entity) {
+        record({command_phase::destroy, 0, entity, nullptr, &apply_destroy, nullptr});
+    }
+
+    bool game_commands::is_placeholder(const entt::entity entity) noexcept {
+        return entity != entt::null && traits::to_version(entity) == placeholder_version;
+    }
+
+    void game_commands::flush(entt::registry& registry) {
+        std::lock_guard lock(m_logs_mutex);
+
+        m_sorted.clear();
+        for (const auto& log : m_logs) {
+            for (const command& entry : log->commands) {
+                m_sorted.push_back(&entry);
+            }
+        }
+
+        if (m_sorted.empty() == true) {
+            return;
+        }
+
+        // Stable, so commands on the same storage keep the order they were recorded in. Adds and
+        // removes share a phase, so a remove followed by an add still ends with the component.
+        std::stable_sort(m_sorted.begin(), m_sorted.end(),
+                         [](const command* left, const command* right) {
+                             if (left->phase != right->phase) {
+                                 return left->phase < right->phase;
+                             }
+                             return left->type < right->type;
+                         });
+
+        // Placeholders of this flush run on from where the last flush stopped, anything else is
+        // left over from an earlier one and resolves to nothing.
+        const std::uint64_t placeholder_end = m_next_placeholder.load(std::memory_order_relaxed);
+        const std::uint64_t first_index = m_flushed_placeholder % placeholder_indices;
+        m_created.assign(placeholder_end - m_flushed_placeholder, entt::null);
+        m_flushed_placeholder = placeholder_end;
+
+        const auto get_created_slot = [&](const entt::entity placeholder) {
+            const std::uint64_t index = traits::to_entity(placeholder);
+            return static_cast<std::size_t>((index + placeholder_indices - first_index) %
+                                            placeholder_indices);
+        };
+
+        for (const command* entry : m_sorted) {
+            if (entry->phase == command_phase::create) {
+                m_created[get_created_slot(entry->entity)] = registry.create();
+                continue;
+            }
+
+            entt::entity entity = entry->entity;
+            if (is_placeholder(entity) == true) {
+                const std::size_t slot = get_created_slot(entity);
+                entity = slot < m_created.size() ? m_created[slot] : entt::entity{entt::null};
+            }
+
+            if (entity != entt::null && registry.valid(entity) == true) {
+                entry->apply(registry, entity, entry->payload);
+            } else if (entry->discard != nullptr) {
+                entry->discard(entry->payload);
+            }
+        }
+
+        for (const auto& log : m_logs) {
+            log->reset();
+        }
+    }
+
+    game_commands::command_log& game_commands::local_log() {
+        struct cached_log {
+            std::uint64_t owner;
+            command_log* log;
+            std::weak_ptr<command_log> lifetime;
+        };
+
+        // Each thread finds its own log without locking after the first lookup.
+        thread_local std::vector<cached_log> cache;
+
+        for (const cached_log& entry : cache) {
+            if (entry.owner == m_id) {
+                return *entry.log;
+            }
+        }
+
+        // Logs of destroyed buffers are dropped whenever a thread meets a new buffer, so the
+        // cache holds little more than the buffers still alive.
+        std::erase_if(cache, [](const cached_log& entry) { return entry.lifetime.expired(); });
+
+        std::lock_guard lock(m_logs_mutex);
+        const auto& log = m_logs.emplace_back(std::make_shared<command_log>());
+        cache.push_back({m_id, log.get(), log});
+
+        return *log;
+    }
+
+    void game_commands::record(const command& entry) {
+        local_log().commands.push_back(entry);
+    }
+
+    void game_commands::apply_destroy(entt::registry& registry, const entt::entity entity,
+                                      [[maybe_unused]] void* payload) {
+        // Pooled entities go back to their pool, as with `game_entities::destroy`.
+        if (registry.all_of<component_pooled>(entity) == true) {
+            system_pool::release(registry, entity);
+        } else {
+            registry.destroy(entity);
+        }
+    }
+
+    void* game_commands::command_log::allocate(const std::size_t size,
+                                               const std::size_t alignment) {
+        while (true) {
+            if (block_index < blocks.size()) {
+                payload_block& block = blocks[block_index];
+                const std::size_t offset = (block.used + alignment - 1) & ~(alignment - 1);
+
+                if (offset + size <= block.size) {
+                    block.used = offset + size;
+                    return block.data.get() + offset;
+                }
+
+                ++block_index;
+                continue;
+            }
+
+            const std::size_t block_size = std::max(payload_block_size, size + alignment);
+            blocks.push_back({std::make_unique<std::byte[]>(block_size), block_size, 0});
+        }
+    }
+
+    void game_commands::command_log::reset() noexcept {
+        commands.clear();
+
+        for (payload_block& block : blocks) {
+            block.used = 0;
+        }
+
+        block_index = 0;
+    }
+}  // namespace engine
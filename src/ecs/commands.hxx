@@ -0,0 +1,187 @@
+/**
+ * @file commands.hxx
+ * @brief Deferred entity commands recorded from any thread and applied in one batch.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <entt/entt.hpp>
+
+namespace engine {
+    /**
+     * @brief Records entity creates, destroys and component adds/removes for later.
+     *
+     * Every thread appends to its own log without taking a lock (a thread only locks once, the
+     * first time it records into a given buffer). `flush` gathers the logs, sorts the commands
+     * into creates, component changes and destroys, groups adds and removes by component type so
+     * each storage is touched in one run, and applies them to the registry. Adds and removes on
+     * the same storage keep the order one thread recorded them in, so removing a component and
+     * adding it back leaves it added.
+     *
+     * Recording may happen from any number of threads at once, but never at the same time as
+     * `flush`.
+     */
+    class game_commands {
+    public:
+        game_commands();
+        ~game_commands();
+
+        game_commands(const game_commands&) = delete;
+        game_commands& operator=(const game_commands&) = delete;
+        game_commands(game_commands&&) = delete;
+        game_commands& operator=(game_commands&&) = delete;
+
+        /**
+         * @brief Reserve an entity that is created on the next flush.
+         * @return A placeholder that other commands in this buffer accept in place of the entity.
+         *         It is not valid in the registry and must not be used there. It only stands for
+         *         the entity until that flush, commands recorded with it afterwards are dropped.
+         * @note Placeholder indices wrap after about a million creates, one kept that long may
+         *       stand for a newer entity.
+         */
+        [[nodiscard]] entt::entity create();
+
+        void destroy(entt::entity entity);
+
+        /**
+         * @brief Add or replace a component on the next flush.
+         */
+        template <typename Component, typename... Args>
+        void add(entt::entity entity, Args&&... args);
+
+        template <typename Component>
+        void remove(entt::entity entity);
+
+        /**
+         * @brief Apply and clear every recorded command.
+         * @note Commands on entities that no longer exist are dropped.
+         */
+        void flush(entt::registry& registry);
+
+        /**
+         * @brief Check whether an entity is a placeholder returned by `create`.
+         */
+        [[nodiscard]] static bool is_placeholder(entt::entity entity) noexcept;
+
+    private:
+        enum class command_phase : std::uint8_t { create, change, destroy };
+
+        using apply_function = void (*)(entt::registry& registry, entt::entity entity,
+                                        void* payload);
+        using discard_function = void (*)(void* payload);
+
+        struct command {
+            command_phase phase;
+            entt::id_type type;
+            entt::entity entity;
+            void* payload;
+            apply_function apply;
+            discard_function discard;
+        };
+
+        /**
+         * @brief Payload memory that never moves, so components need not be trivially copyable.
+         */
+        struct payload_block {
+            std::unique_ptr<std::byte[]> data;
+            std::size_t size;
+            std::size_t used;
+        };
+
+        struct command_log {
+            std::vector<command> commands;
+            std::vector<payload_block> blocks;
+            std::size_t block_index = 0;
+
+            void* allocate(std::size_t size, std::size_t alignment);
+            void reset() noexcept;
+        };
+
+        command_log& local_log();
+        void record(const command& entry);
+
+        template <typename Component>
+        static void apply_add(entt::registry& registry, entt::entity entity, void* payload);
+
+        template <typename Component>
+        static void apply_remove(entt::registry& registry, entt::entity entity, void* payload);
+
+        template <typename Component>
+        static void discard_payload(void* payload);
+
+        static void apply_destroy(entt::registry& registry, entt::entity entity, void* payload);
+
+    private:
+        const std::uint64_t m_id;  ///< Never reused, identifies this buffer in thread caches.
+
+        std::mutex m_logs_mutex;
+        std::vector<std::shared_ptr<command_log>> m_logs;  ///< Thread caches watch these expire.
+
+        /**
+         * @brief Placeholders handed out over the buffer's life, and how many were flushed. Neither
+         *        is reset, so a placeholder from an earlier flush is not taken for a current one.
+         */
+        std::atomic<std::uint64_t> m_next_placeholder;
+        std::uint64_t m_flushed_placeholder;
+        std::vector<entt::entity> m_created;  ///< Placeholders of this flush to real entities.
+        std::vector<const command*> m_sorted;
+    };
+
+    template <typename Component, typename... Args>
+    void game_commands::add(const entt::entity entity, Args&&... args) {
+        static_assert(alignof(Component) <= alignof(std::max_align_t),
+                      "Over-aligned components cannot be deferred.");
+
+        command_log& log = local_log();
+        void* payload = log.allocate(sizeof(Component), alignof(Component));
+
+        if constexpr (std::is_aggregate_v<Component>) {
+            ::new (payload) Component{std::forward<Args>(args)...};
+        } else {
+            ::new (payload) Component(std::forward<Args>(args)...);
+        }
+
+        log.commands.push_back({command_phase::change, entt::type_hash<Component>::value(), entity,
+                                payload, &apply_add<Component>, &discard_payload<Component>});
+    }
+
+    template <typename Component>
+    void game_commands::remove(const entt::entity entity) {
+        record({command_phase::change, entt::type_hash<Component>::value(), entity, nullptr,
+                &apply_remove<Component>, nullptr});
+    }
+
+    template <typename Component>
+    void game_commands::apply_add(entt::registry& registry, const entt::entity entity,
+                                  void* payload) {
+        auto* component = static_cast<Component*>(payload);
+
+        if constexpr (std::is_empty_v<Component>) {
+            registry.emplace_or_replace<Component>(entity);
+        } else {
+            registry.emplace_or_replace<Component>(entity, std::move(*component));
+        }
+
+        component->~Component();
+    }
+
+    template <typename Component>
+    void game_commands::apply_remove(entt::registry& registry, const entt::entity entity,
+                                     [[maybe_unused]] void* payload) {
+        registry.remove<Component>(entity);
+    }
+
+    template <typename Component>
+    void game_commands::discard_payload(void* payload) {
+        static_cast<Component*>(payload)->~Component();
+    }
+}  // namespace engine
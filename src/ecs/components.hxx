@@ -1,8 +1,12 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <concepts>
+#include <cstdint>
 #include <memory>
+#include <entt/entt.hpp>
 #include "../renderer/sprite.hxx"
+#include "particles.hxx"
 
 namespace engine {
     struct component_sprite {
@@ -20,9 +24,35 @@ namespace engine {
         }
     };
 
+    /**
+     * @brief Marks an entity as drawn on `layer`.
+     * @note Visibility used to be a leading `bool is_visible` field and now lives in which storage
+     *       holds this component, see `component_hidden`. The old `{is_visible, layer}` and
+     *       `{is_visible}` shapes are deleted so they fail to compile rather than silently turn
+     *       into a visible entity on a layer picked from the flag.
+     */
     struct component_renderable {
-        bool is_visible = true;
         int layer = 0;
+
+        component_renderable() = default;
+
+        explicit component_renderable(const int render_layer) : layer(render_layer) {
+        }
+
+        template <std::same_as<bool> Visible>
+        component_renderable(Visible is_visible) = delete;
+
+        template <std::same_as<bool> Visible>
+        component_renderable(Visible is_visible, int layer) = delete;
+    };
+
+    /**
+     * @brief Holds the `component_renderable` of a hidden entity.
+     * @note Hidden entities have no `component_renderable`, so render views never visit them. Use
+     *       `game_entities::set_renderable_visible` instead of moving these around by hand.
+     */
+    struct component_hidden {
+        component_renderable renderable;
     };
 
     struct component_transform {
@@ -34,12 +64,48 @@ namespace engine {
     struct component_interpolation {
         glm::vec2 previous_position = {0.0f, 0.0f};
         float previous_rotation = 0.0f;
+
+        /**
+         * @brief Update-rate LOD: ticks between the previous and the next physics step, and ticks
+         *        since the previous one. Both stay at 1 and 0 for bodies stepped every tick.
+         */
+        std::uint8_t lod_window = 1;
+        std::uint8_t lod_elapsed = 0;
+
+        /**
+         * @brief Blend factor from `previous_*` to the current transform.
+         * @note A body stepped every few ticks spreads one step over its whole window, so it keeps
+         *       moving smoothly between steps and when its window changes.
+         */
+        [[nodiscard]] float get_fraction(const float fraction_to_next_tick) const noexcept {
+            return (static_cast<float>(lod_elapsed) + fraction_to_next_tick) /
+                   static_cast<float>(lod_window);
+        }
+    };
+
+    /**
+     * @brief Attaches an entity to a parent, making its `component_transform` local to it.
+     * @note Use `game_entities::attach` and `detach`, which keep the cached world transform and
+     *       the depth-first storage order up to date.
+     */
+    struct component_hierarchy {
+        entt::entity parent = entt::null;
+        bool is_rotation_inherited = true;
+        bool is_scale_inherited = true;
+
+        // Maintained by system_hierarchy.
+        component_transform world;
+        component_transform previous_world;   // world transform on the previous tick
+        component_transform composed_local;   // inputs of the last composition, so unchanged
+        component_transform composed_parent;  // subtrees can be skipped
+        std::uint32_t order = 0;              // position in the depth-first sweep
     };
 
     struct component_velocity_linear {
         glm::vec2 value = {0.0f, 0.0f};
         float max_speed = 1000.0f;
         float drag = 0.0f;
+        std::uint32_t resting_ticks = 0;  // consecutive ticks spent below the sleep threshold
     };
 
     struct component_velocity_angular {
@@ -48,7 +114,115 @@ namespace engine {
         float drag = 0.0f;
     };
 
+    /**
+     * @brief Tag for physics bodies that came to rest and are skipped by `system_physics`.
+     */
+    struct component_sleeping {};
+
+    /**
+     * @brief Tag for pooled entities that were released and wait to be spawned again.
+     * @note Every system skips disabled entities, their components are kept for reuse.
+     */
+    struct component_disabled {};
+
+    /**
+     * @brief Marks an entity as owned by a pool in `game_entities`.
+     */
+    struct component_pooled {
+        std::uint32_t pool = 0;
+        bool is_active = true;  // false while released and waiting for reuse
+    };
+
+    /**
+     * @brief Destroys the entity after a number of seconds.
+     * @note Read when the component is added or replaced and never counted down, so writing to it
+     *       in place has no effect. Replace it to change the lifetime, and use
+     *       `game_entities::get_lifetime_remaining` for the time left.
+     */
     struct component_lifetime {
-        float remaining_seconds = 5.f;
+        float remaining_seconds = 5.f;  ///< Seconds from when the component was added or replaced.
+
+        /**
+         * @brief Tick the lifetime runs out on, 0 until the next update files it.
+         * @note Owned by `system_lifetime`. A lifetime whose expiry tick no longer matches the one
+         *       it was filed under counts as replaced and never expires, so leave it alone.
+         */
+        std::uint64_t expiry_tick = 0;
+    };
+
+    enum class collider_shape : std::uint8_t { circle, box };
+
+    /**
+     * @brief Collision shape centred on the entity's own position, in world units.
+     * @note Rotation and scale are ignored. Two colliders are a candidate pair when each one's
+     *       `layers` share a bit with the other's `mask`.
+     */
+    struct component_collider {
+        collider_shape shape = collider_shape::circle;
+        float radius = 0.0f;                  ///< Circles only.
+        glm::vec2 half_size = {0.0f, 0.0f};  ///< Boxes only.
+        std::uint32_t layers = 1;
+        std::uint32_t mask = UINT32_MAX;
+    };
+
+    /**
+     * @brief Tag for fast colliders, such as bullets, that `system_collision` sweeps from their
+     *        previous position so they cannot pass through thin colliders between ticks.
+     * @note Needs a `component_interpolation` for the previous position.
+     */
+    struct component_continuous {};
+
+    /**
+     * @brief Mass properties of a rigid body, whose contacts `system_solver` resolves.
+     * @note Needs a `component_collider` and a `component_velocity_linear`, and a
+     *       `component_velocity_angular` to spin. Colliders without a body, or with a body of
+     *       zero inverse mass and inertia, are immovable. Use `game_entities::set_body`, which
+     *       derives the inertia from the collider.
+     */
+    struct component_body {
+        float inverse_mass = 1.0f;
+        float inverse_inertia = 0.0f;  ///< About the centre, per mass times square units.
+        float restitution = 0.2f;      ///< Share of the closing speed kept as a bounce.
+        float friction = 0.4f;
+    };
+
+    /**
+     * @brief Agent that `system_flocking` steers with the agents around it.
+     * @note Needs a `component_velocity_linear`. Agents keep clear of every agent but only align
+     *       and group with their own flock.
+     */
+    struct component_flock {
+        std::uint32_t flock = 0;
+    };
+
+    /**
+     * @brief Agent that `system_flow` walks to `destination` along a shared flow field.
+     * @note Needs a `component_velocity_linear`, which the flow overwrites every tick.
+     */
+    struct component_flow_agent {
+        glm::vec2 destination = {0.0f, 0.0f};
+        float speed = 100.0f;  ///< Units per second.
+    };
+
+    /**
+     * @brief Source of particles that `system_particles` keeps in a pool of its own rather than
+     *        as entities.
+     * @note Needs a `component_transform`, particles spawn at the world position. They live on in
+     *       world space when the emitter moves, stops or is destroyed.
+     */
+    struct component_emitter {
+        std::string sprite_key;  ///< Texture of each particle, flat squares when empty.
+        float rate = 32.0f;      ///< Particles per second.
+        std::uint32_t budget = 1024;  ///< Most particles of this emitter alive at once.
+        bool is_emitting = true;
+
+        float lifetime_min = 1.0f;  ///< Seconds.
+        float lifetime_max = 1.0f;
+        float speed_min = 32.0f;  ///< Units per second.
+        float speed_max = 64.0f;
+        float direction = 0.0f;  ///< Degrees, around which particles spread.
+        float spread = 360.0f;   ///< Degrees.
+
+        game_particle_motion motion;
     };
 }  // namespace engine
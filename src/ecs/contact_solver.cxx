@@ -0,0 +1,218 @@
+/**
+ * @file contact_solver.cxx
+ * @brief Sequential impulse contact solver implementation.
+ */
+
+#include "contact_solver.hxx"
+
+#include <algorithm>
+#include <numeric>
+
+namespace engine {
+    namespace {
+        /**
+         * @brief Warm start only when the normal barely turned, an impulse along an old normal
+         *        would push the bodies the wrong way.
+         */
+        constexpr float warm_start_alignment = 0.95f;
+
+        float cross(const glm::vec2& left, const glm::vec2& right) {
+            return (left.x * right.y) - (left.y * right.x);
+        }
+
+        /**
+         * @brief Velocity of a point at `offset` from a body spinning at `angular_velocity`.
+         */
+        glm::vec2 cross(const float angular_velocity, const glm::vec2& offset) {
+            return {-angular_velocity * offset.y, angular_velocity * offset.x};
+        }
+
+        glm::vec2 get_tangent(const glm::vec2& normal) {
+            return {-normal.y, normal.x};
+        }
+
+        /**
+         * @brief Velocity of the contact point on `second` relative to the one on `first`.
+         */
+        glm::vec2 get_relative_velocity(const game_solver_body& first,
+                                        const game_solver_body& second,
+                                        const glm::vec2& first_offset,
+                                        const glm::vec2& second_offset) {
+            return second.linear_velocity + cross(second.angular_velocity, second_offset) -
+                   first.linear_velocity - cross(first.angular_velocity, first_offset);
+        }
+
+        /**
+         * @brief Inverse of the mass the contact point resists a push along `direction` with.
+         */
+        float get_effective_mass(const game_solver_body& first, const game_solver_body& second,
+                                 const glm::vec2& first_offset, const glm::vec2& second_offset,
+                                 const glm::vec2& direction) {
+            const float first_arm = cross(first_offset, direction);
+            const float second_arm = cross(second_offset, direction);
+            const float inverse = first.inverse_mass + second.inverse_mass +
+                                  (first.inverse_inertia * first_arm * first_arm) +
+                                  (second.inverse_inertia * second_arm * second_arm);
+
+            return inverse > 0.0f ? 1.0f / inverse : 0.0f;
+        }
+
+        void apply_impulse(game_solver_body& first, game_solver_body& second,
+                           const glm::vec2& first_offset, const glm::vec2& second_offset,
+                           const glm::vec2& impulse) {
+            first.linear_velocity -= impulse * first.inverse_mass;
+            first.angular_velocity -= first.inverse_inertia * cross(first_offset, impulse);
+            second.linear_velocity += impulse * second.inverse_mass;
+            second.angular_velocity += second.inverse_inertia * cross(second_offset, impulse);
+        }
+    }  // namespace
+
+    void game_contact_solver::solve(std::span<game_solver_body> bodies,
+                                    std::span<const game_solver_contact> contacts,
+                                    const float tick_interval,
+                                    const game_solver_settings& settings) {
+        m_constraints.clear();
+        m_constraints.reserve(contacts.size());
+        m_warm_started_count = 0;
+
+        const float inverse_interval = tick_interval > 0.0f ? 1.0f / tick_interval : 0.0f;
+
+        for (const game_solver_contact& contact : contacts) {
+            game_solver_body& first = bodies[contact.first];
+            game_solver_body& second = bodies[contact.second];
+            const glm::vec2 tangent = get_tangent(contact.normal);
+
+            constraint entry = {contact.key,
+                                contact.first,
+                                contact.second,
+                                contact.normal,
+                                contact.first_offset,
+                                contact.second_offset,
+                                get_effective_mass(first, second, contact.first_offset,
+                                                   contact.second_offset, contact.normal),
+                                get_effective_mass(first, second, contact.first_offset,
+                                                   contact.second_offset, tangent),
+                                0.0f,
+                                contact.friction,
+                                0.0f,
+                                0.0f};
+
+            if (entry.normal_mass == 0.0f) {
+                continue;
+            }
+
+            // Bounce off fast impacts, otherwise only push out what sinks past the slop.
+            const float closing = glm::dot(
+                get_relative_velocity(first, second, contact.first_offset, contact.second_offset),
+                contact.normal);
+            entry.bias = settings.baumgarte * inverse_interval *
+                         std::max(contact.penetration - settings.slop, 0.0f);
+            if (closing < -settings.restitution_threshold) {
+                entry.bias = std::max(entry.bias, -contact.restitution * closing);
+            }
+
+            if (settings.is_warm_starting == true) {
+                const auto found = m_impulses.find(contact.key);
+                if (found != m_impulses.end() &&
+                    glm::dot(found->second.normal, contact.normal) >= warm_start_alignment) {
+                    entry.normal_impulse = found->second.normal_impulse;
+                    entry.tangent_impulse = found->second.tangent_impulse;
+                    apply_impulse(first, second, entry.first_offset, entry.second_offset,
+                                  (entry.normal * entry.normal_impulse) +
+                                      (tangent * entry.tangent_impulse));
+                    ++m_warm_started_count;
+                }
+            }
+
+            m_constraints.push_back(entry);
+        }
+
+        for (std::uint32_t iteration = 0; iteration < settings.iterations; ++iteration) {
+            for (constraint& entry : m_constraints) {
+                game_solver_body& first = bodies[entry.first];
+                game_solver_body& second = bodies[entry.second];
+                const glm::vec2 tangent = get_tangent(entry.normal);
+
+                // Friction first, bounded by the normal impulse of the previous pass.
+                const float sliding = glm::dot(
+                    get_relative_velocity(first, second, entry.first_offset, entry.second_offset),
+                    tangent);
+                const float friction_limit = entry.friction * entry.normal_impulse;
+                const float tangent_impulse =
+                    std::clamp(entry.tangent_impulse - (sliding * entry.tangent_mass),
+                               -friction_limit, friction_limit);
+                apply_impulse(first, second, entry.first_offset, entry.second_offset,
+                              tangent * (tangent_impulse - entry.tangent_impulse));
+                entry.tangent_impulse = tangent_impulse;
+
+                // Contacts push and never pull, so only the running total is clamped at zero.
+                const float separating = glm::dot(
+                    get_relative_velocity(first, second, entry.first_offset, entry.second_offset),
+                    entry.normal);
+                const float normal_impulse = std::max(
+                    entry.normal_impulse + ((entry.bias - separating) * entry.normal_mass), 0.0f);
+                apply_impulse(first, second, entry.first_offset, entry.second_offset,
+                              entry.normal * (normal_impulse - entry.normal_impulse));
+                entry.normal_impulse = normal_impulse;
+            }
+        }
+
+        // Contacts that are gone by the next solve drop out of the totals with the swap.
+        m_next_impulses.clear();
+        m_next_impulses.reserve(m_constraints.size());
+        for (const constraint& entry : m_constraints) {
+            m_next_impulses.insert_or_assign(
+                entry.key,
+                accumulated_impulse{entry.normal, entry.normal_impulse, entry.tangent_impulse});
+        }
+        std::swap(m_impulses, m_next_impulses);
+    }
+
+    void game_contact_solver::clear() {
+        m_constraints.clear();
+        m_impulses.clear();
+        m_next_impulses.clear();
+        m_warm_started_count = 0;
+    }
+
+    std::uint32_t game_contact_solver::find_islands(std::span<const game_solver_body> bodies,
+                                                    std::span<const game_solver_contact> contacts,
+                                                    std::vector<std::uint32_t>& islands) {
+        m_parents.resize(bodies.size());
+        std::iota(m_parents.begin(), m_parents.end(), std::uint32_t{0});
+
+        const auto find_root = [this](std::uint32_t index) {
+            while (m_parents[index] != index) {
+                m_parents[index] = m_parents[m_parents[index]];
+                index = m_parents[index];
+            }
+            return index;
+        };
+
+        // Immovable bodies pass nothing on, so they must not join what touches them.
+        for (const game_solver_contact& contact : contacts) {
+            if (bodies[contact.first].is_static() == true ||
+                bodies[contact.second].is_static() == true) {
+                continue;
+            }
+
+            const std::uint32_t first = find_root(contact.first);
+            const std::uint32_t second = find_root(contact.second);
+            m_parents[std::max(first, second)] = std::min(first, second);
+        }
+
+        // Roots are the lowest index of their island, so they are numbered before their members.
+        islands.assign(bodies.size(), no_island);
+        std::uint32_t count = 0;
+        for (std::uint32_t i = 0; i < bodies.size(); ++i) {
+            if (bodies[i].is_static() == true) {
+                continue;
+            }
+
+            const std::uint32_t root = find_root(i);
+            islands[i] = root == i ? count++ : islands[root];
+        }
+
+        return count;
+    }
+}  // namespace engine
@@ -0,0 +1,152 @@
+/**
+ * @file contact_solver.hxx
+ * @brief Sequential impulse solver for rigid body contacts, with warm starting and islands.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace engine {
+    /**
+     * @brief Velocities and mass properties of one body, as the solver sees it.
+     * @note Bodies with neither inverse mass nor inverse inertia are immovable.
+     */
+    struct game_solver_body {
+        glm::vec2 linear_velocity = {0.0f, 0.0f};
+        float angular_velocity = 0.0f;  ///< Radians per second.
+        float inverse_mass = 0.0f;
+        float inverse_inertia = 0.0f;
+
+        [[nodiscard]] bool is_static() const noexcept {
+            return inverse_mass == 0.0f && inverse_inertia == 0.0f;
+        }
+    };
+
+    /**
+     * @brief One point of contact between two bodies.
+     */
+    struct game_solver_contact {
+        std::uint64_t key = 0;    ///< Identifies the pair from one tick to the next.
+        std::uint32_t first = 0;  ///< Indices into the bodies passed to `solve`.
+        std::uint32_t second = 0;
+        glm::vec2 normal = {0.0f, 1.0f};        ///< Unit length, from `first` to `second`.
+        glm::vec2 first_offset = {0.0f, 0.0f};  ///< Contact point relative to each body.
+        glm::vec2 second_offset = {0.0f, 0.0f};
+        float penetration = 0.0f;
+        float friction = 0.0f;
+        float restitution = 0.0f;
+    };
+
+    /**
+     * @brief Tunables for `game_contact_solver`.
+     */
+    struct game_solver_settings {
+        /**
+         * @brief Passes over every contact per solve. More passes settle stacks and crowds
+         *        faster, and cost in proportion.
+         */
+        std::uint32_t iterations = 8;
+
+        /**
+         * @brief Share of the penetration beyond `slop` pushed out each tick.
+         */
+        float baumgarte = 0.2f;
+
+        /**
+         * @brief Penetration tolerated without correction, in units, which keeps resting contacts
+         *        touching instead of jittering in and out.
+         */
+        float slop = 0.5f;
+
+        /**
+         * @brief Closing speeds below this do not bounce, in units per second.
+         */
+        float restitution_threshold = 30.0f;
+
+        /**
+         * @brief Start every contact from the impulses it ended the previous solve with.
+         */
+        bool is_warm_starting = true;
+    };
+
+    /**
+     * @brief Solves contacts with sequential impulses.
+     *
+     * Each pass applies, contact by contact, the impulses that stop the bodies sliding and closing
+     * at that contact, clamping the running totals rather than each impulse so later contacts may
+     * take back what earlier ones overdid. Totals are kept by contact key, and a contact found
+     * again on the next solve starts from them, so resting contacts hold after a pass or two
+     * instead of being rebuilt every tick.
+     */
+    class game_contact_solver {
+    public:
+        /**
+         * @brief Change the velocities of `bodies` so that no contact is closing or sliding.
+         * @note Penetration beyond the slop is resolved through velocity too, over several ticks.
+         */
+        void solve(std::span<game_solver_body> bodies,
+                   std::span<const game_solver_contact> contacts, float tick_interval,
+                   const game_solver_settings& settings);
+
+        /**
+         * @brief Forget the impulses of previous solves.
+         */
+        void clear();
+
+        /**
+         * @brief Contacts of the last solve that started from a previous total.
+         */
+        [[nodiscard]] std::size_t get_warm_started_count() const noexcept;
+
+        /**
+         * @brief Group bodies connected through contacts, immovable bodies joining none.
+         * @param islands Receives the island of each body, or `no_island` for immovable ones.
+         * @return Number of islands, numbered from 0 in order of their first body.
+         */
+        std::uint32_t find_islands(std::span<const game_solver_body> bodies,
+                                   std::span<const game_solver_contact> contacts,
+                                   std::vector<std::uint32_t>& islands);
+
+        static constexpr std::uint32_t no_island = UINT32_MAX;
+
+    private:
+        /**
+         * @brief A contact with the terms every pass reuses.
+         */
+        struct constraint {
+            std::uint64_t key;
+            std::uint32_t first;
+            std::uint32_t second;
+            glm::vec2 normal;
+            glm::vec2 first_offset;
+            glm::vec2 second_offset;
+            float normal_mass;
+            float tangent_mass;
+            float bias;  ///< Separating speed the normal impulse aims for, to bounce or push out.
+            float friction;
+            float normal_impulse;
+            float tangent_impulse;
+        };
+
+        struct accumulated_impulse {
+            glm::vec2 normal;
+            float normal_impulse;
+            float tangent_impulse;
+        };
+
+        std::vector<constraint> m_constraints;
+        std::unordered_map<std::uint64_t, accumulated_impulse> m_impulses;
+        std::unordered_map<std::uint64_t, accumulated_impulse> m_next_impulses;
+        std::vector<std::uint32_t> m_parents;  ///< Union-find forest of `find_islands`.
+        std::size_t m_warm_started_count = 0;
+    };
+
+    inline std::size_t game_contact_solver::get_warm_started_count() const noexcept {
+        return m_warm_started_count;
+    }
+}  // namespace engine
@@ -1,19 +1,296 @@
 #include "entities.hxx"
 
 #include "../engine.hxx"
+#include "../safety.hxx"
+#include "fixed_math.hxx"
 
 namespace engine {
+    namespace {
+        void run_system_lifetime(game_entities& entities, const float tick_interval,
+                                 [[maybe_unused]] void* user_data) {
+            entities.system_lifetime_update(tick_interval);
+        }
+
+        void run_system_flow(game_entities& entities, const float tick_interval,
+                             [[maybe_unused]] void* user_data) {
+            system_flow::update(entities.registry(), tick_interval, entities.get_flow_settings());
+        }
+
+        void run_system_flocking(game_entities& entities, const float tick_interval,
+                                 [[maybe_unused]] void* user_data) {
+            system_flocking::update(entities.registry(), tick_interval,
+                                    entities.get_flocking_settings());
+        }
+
+        void run_system_physics(game_entities& entities, const float tick_interval,
+                                [[maybe_unused]] void* user_data) {
+            system_physics::update(entities.registry(), tick_interval,
+                                   entities.get_physics_settings());
+        }
+
+        void run_system_hierarchy(game_entities& entities,
+                                  [[maybe_unused]] const float tick_interval,
+                                  [[maybe_unused]] void* user_data) {
+            system_hierarchy::update(entities.registry());
+        }
+
+        void run_system_tiles(game_entities& entities, const float tick_interval,
+                              [[maybe_unused]] void* user_data) {
+            system_tiles::update(entities.registry(), tick_interval);
+        }
+
+        void run_system_collision(game_entities& entities,
+                                  [[maybe_unused]] const float tick_interval,
+                                  [[maybe_unused]] void* user_data) {
+            system_collision::update(entities.registry());
+        }
+
+        void run_system_solver(game_entities& entities, const float tick_interval,
+                               [[maybe_unused]] void* user_data) {
+            system_solver::update(entities.registry(), tick_interval,
+                                  entities.get_solver_settings());
+        }
+
+        void run_system_spatial(game_entities& entities, [[maybe_unused]] const float tick_interval,
+                                [[maybe_unused]] void* user_data) {
+            system_spatial::update(entities.registry());
+        }
+
+        void run_system_particles(game_entities& entities, const float tick_interval,
+                                  [[maybe_unused]] void* user_data) {
+            system_particles::update(entities.registry(), tick_interval,
+                                     entities.get_particles_settings());
+        }
+    }  // namespace
+
+    game_entities::game_entities()
+        : m_registry(),
+          m_physics_settings(),
+          m_solver_settings(),
+          m_flocking_settings(),
+          m_flow_settings(),
+          m_particles_settings(),
+          m_commands(std::make_unique<game_commands>()),
+          m_systems() {
+        system_physics::attach(m_registry);
+        system_lifetime::attach(m_registry);
+        system_pool::attach(m_registry);
+        system_hierarchy::attach(m_registry);
+        system_renderer::attach(m_registry);
+        system_tiles::attach(m_registry);
+        system_collision::attach(m_registry);
+        system_solver::attach(m_registry);
+        system_spatial::attach(m_registry);
+        system_flocking::attach(m_registry);
+        system_flow::attach(m_registry);
+        system_particles::attach(m_registry);
+
+        // Destroying entities, detaching orphans and running callbacks reshape storages.
+        m_systems.add("lifetime", &run_system_lifetime, game_system_access{}.exclusive());
+        m_systems.add("flow", &run_system_flow,
+                      game_system_access{}
+                          .writes<component_velocity_linear>()
+                          .reads<component_flow_agent, component_transform, component_hierarchy,
+                                 component_sleeping, component_disabled>());
+        m_systems.add("flocking", &run_system_flocking,
+                      game_system_access{}
+                          .writes<component_velocity_linear>()
+                          .reads<component_flock, component_transform, component_hierarchy,
+                                 component_sleeping, component_disabled>());
+        m_systems.add("physics", &run_system_physics,
+                      game_system_access{}
+                          .writes<component_transform, component_velocity_linear,
+                                  component_velocity_angular, component_interpolation,
+                                  component_sleeping>()
+                          .reads<component_disabled>());
+        m_systems.add("hierarchy", &run_system_hierarchy, game_system_access{}.exclusive());
+        m_systems.add("tiles", &run_system_tiles,
+                      game_system_access{}
+                          .writes<component_transform, component_velocity_linear>()
+                          .reads<component_collider, component_interpolation, component_hierarchy,
+                                 component_sleeping, component_disabled>());
+        m_systems.add("collision", &run_system_collision,
+                      game_system_access{}
+                          .reads<component_collider, component_continuous, component_transform,
+                                 component_interpolation, component_velocity_linear,
+                                 component_sleeping, component_disabled>());
+        // Waking bodies reshapes the physics groups.
+        m_systems.add("solver", &run_system_solver,
+                      game_system_access{}
+                          .writes<component_transform, component_velocity_linear,
+                                  component_velocity_angular, component_interpolation,
+                                  component_sleeping>()
+                          .reads<component_body, component_collider, component_disabled>());
+        m_systems.add("spatial", &run_system_spatial,
+                      game_system_access{}
+                          .reads<component_transform, component_hierarchy, component_sprite,
+                                 component_collider, component_velocity_linear,
+                                 component_velocity_angular, component_sleeping,
+                                 component_disabled>());
+        // Pools live outside the registry, only emitters and where they are are read.
+        m_systems.add("particles", &run_system_particles,
+                      game_system_access{}.reads<component_emitter, component_transform,
+                                                 component_hierarchy, component_disabled>());
+    }
+
     void game_entities::system_physics_update(const float tick_interval) {
-        system_physics::update(m_registry, tick_interval);
+        system_physics::update(m_registry, tick_interval, m_physics_settings);
+        system_hierarchy::update(m_registry);
+    }
+
+    bool game_entities::attach(entt::entity child, entt::entity parent,
+                               const bool is_rotation_inherited, const bool is_scale_inherited) {
+        return system_hierarchy::attach_child(m_registry, child, parent, is_rotation_inherited,
+                                              is_scale_inherited);
+    }
+
+    void game_entities::detach(entt::entity child) {
+        system_hierarchy::detach_child(m_registry, child);
+    }
+
+    component_transform game_entities::get_transform_world(entt::entity entity) const {
+        if (m_registry.all_of<component_transform>(entity) == false) {
+            return {};
+        }
+
+        return system_hierarchy::get_world(m_registry, entity);
+    }
+
+    system_physics_counts game_entities::get_physics_counts() {
+        return system_physics::count_bodies(m_registry);
+    }
+
+    std::uint64_t game_entities::get_state_hash() const {
+        return system_physics::hash_state(m_registry);
+    }
+
+    void game_entities::wake(entt::entity entity) {
+        m_registry.remove<component_sleeping>(entity);
+
+        if (auto* vel = m_registry.try_get<component_velocity_linear>(entity); vel) {
+            vel->resting_ticks = 0;
+        }
+    }
+
+    void game_entities::system_tiles_update(const float tick_interval) {
+        system_tiles::update(m_registry, tick_interval);
+    }
+
+    game_tile_grid& game_entities::get_tile_grid() {
+        return system_tiles::get_grid(m_registry);
+    }
+
+    const game_tile_grid& game_entities::get_tile_grid() const {
+        return system_tiles::get_grid(m_registry);
+    }
+
+    void game_entities::set_tile_layers(const std::uint32_t layers) {
+        system_tiles::set_layers(m_registry, layers);
+    }
+
+    std::span<const entt::entity> game_entities::get_tile_blocked() const {
+        return system_tiles::get_blocked(m_registry);
+    }
+
+    void game_entities::system_collision_update() {
+        system_collision::update(m_registry);
+    }
+
+    std::span<const game_collision_pair> game_entities::get_collision_pairs() const {
+        return system_collision::get_pairs(m_registry);
+    }
+
+    std::span<const game_collision_contact> game_entities::get_collision_contacts() const {
+        return system_collision::get_contacts(m_registry);
+    }
+
+    void game_entities::set_collision_grid(const float cell_size, const float margin) {
+        system_collision::set_grid(m_registry, cell_size, margin);
+    }
+
+    void game_entities::system_solver_update(const float tick_interval) {
+        system_solver::update(m_registry, tick_interval, m_solver_settings);
+    }
+
+    game_solver_stats game_entities::get_solver_stats() const {
+        return system_solver::get_stats(m_registry);
+    }
+
+    void game_entities::system_flow_update(const float tick_interval) {
+        system_flow::update(m_registry, tick_interval, m_flow_settings);
+    }
+
+    game_flow_fields& game_entities::get_flow_fields() {
+        return system_flow::get_fields(m_registry);
+    }
+
+    const game_flow_fields& game_entities::get_flow_fields() const {
+        return system_flow::get_fields(m_registry);
+    }
+
+    void game_entities::system_particles_update(const float tick_interval) {
+        system_particles::update(m_registry, tick_interval, m_particles_settings);
+    }
+
+    game_particle_stats game_entities::get_particles_stats() const {
+        return system_particles::get_stats(m_registry);
+    }
+
+    const game_particle_pool* game_entities::get_emitter_particles(entt::entity entity) const {
+        return system_particles::get_pool(m_registry, entity);
+    }
+
+    void game_entities::system_flocking_update(const float tick_interval) {
+        system_flocking::update(m_registry, tick_interval, m_flocking_settings);
+    }
+
+    game_flocking_stats game_entities::get_flocking_stats() const {
+        return system_flocking::get_stats(m_registry);
+    }
+
+    const game_neighborhood& game_entities::get_flocking_neighborhood() const {
+        return system_flocking::get_neighborhood(m_registry);
+    }
+
+    entt::entity game_entities::get_flocking_agent(const std::uint32_t slot) const {
+        return system_flocking::get_agent(m_registry, slot);
+    }
+
+    void game_entities::system_spatial_update() {
+        system_spatial::update(m_registry);
+    }
+
+    void game_entities::set_spatial_resources(game_resources* resources) {
+        system_spatial::set_resources(m_registry, resources);
+    }
+
+    void game_entities::set_spatial_margin(const float margin) {
+        system_spatial::set_margin(m_registry, margin);
+    }
+
+    std::size_t game_entities::query_rect(const glm::vec2& min, const glm::vec2& max,
+                                          std::span<entt::entity> out) const {
+        return system_spatial::get_tree(m_registry).query_rect({min, max}, out);
+    }
+
+    std::size_t game_entities::query_point(const glm::vec2& point,
+                                           std::span<entt::entity> out) const {
+        return system_spatial::get_tree(m_registry).query_point(point, out);
+    }
+
+    std::size_t game_entities::raycast(const glm::vec2& origin, const glm::vec2& end,
+                                       std::span<game_raycast_hit> out) const {
+        return system_spatial::get_tree(m_registry).raycast(origin, end, out);
     }
 
     void game_entities::system_lifetime_update(const float tick_interval) {
-        system_lifetime::update(m_registry, tick_interval);
+        system_lifetime::update(*this, tick_interval);
     }
 
     void game_entities::system_renderer_update(game_renderer* renderer, game_resources& resources,
                                                const float fraction_to_next_tick) {
         system_renderer::update(m_registry, renderer, resources, fraction_to_next_tick);
+        system_particles::draw(m_registry, renderer, resources, fraction_to_next_tick);
     }
 
     entt::entity game_entities::sprite_create(std::string_view resource_key) {
@@ -22,7 +299,7 @@ namespace engine {
         m_registry.emplace<component_transform>(entity, glm::vec2{0.0f, 0.0f}, 0.0f,
                                                 glm::vec2{1.0f, 1.0f});
         m_registry.emplace<component_sprite>(entity, resource_key);
-        m_registry.emplace<component_renderable>(entity, true, 0);
+        m_registry.emplace<component_renderable>(entity, 0);
 
         return entity;
     }
@@ -37,13 +314,136 @@ namespace engine {
         return entity;
     }
 
+    void game_entities::sprite_create_batch(std::string_view resource_key,
+                                            std::span<entt::entity> entities,
+                                            std::span<const glm::vec2> positions,
+                                            std::span<const float> rotations) {
+        paranoid_ensure(positions.empty() == true || positions.size() == entities.size(),
+                        "Batch positions must be empty or match the entity count");
+        paranoid_ensure(rotations.empty() == true || rotations.size() == entities.size(),
+                        "Batch rotations must be empty or match the entity count");
+
+        // The entity storage too, so `create` does not grow it piecemeal either.
+        reserve<entt::entity, component_transform, component_sprite, component_renderable>(
+            entities.size());
+
+        m_registry.create(entities.begin(), entities.end());
+
+        if (positions.empty() == true && rotations.empty() == true) {
+            m_registry.insert<component_transform>(entities.begin(), entities.end());
+        } else {
+            // Built up front so the storage is filled by one contiguous insert.
+            std::vector<component_transform> transforms(entities.size());
+            for (std::size_t i = 0; i < transforms.size(); ++i) {
+                if (positions.empty() == false) {
+                    transforms[i].position = positions[i];
+                }
+
+                if (rotations.empty() == false) {
+                    transforms[i].rotation = rotations[i];
+                }
+            }
+
+            m_registry.insert<component_transform>(entities.begin(), entities.end(),
+                                                   transforms.cbegin());
+        }
+
+        m_registry.insert<component_sprite>(entities.begin(), entities.end(),
+                                            component_sprite{resource_key});
+        m_registry.insert<component_renderable>(entities.begin(), entities.end(),
+                                                component_renderable{0});
+    }
+
+    void game_entities::sprite_create_interpolated_batch(std::string_view resource_key,
+                                                         std::span<entt::entity> entities,
+                                                         std::span<const glm::vec2> positions,
+                                                         std::span<const glm::vec2> velocities,
+                                                         std::span<const float> rotations) {
+        paranoid_ensure(velocities.empty() == true || velocities.size() == entities.size(),
+                        "Batch velocities must be empty or match the entity count");
+
+        // `sprite_create_batch` reserves the storages it fills itself.
+        reserve<component_velocity_linear, component_velocity_angular, component_interpolation>(
+            entities.size());
+
+        sprite_create_batch(resource_key, entities, positions, rotations);
+
+        if (velocities.empty() == true) {
+            m_registry.insert<component_velocity_linear>(
+                entities.begin(), entities.end(),
+                component_velocity_linear{glm::vec2{0.0f, 0.0f}, 0.0f, 0.0f});
+        } else {
+            std::vector<component_velocity_linear> linears(
+                entities.size(), component_velocity_linear{glm::vec2{0.0f, 0.0f}, 0.0f, 0.0f});
+            for (std::size_t i = 0; i < linears.size(); ++i) {
+                linears[i].value = velocities[i];
+            }
+
+            m_registry.insert<component_velocity_linear>(entities.begin(), entities.end(),
+                                                         linears.cbegin());
+        }
+
+        m_registry.insert<component_velocity_angular>(entities.begin(), entities.end(),
+                                                      component_velocity_angular{0.0f, 0.0f, 0.0f});
+
+        // Interpolation starts at the initial transform, taken from the same spans.
+        if (positions.empty() == true && rotations.empty() == true) {
+            m_registry.insert<component_interpolation>(entities.begin(), entities.end());
+        } else {
+            std::vector<component_interpolation> interpolations(entities.size());
+            for (std::size_t i = 0; i < interpolations.size(); ++i) {
+                if (positions.empty() == false) {
+                    interpolations[i].previous_position = positions[i];
+                }
+
+                if (rotations.empty() == false) {
+                    interpolations[i].previous_rotation = rotations[i];
+                }
+            }
+
+            m_registry.insert<component_interpolation>(entities.begin(), entities.end(),
+                                                       interpolations.cbegin());
+        }
+    }
+
+    entt::entity game_entities::pool_spawn(std::string_view resource_key,
+                                           const glm::vec2& position, const float rotation) {
+        entt::entity entity = system_pool::acquire(m_registry, resource_key);
+        if (entity == entt::null) {
+            entity = sprite_create_interpolated(resource_key);
+            system_pool::adopt(m_registry, entity, resource_key);
+        }
+
+        component_transform& transform = m_registry.get<component_transform>(entity);
+        transform.position = position;
+        transform.rotation = rotation;
+
+        // A reused body starts a fresh LOD window, so it steps on the next tick.
+        m_registry.get<component_interpolation>(entity) = {position, rotation};
+
+        return entity;
+    }
+
+    void game_entities::pool_reserve(std::string_view resource_key, const std::size_t count) {
+        std::vector<entt::entity> entities(count);
+        sprite_create_interpolated_batch(resource_key, entities);
+
+        for (const entt::entity entity : entities) {
+            system_pool::adopt(m_registry, entity, resource_key, false);
+        }
+    }
+
+    game_pool_stats game_entities::get_pool_stats(std::string_view resource_key) const {
+        return system_pool::get_stats(m_registry, resource_key);
+    }
+
     entt::entity game_entities::create_text_dynamic(std::string_view resource_key) {
         entt::entity entity = m_registry.create();
 
         m_registry.emplace<component_transform>(entity, glm::vec2{0.0f, 0.0f}, 0.0f,
                                                 glm::vec2{1.0f, 1.0f});
         m_registry.emplace<component_text_dynamic>(entity, resource_key);
-        m_registry.emplace<component_renderable>(entity, true, 0);
+        m_registry.emplace<component_renderable>(entity, 0);
 
         return entity;
     }
@@ -51,6 +451,19 @@ namespace engine {
     void game_entities::set_transform_position(entt::entity entity, const glm::vec2& position) {
         if (auto* transform = m_registry.try_get<component_transform>(entity); transform) {
             transform->position = position;
+            wake(entity);
+            system_spatial::mark_moved(m_registry, entity);
+
+            if (m_registry.all_of<component_collider>(entity) == true) {
+                system_collision::mark_moved(m_registry, entity);
+            }
+
+            // A teleport is not movement, continuous colliders must not be swept along it.
+            if (m_registry.all_of<component_continuous>(entity) == true) {
+                if (auto* interp = m_registry.try_get<component_interpolation>(entity); interp) {
+                    interp->previous_position = position;
+                }
+            }
         }
     }
 
@@ -64,10 +477,15 @@ namespace engine {
 
     glm::vec2 game_entities::get_interpolated_position(entt::entity entity,
                                                        float fraction_to_next_tick) const {
+        if (const auto* node = m_registry.try_get<component_hierarchy>(entity); node) {
+            return glm::mix(node->previous_world.position, node->world.position,
+                            fraction_to_next_tick);
+        }
+
         if (const auto* transform = m_registry.try_get<component_transform>(entity); transform) {
             if (const auto* interp = m_registry.try_get<component_interpolation>(entity); interp) {
                 return glm::mix(interp->previous_position, transform->position,
-                                fraction_to_next_tick);
+                                interp->get_fraction(fraction_to_next_tick));
             }
 
             return transform->position;
@@ -78,10 +496,15 @@ namespace engine {
 
     float game_entities::get_interpolated_rotation(entt::entity entity,
                                                    float fraction_to_next_tick) const {
+        if (const auto* node = m_registry.try_get<component_hierarchy>(entity); node) {
+            return glm::mix(node->previous_world.rotation, node->world.rotation,
+                            fraction_to_next_tick);
+        }
+
         if (const auto* transform = m_registry.try_get<component_transform>(entity)) {
             if (const auto* interp = m_registry.try_get<component_interpolation>(entity)) {
                 return glm::mix(interp->previous_rotation, transform->rotation,
-                                fraction_to_next_tick);
+                                interp->get_fraction(fraction_to_next_tick));
             }
 
             return transform->rotation;
@@ -93,6 +516,7 @@ namespace engine {
     void game_entities::set_transform_scale(entt::entity entity, const glm::vec2& new_scale) {
         if (auto* transform = m_registry.try_get<component_transform>(entity); transform) {
             transform->scale = new_scale;
+            system_spatial::mark_moved(m_registry, entity);
         }
     }
 
@@ -106,6 +530,10 @@ namespace engine {
 
     glm::vec2 game_entities::get_vector_forward(entt::entity entity) const {
         if (const auto* transform = m_registry.try_get<component_transform>(entity); transform) {
+            if (m_physics_settings.kernel == physics_kernel::deterministic) {
+                return fixed_direction(transform->rotation + 90.f);
+            }
+
             float radians = glm::radians(transform->rotation + 90.f);
             return glm::vec2{glm::cos(radians), glm::sin(radians)};
         }
@@ -115,6 +543,10 @@ namespace engine {
 
     glm::vec2 game_entities::get_vector_right(entt::entity entity) const {
         if (const auto* transform = m_registry.try_get<component_transform>(entity); transform) {
+            if (m_physics_settings.kernel == physics_kernel::deterministic) {
+                return fixed_direction(transform->rotation);
+            }
+
             float radians = glm::radians(transform->rotation);
             return glm::vec2{glm::cos(radians), glm::sin(radians)};
         }
@@ -165,12 +597,14 @@ namespace engine {
     void game_entities::set_velocity_linear(entt::entity entity, const glm::vec2& velocity) {
         if (auto* vel = m_registry.try_get<component_velocity_linear>(entity); vel) {
             vel->value = velocity;
+            wake(entity);
         }
     }
 
     void game_entities::add_impulse_velocity_linear(entt::entity entity, const glm::vec2& impulse) {
         if (auto* vel = m_registry.try_get<component_velocity_linear>(entity); vel) {
             vel->value += impulse;
+            wake(entity);
         }
     }
 
@@ -189,12 +623,14 @@ namespace engine {
     void game_entities::set_velocity_angular(entt::entity entity, float angular_velocity) {
         if (auto* vel = m_registry.try_get<component_velocity_angular>(entity); vel) {
             vel->value = angular_velocity;
+            wake(entity);
         }
     }
 
     void game_entities::add_impulse_velocity_angular(entt::entity entity, float angular_impulse) {
         if (auto* vel = m_registry.try_get<component_velocity_angular>(entity); vel) {
             vel->value += angular_impulse;
+            wake(entity);
         }
     }
 
@@ -211,14 +647,144 @@ namespace engine {
     }
 
     void game_entities::set_renderable_visible(entt::entity entity, bool is_visible) {
+        // Visibility is which storage holds the renderable, so hiding moves it aside.
+        if (is_visible == true) {
+            if (auto* hidden = m_registry.try_get<component_hidden>(entity); hidden) {
+                const component_renderable renderable = hidden->renderable;
+                m_registry.erase<component_hidden>(entity);
+                m_registry.emplace<component_renderable>(entity, renderable);
+            }
+            return;
+        }
+
         if (auto* renderable = m_registry.try_get<component_renderable>(entity); renderable) {
-            renderable->is_visible = is_visible;
+            const component_hidden hidden{*renderable};
+            m_registry.erase<component_renderable>(entity);
+            m_registry.emplace<component_hidden>(entity, hidden);
         }
     }
 
+    bool game_entities::is_renderable_visible(entt::entity entity) const {
+        return m_registry.all_of<component_renderable>(entity);
+    }
+
     void game_entities::set_renderable_layer(entt::entity entity, int layer) {
         if (auto* renderable = m_registry.try_get<component_renderable>(entity); renderable) {
             renderable->layer = layer;
+        } else if (auto* hidden = m_registry.try_get<component_hidden>(entity); hidden) {
+            hidden->renderable.layer = layer;
         }
     }
+
+    void game_entities::set_collider_circle(entt::entity entity, const float radius,
+                                            const std::uint32_t layers, const std::uint32_t mask) {
+        m_registry.emplace_or_replace<component_collider>(
+            entity, collider_shape::circle, radius, glm::vec2{0.0f, 0.0f}, layers, mask);
+    }
+
+    void game_entities::set_collider_box(entt::entity entity, const glm::vec2& half_size,
+                                         const std::uint32_t layers, const std::uint32_t mask) {
+        m_registry.emplace_or_replace<component_collider>(entity, collider_shape::box, 0.0f,
+                                                          half_size, layers, mask);
+    }
+
+    void game_entities::set_collider_continuous(entt::entity entity, const bool is_continuous) {
+        if (is_continuous == false) {
+            m_registry.remove<component_continuous>(entity);
+            return;
+        }
+
+        if (m_registry.all_of<component_interpolation>(entity) == false) {
+            const component_transform* transform = m_registry.try_get<component_transform>(entity);
+            if (transform == nullptr) {
+                return;
+            }
+
+            m_registry.emplace<component_interpolation>(entity, transform->position,
+                                                        transform->rotation);
+        }
+
+        m_registry.emplace_or_replace<component_continuous>(entity);
+    }
+
+    void game_entities::set_body(entt::entity entity, const float mass, const float restitution,
+                                 const float friction) {
+        if (m_registry.all_of<component_transform>(entity) == false) {
+            return;
+        }
+
+        component_body body = {0.0f, 0.0f, restitution, friction};
+        if (mass > 0.0f) {
+            body.inverse_mass = 1.0f / mass;
+
+            // Colliders ignore rotation, so only a circle is the same shape however it spins.
+            const auto* collider = m_registry.try_get<component_collider>(entity);
+            if (collider != nullptr && collider->shape == collider_shape::circle &&
+                collider->radius > 0.0f) {
+                body.inverse_inertia = 2.0f / (mass * collider->radius * collider->radius);
+            }
+
+            if (m_registry.all_of<component_velocity_linear>(entity) == false) {
+                m_registry.emplace<component_velocity_linear>(entity);
+            }
+        }
+
+        m_registry.emplace_or_replace<component_body>(entity, body);
+        wake(entity);
+    }
+
+    void game_entities::set_flock(entt::entity entity, const std::uint32_t flock) {
+        if (m_registry.all_of<component_transform>(entity) == false) {
+            return;
+        }
+
+        if (m_registry.all_of<component_velocity_linear>(entity) == false) {
+            m_registry.emplace<component_velocity_linear>(entity);
+        }
+
+        m_registry.emplace_or_replace<component_flock>(entity, flock);
+        wake(entity);
+    }
+
+    void game_entities::set_flow_destination(entt::entity entity, const glm::vec2& destination,
+                                             const float speed) {
+        if (m_registry.all_of<component_transform>(entity) == false) {
+            return;
+        }
+
+        if (m_registry.all_of<component_velocity_linear>(entity) == false) {
+            m_registry.emplace<component_velocity_linear>(entity);
+        }
+
+        m_registry.emplace_or_replace<component_flow_agent>(entity, destination, speed);
+        wake(entity);
+    }
+
+    void game_entities::set_emitter(entt::entity entity, const component_emitter& emitter) {
+        if (m_registry.all_of<component_transform>(entity) == false) {
+            return;
+        }
+
+        m_registry.emplace_or_replace<component_emitter>(entity, emitter);
+    }
+
+    game_timer_handle game_entities::timer_schedule_once(entt::entity entity, float seconds,
+                                                         game_entity_callback callback,
+                                                         void* user_data) {
+        return system_lifetime::schedule(m_registry, entity, seconds, false, callback, user_data);
+    }
+
+    game_timer_handle game_entities::timer_schedule_repeating(entt::entity entity, float seconds,
+                                                              game_entity_callback callback,
+                                                              void* user_data) {
+        return system_lifetime::schedule(m_registry, entity, seconds, true, callback, user_data);
+    }
+
+    void game_entities::timer_cancel(game_timer_handle handle) {
+        system_lifetime::cancel(m_registry, handle);
+    }
+
+    float game_entities::get_lifetime_remaining(entt::entity entity) const {
+        return system_lifetime::get_remaining(m_registry, entity);
+    }
 }  // namespace engine
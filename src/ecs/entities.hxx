@@ -5,8 +5,12 @@
 
 #pragma once
 
+#include <memory>
+#include <span>
 #include <string_view>
 #include <entt/entt.hpp>
+#include "commands.hxx"
+#include "scheduler.hxx"
 #include "systems.hxx"
 #include "components.hxx"
 
@@ -19,7 +23,7 @@ namespace engine {
      */
     class game_entities {
     public:
-        game_entities() = default;
+        game_entities();
         ~game_entities() = default;
 
         // Registry is non-copyable
@@ -32,13 +36,218 @@ namespace engine {
         [[nodiscard]] entt::registry& registry();
         [[nodiscard]] const entt::registry& registry() const;
 
+        /**
+         * @brief Systems run by `systems_update`.
+         * @note Starts out with "lifetime", "flow", "flocking", "physics", "hierarchy", "tiles",
+         *       "collision", "solver", "spatial" and "particles", in that order, which is the
+         *       same work as calling `system_lifetime_update`, `system_flow_update`,
+         *       `system_flocking_update`, `system_physics_update`, `system_tiles_update`,
+         *       `system_collision_update`, `system_solver_update`, `system_spatial_update` and
+         *       then `system_particles_update`.
+         */
+        [[nodiscard]] game_systems& systems() noexcept;
+
+        /**
+         * @brief Run every enabled system once, overlapping the ones that do not conflict.
+         */
+        void systems_update(float tick_interval);
+
         // System updates
+
+        /**
+         * @brief Integrate velocities, then compose the world transforms of attached entities.
+         */
         void system_physics_update(float tick_interval);
+
+        /**
+         * @brief Tunables used by `system_physics_update`, such as the integration kernel.
+         */
+        [[nodiscard]] system_physics_settings& get_physics_settings() noexcept;
+        [[nodiscard]] const system_physics_settings& get_physics_settings() const noexcept;
+
+        /**
+         * @brief Count moving bodies that are awake versus asleep.
+         * @note Setting a velocity, adding an impulse or moving an entity through this class wakes
+         *       it. Writing to its components directly does not.
+         */
+        [[nodiscard]] system_physics_counts get_physics_counts();
+
+        /**
+         * @brief Hash of every transform, velocity and sleeping body, see
+         *        `system_physics::hash_state`.
+         * @note With the `deterministic` physics kernel, peers and replays fed the same input
+         *       agree on it tick after tick.
+         */
+        [[nodiscard]] std::uint64_t get_state_hash() const;
+
+        /**
+         * @brief Stop colliders that moved into solid tiles of the tile grid this tick.
+         */
+        void system_tiles_update(float tick_interval);
+
+        /**
+         * @brief Solid tiles of the world, empty until filled, see `system_tiles`.
+         */
+        [[nodiscard]] game_tile_grid& get_tile_grid();
+        [[nodiscard]] const game_tile_grid& get_tile_grid() const;
+
+        /**
+         * @brief Layers solid tiles are on, see `system_tiles::set_layers`.
+         */
+        void set_tile_layers(std::uint32_t layers);
+
+        /**
+         * @brief Colliders stopped by a tile during the last tiles update.
+         * @note Valid until the next tiles update.
+         */
+        [[nodiscard]] std::span<const entt::entity> get_tile_blocked() const;
+
+        /**
+         * @brief Re-file moved colliders in the broadphase grid and collect candidate pairs.
+         */
+        void system_collision_update();
+
+        /**
+         * @brief Pairs of colliders whose bounds overlap, as of the last collision update.
+         * @note Valid until the next collision update.
+         */
+        [[nodiscard]] std::span<const game_collision_pair> get_collision_pairs() const;
+
+        /**
+         * @brief First hits of continuous colliders during the last tick, as of the last
+         *        collision update.
+         * @note Valid until the next collision update.
+         */
+        [[nodiscard]] std::span<const game_collision_contact> get_collision_contacts() const;
+
+        /**
+         * @brief Resize the broadphase grid, see `system_collision::set_grid`.
+         */
+        void set_collision_grid(float cell_size, float margin);
+
+        /**
+         * @brief Push apart the rigid bodies among the last collision update's pairs, see
+         *        `set_body`.
+         */
+        void system_solver_update(float tick_interval);
+
+        /**
+         * @brief Tunables used by `system_solver_update`, such as the number of iterations.
+         */
+        [[nodiscard]] game_solver_settings& get_solver_settings() noexcept;
+        [[nodiscard]] const game_solver_settings& get_solver_settings() const noexcept;
+
+        /**
+         * @brief Contacts and islands of the last solver update.
+         */
+        [[nodiscard]] game_solver_stats get_solver_stats() const;
+
+        /**
+         * @brief Walk every flow agent towards its destination, see `set_flow_destination`.
+         */
+        void system_flow_update(float tick_interval);
+
+        /**
+         * @brief Navigation grid and flow field cache of flow agents, empty until resized.
+         */
+        [[nodiscard]] game_flow_fields& get_flow_fields();
+        [[nodiscard]] const game_flow_fields& get_flow_fields() const;
+
+        /**
+         * @brief Tunables used by `system_flow_update`, such as the pool fields are built on.
+         */
+        [[nodiscard]] system_flow_settings& get_flow_settings() noexcept;
+        [[nodiscard]] const system_flow_settings& get_flow_settings() const noexcept;
+
+        /**
+         * @brief Steer the agents of every flock by the agents around them, see `set_flock`.
+         */
+        void system_flocking_update(float tick_interval);
+
+        /**
+         * @brief Tunables used by `system_flocking_update`, such as the neighbourhood radius.
+         */
+        [[nodiscard]] system_flocking_settings& get_flocking_settings() noexcept;
+        [[nodiscard]] const system_flocking_settings& get_flocking_settings() const noexcept;
+
+        [[nodiscard]] game_flocking_stats get_flocking_stats() const;
+
+        /**
+         * @brief The agents as of the last flocking update, for AI to run its own neighbourhood
+         *        queries on. `get_flocking_agent` turns its slots into entities.
+         */
+        [[nodiscard]] const game_neighborhood& get_flocking_neighborhood() const;
+        [[nodiscard]] entt::entity get_flocking_agent(std::uint32_t slot) const;
+
+        /**
+         * @brief Spawn from every emitter and step their particles, see `set_emitter`.
+         */
+        void system_particles_update(float tick_interval);
+
+        /**
+         * @brief Tunables used by `system_particles_update`, such as the particle budget.
+         */
+        [[nodiscard]] system_particles_settings& get_particles_settings() noexcept;
+        [[nodiscard]] const system_particles_settings& get_particles_settings() const noexcept;
+
+        [[nodiscard]] game_particle_stats get_particles_stats() const;
+
+        /**
+         * @brief Particles of an emitter, or null before its first particles update.
+         */
+        [[nodiscard]] const game_particle_pool* get_emitter_particles(entt::entity entity) const;
+
+        /**
+         * @brief Refit moved entities in the spatial tree used by the queries below.
+         */
+        void system_spatial_update();
+
+        /**
+         * @brief Where the spatial tree looks up sprite sizes, scenes pass their own resources.
+         */
+        void set_spatial_resources(game_resources* resources);
+
+        /**
+         * @brief Change how far entities move before they are re-inserted in the spatial tree,
+         *        see `system_spatial::set_margin`.
+         */
+        void set_spatial_margin(float margin);
+
+        /**
+         * @brief Entities whose bounds overlap the rectangle from `min` to `max`.
+         * @return Number of entities written to `out`, the query stops once it is full.
+         * @note Queries see entities as of the last spatial update, and never allocate.
+         */
+        std::size_t query_rect(const glm::vec2& min, const glm::vec2& max,
+                               std::span<entt::entity> out) const;
+
+        /**
+         * @brief Entities whose bounds contain `point`, such as the world position under the
+         *        mouse from `game_viewport::screen_to_world`.
+         * @return Number of entities written to `out`, the query stops once it is full.
+         */
+        std::size_t query_point(const glm::vec2& point, std::span<entt::entity> out) const;
+
+        /**
+         * @brief Entities whose bounds the segment from `origin` to `end` passes through.
+         * @return Number of hits written to `out`, nearest first. The nearest hits are kept when
+         *         more are found than fit.
+         */
+        std::size_t raycast(const glm::vec2& origin, const glm::vec2& end,
+                            std::span<game_raycast_hit> out) const;
+
+        /**
+         * @brief Destroy entities whose lifetime ran out and run scheduled callbacks that are due.
+         */
         void system_lifetime_update(float tick_interval);
         void system_renderer_update(game_renderer* renderer, game_resources& resources,
                                     float fraction_to_next_tick);
 
         [[nodiscard]] entt::entity create();
+
+        /**
+         * @brief Destroy an entity, or release it back to its pool if it came from `pool_spawn`.
+         */
         void destroy(entt::entity entity);
 
         [[nodiscard]] bool is_valid(entt::entity entity) const;
@@ -48,6 +257,47 @@ namespace engine {
         entt::entity sprite_create_interpolated(std::string_view resource_key);
         entt::entity create_text_dynamic(std::string_view resource_key);
 
+        /**
+         * @brief Create one sprite per element of `entities` in a single batch.
+         * @param resource_key The sprite every new entity draws.
+         * @param entities Receives the new entities, its size is the number to create.
+         * @param positions Initial positions, either empty or one per entity.
+         * @param rotations Initial rotations in degrees, either empty or one per entity.
+         * @note Every storage is reserved up front and filled with contiguous inserts, which is
+         *       much cheaper than calling `sprite_create` in a loop for large waves.
+         */
+        void sprite_create_batch(std::string_view resource_key, std::span<entt::entity> entities,
+                                 std::span<const glm::vec2> positions = {},
+                                 std::span<const float> rotations = {});
+
+        /**
+         * @brief Batch version of `sprite_create_interpolated`.
+         * @param velocities Initial linear velocities, either empty or one per entity.
+         * @note Interpolation starts at the initial transform, so nothing streaks in on the first
+         *       frame.
+         */
+        void sprite_create_interpolated_batch(std::string_view resource_key,
+                                              std::span<entt::entity> entities,
+                                              std::span<const glm::vec2> positions = {},
+                                              std::span<const glm::vec2> velocities = {},
+                                              std::span<const float> rotations = {});
+
+        /**
+         * @brief Spawn an interpolated sprite from the pool named after `resource_key`.
+         * @note Reuses a released entity when there is one, with its components as they were left
+         *       and its velocities at rest, and only creates a new one when the pool is empty.
+         *       Interpolation starts at the given transform either way.
+         */
+        entt::entity pool_spawn(std::string_view resource_key,
+                                const glm::vec2& position = {0.0f, 0.0f}, float rotation = 0.0f);
+
+        /**
+         * @brief Create released entities up front so that `count` spawns need no allocation.
+         */
+        void pool_reserve(std::string_view resource_key, std::size_t count);
+
+        [[nodiscard]] game_pool_stats get_pool_stats(std::string_view resource_key) const;
+
         // Component access - simplified API
         template <typename Component>
         Component& get(entt::entity entity);
@@ -70,10 +320,51 @@ namespace engine {
         template <typename... Components>
         bool has(entt::entity entity) const;
 
+        /**
+         * @brief Deferred versions of `create`, `destroy`, `add` and `remove`.
+         *
+         * These are safe to call while iterating views, from callbacks and from worker threads.
+         * They are applied in one batch by `deferred_flush`, which the engine calls after every
+         * tick. `deferred_create` returns a placeholder that only the other deferred calls accept.
+         */
+        [[nodiscard]] entt::entity deferred_create();
+        void deferred_destroy(entt::entity entity);
+
+        template <typename Component, typename... Args>
+        void deferred_add(entt::entity entity, Args&&... args);
+
+        template <typename Component>
+        void deferred_remove(entt::entity entity);
+
+        void deferred_flush();
+
         // Query methods
         template <typename... Components>
         auto view();
 
+        /**
+         * @brief Attach `child` to `parent`, so it follows the parent's world transform.
+         * @param is_rotation_inherited Whether the child turns with the parent, labels usually do
+         *        not.
+         * @param is_scale_inherited Whether the child grows and shrinks with the parent.
+         * @return False if either entity has no transform or the attachment would form a loop.
+         * @note The child's own transform becomes its offset from the parent. World transforms
+         *       are composed by `system_physics_update` and interpolated when drawn.
+         */
+        bool attach(entt::entity child, entt::entity parent, bool is_rotation_inherited = true,
+                    bool is_scale_inherited = true);
+
+        /**
+         * @brief Detach `child` from its parent, leaving it where it currently is in the world.
+         */
+        void detach(entt::entity child);
+
+        /**
+         * @brief The entity's transform in world space, which differs from its own transform only
+         *        when it is attached.
+         */
+        [[nodiscard]] component_transform get_transform_world(entt::entity entity) const;
+
         void set_transform_position(entt::entity entity, const glm::vec2& position);
         glm::vec2 get_transform_position(entt::entity entity) const;
 
@@ -89,7 +380,8 @@ namespace engine {
          * @brief Get the forward vector (unit vector) based on the entity's rotation.
          * @param entity The entity to get the forward vector for.
          * @return The forward vector as a glm::vec2.
-         * @note Default forward is (0, 1) (+Y) when rotation is 0 degrees.
+         * @note Default forward is (0, 1) (+Y) when rotation is 0 degrees. Computed in fixed
+         *       point under the `deterministic` physics kernel.
          */
         [[nodiscard]] glm::vec2 get_vector_forward(entt::entity entity) const;
 
@@ -97,7 +389,8 @@ namespace engine {
          * @brief Get the right vector (unit vector) based on the entity's rotation.
          * @param entity The entity to get the right vector for.
          * @return The right vector as a glm::vec2.
-         * @note Default right is (1, 0) (+X) when rotation is 0 degrees.
+         * @note Default right is (1, 0) (+X) when rotation is 0 degrees. Computed in fixed point
+         *       under the `deterministic` physics kernel.
          */
         [[nodiscard]] glm::vec2 get_vector_right(entt::entity entity) const;
 
@@ -120,11 +413,111 @@ namespace engine {
         void set_velocity_angular_drag(entt::entity entity, float angular_drag);
         void set_velocity_angular_max(entt::entity entity, float max_angular_speed);
 
+        /**
+         * @brief Show or hide an entity in `system_renderer_update`.
+         * @note Hidden entities cost the renderer nothing, their `component_renderable` is kept in
+         *       a `component_hidden` until they are shown again.
+         */
         void set_renderable_visible(entt::entity entity, bool is_visible);
+        [[nodiscard]] bool is_renderable_visible(entt::entity entity) const;
         void set_renderable_layer(entt::entity entity, int layer);
 
+        /**
+         * @brief Give an entity a circle or box collider, replacing any it had.
+         * @param layers Layers the collider is on.
+         * @param mask Layers the collider pairs with.
+         */
+        void set_collider_circle(entt::entity entity, float radius, std::uint32_t layers = 1,
+                                 std::uint32_t mask = UINT32_MAX);
+        void set_collider_box(entt::entity entity, const glm::vec2& half_size,
+                              std::uint32_t layers = 1, std::uint32_t mask = UINT32_MAX);
+
+        /**
+         * @brief Sweep a fast collider between ticks so it reports hits it would otherwise pass
+         *        through, see `get_collision_contacts`.
+         * @note Adds a `component_interpolation` if the entity has none, for its previous position.
+         */
+        void set_collider_continuous(entt::entity entity, bool is_continuous);
+
+        /**
+         * @brief Make an entity a rigid body that contacts push around, replacing any body it had.
+         * @param mass Zero or less makes the body immovable, like a collider without one.
+         * @param restitution Share of the closing speed kept as a bounce, the larger of two
+         *        bodies' is used.
+         * @note Set the collider first: circles get the inertia of a disc, boxes never spin. Adds
+         *       a `component_velocity_linear` if a movable body has none.
+         */
+        void set_body(entt::entity entity, float mass, float restitution = 0.2f,
+                      float friction = 0.4f);
+
+        /**
+         * @brief Make an entity an agent of `flock`, steered by `system_flocking_update`.
+         * @note Needs a transform. Adds a `component_velocity_linear` if the entity has none.
+         */
+        void set_flock(entt::entity entity, std::uint32_t flock = 0);
+
+        /**
+         * @brief Send an entity to `destination` at `speed`, along the flow fields of
+         *        `system_flow_update`.
+         * @note Needs a transform. Adds a `component_velocity_linear` if the entity has none, and
+         *       wakes it, which changing the component directly does not.
+         */
+        void set_flow_destination(entt::entity entity, const glm::vec2& destination,
+                                  float speed = 100.0f);
+
+        /**
+         * @brief Make an entity emit particles as `emitter` describes, drawn after sprites by
+         *        `system_renderer_update`.
+         * @note Needs a transform.
+         */
+        void set_emitter(entt::entity entity, const component_emitter& emitter);
+
+        /**
+         * @brief Run `callback` on `entity` once, `seconds` from now.
+         * @note Callbacks run inside `system_lifetime_update` and are dropped once the entity is
+         *       destroyed.
+         */
+        game_timer_handle timer_schedule_once(entt::entity entity, float seconds,
+                                              game_entity_callback callback,
+                                              void* user_data = nullptr);
+
+        /**
+         * @brief Run `callback` on `entity` every `seconds` until cancelled or destroyed.
+         */
+        game_timer_handle timer_schedule_repeating(entt::entity entity, float seconds,
+                                                   game_entity_callback callback,
+                                                   void* user_data = nullptr);
+
+        void timer_cancel(game_timer_handle handle);
+
+        /**
+         * @brief Seconds left before `entity` is destroyed by its `component_lifetime`, 0 if it
+         *        has none.
+         * @note `component_lifetime::remaining_seconds` is not counted down, read this instead.
+         */
+        [[nodiscard]] float get_lifetime_remaining(entt::entity entity) const;
+
+    private:
+        /**
+         * @brief Put a sleeping body back into the physics tick.
+         */
+        void wake(entt::entity entity);
+
+        /**
+         * @brief Grow each storage so `additional` more components fit without reallocating.
+         */
+        template <typename... Components>
+        void reserve(std::size_t additional);
+
     private:
         entt::registry m_registry;
+        system_physics_settings m_physics_settings;
+        game_solver_settings m_solver_settings;
+        system_flocking_settings m_flocking_settings;
+        system_flow_settings m_flow_settings;
+        system_particles_settings m_particles_settings;
+        std::unique_ptr<game_commands> m_commands;
+        game_systems m_systems;
     };
 
     // Inline implementations
@@ -136,12 +529,67 @@ namespace engine {
         return m_registry;
     }
 
+    inline game_systems& game_entities::systems() noexcept {
+        return m_systems;
+    }
+
+    inline void game_entities::systems_update(const float tick_interval) {
+        m_systems.update(*this, tick_interval);
+    }
+
+    inline system_physics_settings& game_entities::get_physics_settings() noexcept {
+        return m_physics_settings;
+    }
+
+    inline const system_physics_settings& game_entities::get_physics_settings() const noexcept {
+        return m_physics_settings;
+    }
+
+    inline game_solver_settings& game_entities::get_solver_settings() noexcept {
+        return m_solver_settings;
+    }
+
+    inline const game_solver_settings& game_entities::get_solver_settings() const noexcept {
+        return m_solver_settings;
+    }
+
+    inline system_flow_settings& game_entities::get_flow_settings() noexcept {
+        return m_flow_settings;
+    }
+
+    inline const system_flow_settings& game_entities::get_flow_settings() const noexcept {
+        return m_flow_settings;
+    }
+
+    inline system_particles_settings& game_entities::get_particles_settings() noexcept {
+        return m_particles_settings;
+    }
+
+    inline const system_particles_settings& game_entities::get_particles_settings()
+        const noexcept {
+        return m_particles_settings;
+    }
+
+    inline system_flocking_settings& game_entities::get_flocking_settings() noexcept {
+        return m_flocking_settings;
+    }
+
+    inline const system_flocking_settings& game_entities::get_flocking_settings() const noexcept {
+        return m_flocking_settings;
+    }
+
     inline entt::entity game_entities::create() {
         return m_registry.create();
     }
 
     inline void game_entities::destroy(entt::entity entity) {
-        if (m_registry.valid(entity)) {
+        if (m_registry.valid(entity) == false) {
+            return;
+        }
+
+        if (m_registry.all_of<component_pooled>(entity) == true) {
+            system_pool::release(m_registry, entity);
+        } else {
             m_registry.destroy(entity);
         }
     }
@@ -189,6 +637,35 @@ namespace engine {
         return m_registry.all_of<Components...>(entity);
     }
 
+    template <typename... Components>
+    inline void game_entities::reserve(const std::size_t additional) {
+        (m_registry.storage<Components>().reserve(m_registry.storage<Components>().size() +
+                                                  additional),
+         ...);
+    }
+
+    inline entt::entity game_entities::deferred_create() {
+        return m_commands->create();
+    }
+
+    inline void game_entities::deferred_destroy(entt::entity entity) {
+        m_commands->destroy(entity);
+    }
+
+    template <typename Component, typename... Args>
+    inline void game_entities::deferred_add(entt::entity entity, Args&&... args) {
+        m_commands->add<Component>(entity, std::forward<Args>(args)...);
+    }
+
+    template <typename Component>
+    inline void game_entities::deferred_remove(entt::entity entity) {
+        m_commands->remove<Component>(entity);
+    }
+
+    inline void game_entities::deferred_flush() {
+        m_commands->flush(m_registry);
+    }
+
     template <typename... Components>
     inline auto game_entities::view() {
         return m_registry.view<Components...>();
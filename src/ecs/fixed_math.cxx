@@ -0,0 +1,134 @@
+/**
+ * @file fixed_math.cxx
+ * @brief Integer square root and trigonometry for `game_fixed`.
+ */
+
+#include "fixed_math.hxx"
+
+#include <utility>
+
+namespace engine {
+    namespace {
+        /**
+         * @brief Trigonometry runs with 30 fraction bits and rounds once at the end.
+         */
+        constexpr int trig_bits = 30;
+        constexpr std::int64_t trig_one = std::int64_t{1} << trig_bits;
+
+        /**
+         * @brief Pi / 180 with 30 fraction bits.
+         */
+        constexpr std::int64_t trig_radians_per_degree = 18740330;
+
+        constexpr std::int64_t trig_mul(const std::int64_t left, const std::int64_t right) {
+            return (left * right) >> trig_bits;
+        }
+
+        std::uint64_t square_root(std::uint64_t value) {
+            std::uint64_t root = 0;
+            std::uint64_t bit = std::uint64_t{1} << 62;
+            while (bit > value) {
+                bit >>= 2;
+            }
+
+            while (bit != 0) {
+                if (value >= root + bit) {
+                    value -= root + bit;
+                    root = (root >> 1) + bit;
+                } else {
+                    root >>= 1;
+                }
+                bit >>= 2;
+            }
+
+            return root;
+        }
+
+        /**
+         * @brief Sine and cosine with 30 fraction bits, each within 1e-8.
+         */
+        void sin_cos_precise(const game_fixed degrees, std::int64_t& sine, std::int64_t& cosine) {
+            constexpr game_fixed quarter_turn = fixed_from_int(90);
+            constexpr game_fixed eighth_turn = fixed_from_int(45);
+            constexpr game_fixed full_turn = fixed_from_int(360);
+
+            game_fixed angle = degrees % full_turn;
+            if (angle < 0) {
+                angle += full_turn;
+            }
+
+            const game_fixed quadrant = angle / quarter_turn;
+            game_fixed rest = angle % quarter_turn;
+
+            // Taylor series converge fastest near zero, so the upper half of each quadrant is
+            // taken from the other side of its diagonal.
+            const bool is_mirrored = rest > eighth_turn;
+            if (is_mirrored == true) {
+                rest = quarter_turn - rest;
+            }
+
+            const std::int64_t x = (rest * trig_radians_per_degree) >> fixed_fraction_bits;
+            const std::int64_t x2 = trig_mul(x, x);
+
+            std::int64_t s = trig_one - (x2 / 72);
+            s = trig_one - (trig_mul(x2, s) / 42);
+            s = trig_one - (trig_mul(x2, s) / 20);
+            s = trig_one - (trig_mul(x2, s) / 6);
+            s = trig_mul(x, s);
+
+            std::int64_t c = trig_one - (x2 / 90);
+            c = trig_one - (trig_mul(x2, c) / 56);
+            c = trig_one - (trig_mul(x2, c) / 30);
+            c = trig_one - (trig_mul(x2, c) / 12);
+            c = trig_one - (trig_mul(x2, c) / 2);
+
+            if (is_mirrored == true) {
+                std::swap(s, c);
+            }
+
+            switch (quadrant) {
+                case 0:
+                    sine = s;
+                    cosine = c;
+                    break;
+                case 1:
+                    sine = c;
+                    cosine = -s;
+                    break;
+                case 2:
+                    sine = -s;
+                    cosine = -c;
+                    break;
+                default:
+                    sine = -c;
+                    cosine = s;
+                    break;
+            }
+        }
+
+        constexpr game_fixed round_trig(const std::int64_t value) {
+            constexpr int shift = trig_bits - fixed_fraction_bits;
+            return (value + (std::int64_t{1} << (shift - 1))) >> shift;
+        }
+    }  // namespace
+
+    game_fixed fixed_length(const game_fixed x, const game_fixed y) noexcept {
+        return static_cast<game_fixed>(square_root(fixed_length_squared(x, y)));
+    }
+
+    game_fixed_sin_cos fixed_sin_cos(const game_fixed degrees) noexcept {
+        std::int64_t sine = 0;
+        std::int64_t cosine = 0;
+        sin_cos_precise(degrees, sine, cosine);
+        return {round_trig(sine), round_trig(cosine)};
+    }
+
+    glm::vec2 fixed_direction(const float degrees) noexcept {
+        std::int64_t sine = 0;
+        std::int64_t cosine = 0;
+        sin_cos_precise(fixed_from_float(degrees), sine, cosine);
+
+        constexpr float scale = 1.0f / static_cast<float>(trig_one);
+        return {static_cast<float>(cosine) * scale, static_cast<float>(sine) * scale};
+    }
+}  // namespace engine
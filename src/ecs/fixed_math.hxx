@@ -0,0 +1,90 @@
+/**
+ * @file fixed_math.hxx
+ * @brief Fixed-point arithmetic whose results do not depend on compiler, flags or CPU.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace engine {
+    /**
+     * @brief Signed fixed-point number with `fixed_fraction_bits` bits after the point.
+     *
+     * Only integer operations touch the value, so every build computes the same bits from the
+     * same input. Converting from a float scales it by a power of two, which is exact, and rounds
+     * half away from zero; converting back rounds once to the nearest float.
+     *
+     * @note Products are taken in 64 bits, so values multiplied together must stay under 32768
+     *       in magnitude. Values that are only added, such as positions, may be far larger.
+     */
+    using game_fixed = std::int64_t;
+
+    constexpr int fixed_fraction_bits = 16;
+    constexpr game_fixed fixed_one = game_fixed{1} << fixed_fraction_bits;
+
+    /**
+     * @brief Nearest fixed value to a finite float.
+     */
+    [[nodiscard]] inline game_fixed fixed_from_float(const float value) noexcept {
+        return static_cast<game_fixed>(std::llround(value * static_cast<float>(fixed_one)));
+    }
+
+    [[nodiscard]] inline float fixed_to_float(const game_fixed value) noexcept {
+        return static_cast<float>(value) * (1.0f / static_cast<float>(fixed_one));
+    }
+
+    [[nodiscard]] constexpr game_fixed fixed_from_int(const std::int32_t value) noexcept {
+        return static_cast<game_fixed>(value) * fixed_one;
+    }
+
+    /**
+     * @brief Product rounded to the nearest fixed value, halves rounding up.
+     */
+    [[nodiscard]] constexpr game_fixed fixed_mul(const game_fixed left,
+                                                 const game_fixed right) noexcept {
+        return ((left * right) + (fixed_one / 2)) >> fixed_fraction_bits;
+    }
+
+    /**
+     * @brief Quotient rounded toward zero.
+     * @note `right` must not be 0.
+     */
+    [[nodiscard]] constexpr game_fixed fixed_div(const game_fixed left,
+                                                 const game_fixed right) noexcept {
+        return (left * fixed_one) / right;
+    }
+
+    /**
+     * @brief Squared length of a vector, with twice the fraction bits.
+     */
+    [[nodiscard]] constexpr std::uint64_t fixed_length_squared(const game_fixed x,
+                                                               const game_fixed y) noexcept {
+        const auto x_magnitude = static_cast<std::uint64_t>(x < 0 ? -x : x);
+        const auto y_magnitude = static_cast<std::uint64_t>(y < 0 ? -y : y);
+        return (x_magnitude * x_magnitude) + (y_magnitude * y_magnitude);
+    }
+
+    /**
+     * @brief Length of a vector, rounded down.
+     */
+    [[nodiscard]] game_fixed fixed_length(game_fixed x, game_fixed y) noexcept;
+
+    /**
+     * @brief Sine and cosine of an angle in degrees, accurate to about 1e-5.
+     */
+    struct game_fixed_sin_cos {
+        game_fixed sin = 0;
+        game_fixed cos = fixed_one;
+    };
+
+    [[nodiscard]] game_fixed_sin_cos fixed_sin_cos(game_fixed degrees) noexcept;
+
+    /**
+     * @brief Unit vector pointing `degrees` around from the x axis, the same bits on every build
+     *        unlike `glm::cos` and `glm::sin`.
+     */
+    [[nodiscard]] glm::vec2 fixed_direction(float degrees) noexcept;
+}  // namespace engine
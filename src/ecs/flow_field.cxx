@@ -0,0 +1,488 @@
+/**
+ * @file flow_field.cxx
+ * @brief Flow field integration, repair and caching.
+ */
+
+#include "flow_field.hxx"
+
+#include "../utils/workers.hxx"
+
+#include <algorithm>
+#include <array>
+
+namespace engine {
+    namespace {
+        constexpr std::uint8_t step_count = 8;
+        constexpr std::uint8_t no_step = step_count;
+
+        /**
+         * @brief Neighbours by step, turning a half turn every 4 steps, so the step back from
+         *        `i` is `(i + 4) % 8`. Odd steps are diagonal.
+         */
+        constexpr std::array<glm::ivec2, step_count> step_offsets = {{
+            {1, 0},
+            {1, 1},
+            {0, 1},
+            {-1, 1},
+            {-1, 0},
+            {-1, -1},
+            {0, -1},
+            {1, -1},
+        }};
+
+        constexpr float diagonal = 0.70710678f;
+
+        constexpr std::array<glm::vec2, step_count + 1> step_directions = {{
+            {1.0f, 0.0f},
+            {diagonal, diagonal},
+            {0.0f, 1.0f},
+            {-diagonal, diagonal},
+            {-1.0f, 0.0f},
+            {-diagonal, -diagonal},
+            {0.0f, -1.0f},
+            {diagonal, -diagonal},
+            {0.0f, 0.0f},
+        }};
+
+        /**
+         * @brief Step costs in whole units, 7 / 5 being close enough to the square root of 2.
+         */
+        constexpr std::array<std::uint32_t, step_count> step_weights = {5, 7, 5, 7, 5, 7, 5, 7};
+
+        constexpr std::uint8_t get_step_back(const std::uint8_t step) noexcept {
+            return static_cast<std::uint8_t>((step + 4) % step_count);
+        }
+
+        /**
+         * @brief Longest step between open tiles, the most any distance grows by at once.
+         */
+        constexpr std::uint32_t max_step_cost = 7 * (game_flow_fields::blocked - 1);
+
+        /**
+         * @brief Buckets of open tiles by distance, wrapping around. Open tiles are never more
+         *        than one step ahead of the front, so they never wrap onto it.
+         */
+        constexpr std::uint32_t bucket_count = 2048;
+        constexpr std::uint32_t bucket_mask = bucket_count - 1;
+
+        static_assert(max_step_cost < bucket_count, "A step must fit in the open buckets.");
+
+        constexpr std::uint64_t make_seed(const std::uint32_t distance,
+                                          const std::uint32_t tile) noexcept {
+            return (static_cast<std::uint64_t>(distance) << 32) | tile;
+        }
+    }  // namespace
+
+    struct game_flow_fields::build_tasks {
+        game_flow_fields* fields;
+        std::vector<std::uint32_t> pending;
+        bool is_rebuilt;  ///< Integrate every field from scratch rather than repair them.
+    };
+
+    void game_flow_fields::resize(const glm::ivec2& dimensions, const float tile_size,
+                                  const glm::vec2& origin) {
+        m_dimensions = glm::max(dimensions, glm::ivec2{0, 0});
+        m_origin = origin;
+        m_tile_size = tile_size > 0.0f ? tile_size : 32.0f;
+        m_inverse_tile_size = 1.0f / m_tile_size;
+        m_costs.assign(static_cast<std::size_t>(m_dimensions.x) *
+                           static_cast<std::size_t>(m_dimensions.y),
+                       1);
+        clear();
+    }
+
+    void game_flow_fields::set_cost(const glm::ivec2& tile, std::uint8_t cost) {
+        if (is_inside(tile) == false) {
+            return;
+        }
+
+        cost = std::max<std::uint8_t>(cost, 1);
+        const std::uint32_t index = get_index(tile);
+        if (m_costs[index] == cost) {
+            return;
+        }
+
+        m_costs[index] = cost;
+        if (m_fields.empty() == false) {
+            m_changed.push_back(index);
+        }
+    }
+
+    void game_flow_fields::fill_cost(const glm::ivec2& min, const glm::ivec2& max,
+                                     const std::uint8_t cost) {
+        const glm::ivec2 first = glm::max(min, glm::ivec2{0, 0});
+        const glm::ivec2 last = glm::min(max, m_dimensions - glm::ivec2{1, 1});
+        for (int y = first.y; y <= last.y; ++y) {
+            for (int x = first.x; x <= last.x; ++x) {
+                set_cost({x, y}, cost);
+            }
+        }
+    }
+
+    std::uint8_t game_flow_fields::get_cost(const glm::ivec2& tile) const {
+        return is_inside(tile) == true ? m_costs[get_index(tile)] : blocked;
+    }
+
+    void game_flow_fields::set_capacity(const std::size_t capacity) {
+        m_capacity = capacity;
+    }
+
+    std::uint32_t game_flow_fields::request(const glm::ivec2& goal) {
+        if (is_inside(goal) == false || m_costs[get_index(goal)] == blocked) {
+            return invalid_field;
+        }
+
+        const std::uint32_t goal_index = get_index(goal);
+        if (const auto found = m_field_indices.find(goal_index); found != m_field_indices.end()) {
+            m_fields[found->second].last_request = m_round;
+            return found->second;
+        }
+
+        // Recycle the least recently requested field, unless every one is in use this round.
+        std::uint32_t index = static_cast<std::uint32_t>(m_fields.size());
+        if (m_fields.size() >= m_capacity) {
+            std::uint64_t oldest = m_round;
+            for (std::uint32_t i = 0; i < m_fields.size(); ++i) {
+                if (m_fields[i].last_request < oldest) {
+                    oldest = m_fields[i].last_request;
+                    index = i;
+                }
+            }
+        }
+
+        if (index == m_fields.size()) {
+            m_fields.emplace_back();
+        } else {
+            m_field_indices.erase(get_index(m_fields[index].goal));
+        }
+
+        field& target = m_fields[index];
+        target.goal = goal;
+        target.last_request = m_round;
+        target.is_ready = false;
+        m_field_indices.emplace(goal_index, index);
+        return index;
+    }
+
+    void game_flow_fields::build(game_workers* workers) {
+        m_stats = {};
+
+        // Past a point resetting the paths through changes costs more than starting over.
+        const std::size_t tile_count = m_costs.size();
+        build_tasks tasks{this, {}, m_changed.size() * 8 > tile_count};
+        for (std::uint32_t i = 0; i < m_fields.size(); ++i) {
+            if (m_fields[i].is_ready == false || m_changed.empty() == false) {
+                tasks.pending.push_back(i);
+            }
+        }
+
+        for (const std::uint32_t index : tasks.pending) {
+            if (m_fields[index].is_ready == false || tasks.is_rebuilt == true) {
+                ++m_stats.built;
+            } else {
+                ++m_stats.repaired;
+            }
+        }
+
+        if (workers != nullptr && tasks.pending.size() > 1) {
+            workers->parallel_for(tasks.pending.size(), &build_task, &tasks);
+        } else {
+            for (std::size_t task = 0; task < tasks.pending.size(); ++task) {
+                build_task(task, &tasks);
+            }
+        }
+
+        for (const std::uint32_t index : tasks.pending) {
+            m_stats.settled += m_fields[index].settled;
+        }
+
+        m_changed.clear();
+        ++m_round;
+    }
+
+    bool game_flow_fields::is_ready(const std::uint32_t field_index) const {
+        return field_index < m_fields.size() && m_fields[field_index].is_ready == true;
+    }
+
+    glm::vec2 game_flow_fields::sample(const std::uint32_t field_index,
+                                       const glm::vec2& position) const {
+        const glm::ivec2 tile = get_tile(position);
+        if (is_ready(field_index) == false || is_inside(tile) == false) {
+            return {0.0f, 0.0f};
+        }
+
+        return step_directions[m_fields[field_index].steps[get_index(tile)]];
+    }
+
+    std::uint32_t game_flow_fields::get_distance(const std::uint32_t field_index,
+                                                 const glm::ivec2& tile) const {
+        if (is_ready(field_index) == false || is_inside(tile) == false) {
+            return unreachable;
+        }
+
+        return m_fields[field_index].distances[get_index(tile)];
+    }
+
+    const glm::ivec2& game_flow_fields::get_goal(const std::uint32_t field_index) const {
+        return m_fields[field_index].goal;
+    }
+
+    void game_flow_fields::clear() {
+        m_fields.clear();
+        m_field_indices.clear();
+        m_changed.clear();
+    }
+
+    void game_flow_fields::build_task(const std::size_t task_index, void* user_data) {
+        const auto* tasks = static_cast<const build_tasks*>(user_data);
+        game_flow_fields& fields = *tasks->fields;
+        field& target = fields.m_fields[tasks->pending[task_index]];
+
+        target.settled = 0;
+        if (target.is_ready == false || tasks->is_rebuilt == true) {
+            fields.integrate(target);
+        } else {
+            fields.repair(target);
+        }
+        target.is_ready = true;
+    }
+
+    void game_flow_fields::integrate(field& target) const {
+        target.distances.assign(m_costs.size(), unreachable);
+        target.steps.assign(m_costs.size(), no_step);
+        target.seeds.clear();
+
+        const std::uint32_t goal = get_index(target.goal);
+        if (m_costs[goal] == blocked) {
+            return;
+        }
+
+        target.distances[goal] = 0;
+        target.seeds.push_back(make_seed(0, goal));
+        propagate(target);
+    }
+
+    void game_flow_fields::repair(field& target) const {
+        const std::uint32_t goal = get_index(target.goal);
+        if (std::find(m_changed.begin(), m_changed.end(), goal) != m_changed.end()) {
+            integrate(target);
+            return;
+        }
+
+        std::vector<std::uint32_t>& reset = target.reset;
+        reset.clear();
+        const auto reset_tile = [&](const std::uint32_t tile) {
+            if (target.distances[tile] != unreachable) {
+                target.distances[tile] = unreachable;
+                target.steps[tile] = no_step;
+                reset.push_back(tile);
+            }
+        };
+
+        // A changed tile invalidates its own path and the diagonal steps squeezing past it, which
+        // are taken from the tiles beside it.
+        for (const std::uint32_t tile : m_changed) {
+            reset_tile(tile);
+
+            const glm::ivec2 changed = get_tile_at(tile);
+            for (std::uint8_t step = 0; step < step_count; step += 2) {
+                const glm::ivec2 neighbor = changed + step_offsets[step];
+                if (is_inside(neighbor) == false) {
+                    continue;
+                }
+
+                const std::uint8_t next = target.steps[get_index(neighbor)];
+                if (next == no_step || next % 2 == 0) {
+                    continue;
+                }
+
+                const glm::ivec2 offset = step_offsets[next];
+                if (neighbor + glm::ivec2{offset.x, 0} == changed ||
+                    neighbor + glm::ivec2{0, offset.y} == changed) {
+                    reset_tile(get_index(neighbor));
+                }
+            }
+        }
+
+        // Every tile whose steps lead into a reset tile lost its path too.
+        for (std::size_t i = 0; i < reset.size(); ++i) {
+            const glm::ivec2 tile = get_tile_at(reset[i]);
+            for (std::uint8_t step = 0; step < step_count; ++step) {
+                const glm::ivec2 neighbor = tile + step_offsets[step];
+                if (is_inside(neighbor) == true &&
+                    target.steps[get_index(neighbor)] == get_step_back(step)) {
+                    reset_tile(get_index(neighbor));
+                }
+            }
+        }
+
+        // Reset tiles start again from the paths around them, and changed tiles that got cheaper
+        // may shorten the paths of their neighbours.
+        target.seeds.clear();
+        for (const std::uint32_t tile : reset) {
+            relax_from_neighbors(target, tile);
+        }
+        for (const std::uint32_t tile : m_changed) {
+            const glm::ivec2 changed = get_tile_at(tile);
+            relax_from_neighbors(target, tile);
+            for (const glm::ivec2& offset : step_offsets) {
+                if (is_inside(changed + offset) == true) {
+                    relax_from_neighbors(target, get_index(changed + offset));
+                }
+            }
+        }
+
+        propagate(target);
+    }
+
+    void game_flow_fields::propagate(field& target) const {
+        // Distances only ever grow by whole steps, so tiles are settled in order by walking
+        // buckets of equal distance rather than through a heap.
+        std::vector<std::vector<std::uint32_t>>& buckets = target.buckets;
+        buckets.resize(bucket_count);
+
+        std::vector<std::uint64_t>& seeds = target.seeds;
+        std::sort(seeds.begin(), seeds.end());
+        std::size_t next_seed = 0;
+        std::size_t open_count = 0;
+        std::uint32_t distance = 0;
+
+        for (;; ++distance) {
+            if (open_count == 0) {
+                if (next_seed == seeds.size()) {
+                    break;
+                }
+                distance = static_cast<std::uint32_t>(seeds[next_seed] >> 32);
+            }
+
+            // Seeds join once the front is a step away from them, to keep the buckets unwrapped.
+            while (next_seed < seeds.size()) {
+                const auto seed_distance = static_cast<std::uint32_t>(seeds[next_seed] >> 32);
+                if (seed_distance > distance + max_step_cost) {
+                    break;
+                }
+
+                buckets[seed_distance & bucket_mask].push_back(
+                    static_cast<std::uint32_t>(seeds[next_seed++]));
+                ++open_count;
+            }
+
+            std::vector<std::uint32_t>& bucket = buckets[distance & bucket_mask];
+            while (bucket.empty() == false) {
+                const std::uint32_t tile = bucket.back();
+                bucket.pop_back();
+                --open_count;
+
+                // Left behind when the tile was lowered again after it was opened.
+                if (target.distances[tile] != distance) {
+                    continue;
+                }
+                ++target.settled;
+
+                // Nothing steps into a blocked tile, so none of its neighbours go through it.
+                const std::uint8_t cost = m_costs[tile];
+                if (cost == blocked) {
+                    continue;
+                }
+
+                const glm::ivec2 position = get_tile_at(tile);
+                const std::uint8_t open = get_open_steps(position);
+                const std::uint8_t inside = get_inside_steps(position);
+                for (std::uint8_t step = 0; step < step_count; ++step) {
+                    // Neighbours may be blocked themselves, but a diagonal step from one needs
+                    // both tiles beside it open, which are the steps either side of `step`.
+                    const bool is_open =
+                        (inside & (1u << step)) != 0 &&
+                        (step % 2 == 0 || ((open >> ((step + 7) % step_count)) & 1u &
+                                           (open >> ((step + 1) % step_count)) & 1u) != 0);
+                    if (is_open == false) {
+                        continue;
+                    }
+
+                    const std::uint32_t neighbor = get_index(position + step_offsets[step]);
+                    const std::uint32_t candidate = distance + (step_weights[step] * cost);
+                    if (candidate < target.distances[neighbor]) {
+                        target.distances[neighbor] = candidate;
+                        target.steps[neighbor] = get_step_back(step);
+                        buckets[candidate & bucket_mask].push_back(neighbor);
+                        ++open_count;
+                    }
+                }
+            }
+        }
+
+        seeds.clear();
+    }
+
+    void game_flow_fields::relax_from_neighbors(field& target, const std::uint32_t tile) const {
+        const glm::ivec2 position = get_tile_at(tile);
+        std::uint32_t best = target.distances[tile];
+        std::uint8_t best_step = no_step;
+        for (std::uint8_t step = 0; step < step_count; ++step) {
+            if (is_step_open(position, step) == false) {
+                continue;
+            }
+
+            const std::uint32_t neighbor = get_index(position + step_offsets[step]);
+            if (target.distances[neighbor] == unreachable) {
+                continue;
+            }
+
+            const std::uint32_t candidate =
+                target.distances[neighbor] + (step_weights[step] * m_costs[neighbor]);
+            if (candidate < best) {
+                best = candidate;
+                best_step = step;
+            }
+        }
+
+        if (best_step != no_step) {
+            target.distances[tile] = best;
+            target.steps[tile] = best_step;
+            target.seeds.push_back(make_seed(best, tile));
+        }
+    }
+
+    bool game_flow_fields::is_step_open(const glm::ivec2& tile,
+                                        const std::uint8_t step) const noexcept {
+        const glm::ivec2 next = tile + step_offsets[step];
+        if (is_inside(next) == false || m_costs[get_index(next)] == blocked) {
+            return false;
+        }
+
+        return step % 2 == 0 || (m_costs[get_index({next.x, tile.y})] != blocked &&
+                                 m_costs[get_index({tile.x, next.y})] != blocked);
+    }
+
+    std::uint8_t game_flow_fields::get_inside_steps(const glm::ivec2& tile) const noexcept {
+        std::uint8_t steps = 0;
+        for (std::uint8_t step = 0; step < step_count; ++step) {
+            if (is_inside(tile + step_offsets[step]) == true) {
+                steps |= static_cast<std::uint8_t>(1u << step);
+            }
+        }
+
+        return steps;
+    }
+
+    std::uint8_t game_flow_fields::get_open_steps(const glm::ivec2& tile) const noexcept {
+        std::uint8_t steps = 0;
+        for (std::uint8_t step = 0; step < step_count; ++step) {
+            const glm::ivec2 next = tile + step_offsets[step];
+            if (is_inside(next) == true && m_costs[get_index(next)] != blocked) {
+                steps |= static_cast<std::uint8_t>(1u << step);
+            }
+        }
+
+        return steps;
+    }
+
+    std::uint32_t game_flow_fields::get_index(const glm::ivec2& tile) const noexcept {
+        return static_cast<std::uint32_t>((tile.y * m_dimensions.x) + tile.x);
+    }
+
+    glm::ivec2 game_flow_fields::get_tile_at(const std::uint32_t index) const noexcept {
+        const auto width = static_cast<std::uint32_t>(m_dimensions.x);
+        return {static_cast<int>(index % width), static_cast<int>(index / width)};
+    }
+}  // namespace engine
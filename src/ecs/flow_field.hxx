@@ -0,0 +1,233 @@
+/**
+ * @file flow_field.hxx
+ * @brief Navigation grid with cached flow fields that lead any number of agents to a goal.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace engine {
+    class game_workers;
+
+    /**
+     * @brief Work done by the last `game_flow_fields::build`.
+     */
+    struct game_flow_stats {
+        std::size_t built = 0;     ///< Fields integrated from scratch.
+        std::size_t repaired = 0;  ///< Cached fields patched after costs changed.
+        std::size_t settled = 0;   ///< Tiles given their final distance, over every field.
+    };
+
+    /**
+     * @brief Bounded grid of tile costs and the flow fields towards the goals agents ask for.
+     *
+     * A field is built with one Dijkstra pass outward from its goal over the 8 neighbours of each
+     * tile, which leaves every tile with its distance to the goal and the neighbour to step to,
+     * so an agent anywhere on the grid finds its way with a single lookup. Agents heading to the
+     * same goal share its field however many there are.
+     *
+     * Fields are cached by goal tile, the least recently requested one being recycled once the
+     * cache is full. Changing costs does not throw them away: each build resets the tiles whose
+     * path went through a changed tile and integrates only those again, so a door opening on one
+     * side of the map costs little to fields that never passed it.
+     *
+     * Diagonal steps never cut the corner of a blocked tile. A step costs the cost of the tile it
+     * enters, times 5 straight or 7 diagonally. Blocked tiles next to open ones still lead out of
+     * themselves, so an agent pushed into a wall walks back out of it.
+     */
+    class game_flow_fields {
+    public:
+        static constexpr std::uint8_t blocked = 255;
+        static constexpr std::uint32_t unreachable = UINT32_MAX;
+        static constexpr std::uint32_t invalid_field = UINT32_MAX;
+
+        /**
+         * @brief Lay out a grid of `dimensions` tiles from `origin`, every tile costing 1.
+         * @note Drops every cached field.
+         */
+        void resize(const glm::ivec2& dimensions, float tile_size,
+                    const glm::vec2& origin = {0.0f, 0.0f});
+
+        [[nodiscard]] const glm::ivec2& get_dimensions() const noexcept;
+        [[nodiscard]] float get_tile_size() const noexcept;
+        [[nodiscard]] const glm::vec2& get_origin() const noexcept;
+
+        /**
+         * @brief Tile containing a world position, which may lie off the grid.
+         */
+        [[nodiscard]] glm::ivec2 get_tile(const glm::vec2& position) const noexcept;
+        [[nodiscard]] glm::vec2 get_tile_center(const glm::ivec2& tile) const noexcept;
+        [[nodiscard]] bool is_inside(const glm::ivec2& tile) const noexcept;
+
+        /**
+         * @brief Cost of entering a tile, from 1 for open ground up to `blocked`.
+         * @note 0 counts as 1. Cached fields catch up on the next build.
+         */
+        void set_cost(const glm::ivec2& tile, std::uint8_t cost);
+
+        /**
+         * @brief Set every tile from `min` to `max` inclusive.
+         */
+        void fill_cost(const glm::ivec2& min, const glm::ivec2& max, std::uint8_t cost);
+
+        /**
+         * @brief Cost of a tile, `blocked` off the grid.
+         */
+        [[nodiscard]] std::uint8_t get_cost(const glm::ivec2& tile) const;
+
+        /**
+         * @brief Fields kept for goals no longer requested, 16 by default.
+         * @note Fields requested since the last build are never recycled, so the cache holds as
+         *       many goals as one build needs, even past its capacity.
+         */
+        void set_capacity(std::size_t capacity);
+        [[nodiscard]] std::size_t get_capacity() const noexcept;
+
+        /**
+         * @brief The field towards `goal`, queued for the next build if it is not cached.
+         * @return Handle of the field, or `invalid_field` if the goal is off the grid or blocked.
+         *         Stays valid until the first request after the next build.
+         */
+        std::uint32_t request(const glm::ivec2& goal);
+
+        /**
+         * @brief Build the queued fields and repair the cached ones for the costs changed since
+         *        the last build, one field per task.
+         * @param workers Pool to spread fields over, or null to stay on the calling thread.
+         */
+        void build(game_workers* workers = nullptr);
+
+        /**
+         * @brief Whether a field was built, requests only become ready on the next build.
+         */
+        [[nodiscard]] bool is_ready(std::uint32_t field_index) const;
+
+        /**
+         * @brief Unit direction to step in from `position`, zero at the goal, off the grid and
+         *        where the goal cannot be reached.
+         */
+        [[nodiscard]] glm::vec2 sample(std::uint32_t field_index, const glm::vec2& position) const;
+
+        /**
+         * @brief Distance from a tile to the goal of a field, in step costs, or `unreachable`.
+         */
+        [[nodiscard]] std::uint32_t get_distance(std::uint32_t field_index,
+                                                 const glm::ivec2& tile) const;
+
+        [[nodiscard]] const glm::ivec2& get_goal(std::uint32_t field_index) const;
+
+        /**
+         * @brief Fields cached, ready or not.
+         */
+        [[nodiscard]] std::size_t get_field_count() const noexcept;
+
+        [[nodiscard]] const game_flow_stats& get_stats() const noexcept;
+
+        /**
+         * @brief Drop every cached field, keeping the costs.
+         */
+        void clear();
+
+    private:
+        struct field {
+            glm::ivec2 goal = {0, 0};
+            std::uint64_t last_request = 0;  ///< Build round the field was last asked for in.
+            bool is_ready = false;
+
+            std::vector<std::uint32_t> distances;
+            std::vector<std::uint8_t> steps;  ///< Neighbour to step to, see `step_offsets`.
+
+            // Scratch, kept for its storage.
+            std::vector<std::uint64_t> seeds;  ///< Distance and tile of where integration starts.
+            std::vector<std::vector<std::uint32_t>> buckets;
+            std::vector<std::uint32_t> reset;
+            std::size_t settled = 0;
+        };
+
+        struct build_tasks;
+
+        static void build_task(std::size_t task_index, void* user_data);
+
+        void integrate(field& target) const;
+        void repair(field& target) const;
+
+        /**
+         * @brief Settle tiles outward from the seeds until none is left open.
+         */
+        void propagate(field& target) const;
+
+        /**
+         * @brief Lower a tile to its best distance through its neighbours, seeding it if it did.
+         */
+        void relax_from_neighbors(field& target, std::uint32_t tile) const;
+
+        /**
+         * @brief Whether a step from `tile` to its neighbour `step` may be taken, which needs the
+         *        neighbour open and, diagonally, both tiles beside the step too.
+         */
+        [[nodiscard]] bool is_step_open(const glm::ivec2& tile, std::uint8_t step) const noexcept;
+
+        /**
+         * @brief Bit per step whose neighbour is on the grid, or on it and not blocked.
+         */
+        [[nodiscard]] std::uint8_t get_inside_steps(const glm::ivec2& tile) const noexcept;
+        [[nodiscard]] std::uint8_t get_open_steps(const glm::ivec2& tile) const noexcept;
+
+        [[nodiscard]] std::uint32_t get_index(const glm::ivec2& tile) const noexcept;
+        [[nodiscard]] glm::ivec2 get_tile_at(std::uint32_t index) const noexcept;
+
+        std::vector<std::uint8_t> m_costs;
+        std::vector<std::uint32_t> m_changed;  ///< Tiles whose cost changed since the last build.
+        std::vector<field> m_fields;
+        std::unordered_map<std::uint32_t, std::uint32_t> m_field_indices;  ///< By goal tile.
+        std::size_t m_capacity = 16;
+        std::uint64_t m_round = 1;
+
+        glm::ivec2 m_dimensions = {0, 0};
+        glm::vec2 m_origin = {0.0f, 0.0f};
+        float m_tile_size = 32.0f;
+        float m_inverse_tile_size = 1.0f / 32.0f;
+
+        game_flow_stats m_stats;
+    };
+
+    inline const glm::ivec2& game_flow_fields::get_dimensions() const noexcept {
+        return m_dimensions;
+    }
+
+    inline float game_flow_fields::get_tile_size() const noexcept {
+        return m_tile_size;
+    }
+
+    inline const glm::vec2& game_flow_fields::get_origin() const noexcept {
+        return m_origin;
+    }
+
+    inline glm::ivec2 game_flow_fields::get_tile(const glm::vec2& position) const noexcept {
+        return glm::ivec2(glm::floor((position - m_origin) * m_inverse_tile_size));
+    }
+
+    inline glm::vec2 game_flow_fields::get_tile_center(const glm::ivec2& tile) const noexcept {
+        return m_origin + ((glm::vec2(tile) + glm::vec2{0.5f, 0.5f}) * m_tile_size);
+    }
+
+    inline bool game_flow_fields::is_inside(const glm::ivec2& tile) const noexcept {
+        return tile.x >= 0 && tile.y >= 0 && tile.x < m_dimensions.x && tile.y < m_dimensions.y;
+    }
+
+    inline std::size_t game_flow_fields::get_capacity() const noexcept {
+        return m_capacity;
+    }
+
+    inline std::size_t game_flow_fields::get_field_count() const noexcept {
+        return m_fields.size();
+    }
+
+    inline const game_flow_stats& game_flow_fields::get_stats() const noexcept {
+        return m_stats;
+    }
+}  // namespace engine
@@ -0,0 +1,222 @@
+/**
+ * @file neighborhood.cxx
+ * @brief Counting sort neighbourhood index implementation.
+ */
+
+#include "neighborhood.hxx"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine {
+    namespace {
+        /**
+         * @brief Slots of the cells of one row around a point.
+         */
+        struct slot_range {
+            std::uint32_t begin;
+            std::uint32_t end;
+        };
+    }  // namespace
+
+    void game_neighborhood::rebuild(std::span<const glm::vec2> positions, float cell_size) {
+        if (positions.empty() == true) {
+            clear();
+            return;
+        }
+
+        glm::vec2 min = positions.front();
+        glm::vec2 max = positions.front();
+        for (const glm::vec2& position : positions) {
+            min = glm::min(min, position);
+            max = glm::max(max, position);
+        }
+
+        // Grow the cells until the bounds fit in the budget, which rounding may take a few tries.
+        const std::size_t count = positions.size();
+        const double max_cells = static_cast<double>(count * max_cells_per_point);
+        cell_size = cell_size > 0.0f ? cell_size : m_cell_size;
+        for (;;) {
+            const double columns = std::floor((max.x - min.x) / cell_size) + 1.0;
+            const double rows = std::floor((max.y - min.y) / cell_size) + 1.0;
+            if (columns * rows <= max_cells) {
+                m_dimensions = {static_cast<int>(columns), static_cast<int>(rows)};
+                break;
+            }
+            cell_size *= std::max(static_cast<float>(std::sqrt(columns * rows / max_cells)), 1.1f);
+        }
+
+        m_origin = min;
+        m_cell_size = cell_size;
+        m_inverse_cell_size = 1.0f / cell_size;
+
+        const auto cell_count = static_cast<std::size_t>(m_dimensions.x) *
+                                static_cast<std::size_t>(m_dimensions.y);
+        m_cell_starts.assign(cell_count + 1, 0);
+        m_point_cells.resize(count);
+        m_indices.resize(count);
+        m_positions.resize(count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const glm::ivec2 cell = get_cell(positions[i]);
+            const auto index = static_cast<std::uint32_t>((cell.y * m_dimensions.x) + cell.x);
+            m_point_cells[i] = index;
+            ++m_cell_starts[index];
+        }
+
+        // Running totals leave each entry at the end of its cell, and scattering from the back
+        // walks it down to the start while keeping points of a cell in input order.
+        std::uint32_t total = 0;
+        for (std::size_t cell = 0; cell < cell_count; ++cell) {
+            total += m_cell_starts[cell];
+            m_cell_starts[cell] = total;
+        }
+        m_cell_starts[cell_count] = total;
+
+        for (std::size_t i = count; i-- > 0;) {
+            const std::uint32_t slot = --m_cell_starts[m_point_cells[i]];
+            m_indices[slot] = static_cast<std::uint32_t>(i);
+            m_positions[slot] = positions[i];
+        }
+    }
+
+    void game_neighborhood::clear() {
+        m_cell_starts.clear();
+        m_indices.clear();
+        m_positions.clear();
+        m_dimensions = {0, 0};
+    }
+
+    std::size_t game_neighborhood::query(const glm::vec2& position, const float radius,
+                                         std::span<game_neighbor> out) const {
+        glm::ivec2 min;
+        glm::ivec2 max;
+        if (out.empty() == true || get_cell_span(position, radius, min, max) == false) {
+            return 0;
+        }
+
+        const float radius_squared = radius * radius;
+        std::size_t count = 0;
+        for (int y = min.y; y <= max.y; ++y) {
+            const int row = y * m_dimensions.x;
+            for (std::uint32_t slot = m_cell_starts[row + min.x];
+                 slot < m_cell_starts[row + max.x + 1]; ++slot) {
+                const glm::vec2 offset = m_positions[slot] - position;
+                const float distance_squared = glm::dot(offset, offset);
+                if (distance_squared <= radius_squared) {
+                    out[count++] = {slot, distance_squared};
+                    if (count == out.size()) {
+                        return count;
+                    }
+                }
+            }
+        }
+
+        return count;
+    }
+
+    void game_neighborhood::gather(const std::uint32_t first_slot, const std::uint32_t last_slot,
+                                   const float radius, const std::uint32_t limit,
+                                   game_neighbor_batch& batch) const {
+        batch.first_slot = first_slot;
+        batch.offsets.clear();
+        batch.offsets.push_back(0);
+        if (first_slot >= last_slot) {
+            batch.neighbors.clear();
+            return;
+        }
+
+        const float radius_squared = radius * radius;
+        const std::uint32_t kept = limit > 0 ? limit : UINT32_MAX;
+        const int reach = static_cast<int>(
+            std::clamp(std::ceil(radius * m_inverse_cell_size), 1.0f,
+                       static_cast<float>(std::max(m_dimensions.x, m_dimensions.y))));
+        std::vector<slot_range> ranges;
+        std::size_t candidates = 0;
+        std::size_t count = 0;
+
+        // Slots are in cell order, so the cell of each slot is found by walking the offsets.
+        const glm::ivec2 first_cell = get_cell(m_positions[first_slot]);
+        int cell = (first_cell.y * m_dimensions.x) + first_cell.x;
+        int ranges_cell = -1;
+
+        for (std::uint32_t slot = first_slot; slot < last_slot; ++slot) {
+            while (slot >= m_cell_starts[cell + 1]) {
+                ++cell;
+            }
+
+            // Every point of a cell is within reach of the same cells around it.
+            if (cell != ranges_cell) {
+                ranges_cell = cell;
+                ranges.clear();
+                candidates = 0;
+
+                const int x = cell % m_dimensions.x;
+                const int y = cell / m_dimensions.x;
+                const int min_x = std::max(x - reach, 0);
+                const int max_x = std::min(x + reach, m_dimensions.x - 1);
+                for (int row = std::max(y - reach, 0);
+                     row <= std::min(y + reach, m_dimensions.y - 1); ++row) {
+                    const slot_range range = {m_cell_starts[(row * m_dimensions.x) + min_x],
+                                              m_cell_starts[(row * m_dimensions.x) + max_x + 1]};
+                    ranges.push_back(range);
+                    candidates += range.end - range.begin;
+                }
+            }
+
+            // Every candidate is written and only the ones in range are kept, which saves a
+            // branch that goes either way about half the time.
+            if (count + candidates > batch.neighbors.size()) {
+                batch.neighbors.resize(std::max(batch.neighbors.size() * 2, count + candidates));
+            }
+
+            const glm::vec2 position = m_positions[slot];
+            game_neighbor* const out = batch.neighbors.data() + count;
+            std::uint32_t found = 0;
+            for (const slot_range& range : ranges) {
+                for (std::uint32_t other = range.begin; other < range.end && found < kept;
+                     ++other) {
+                    const glm::vec2 offset = m_positions[other] - position;
+                    const float distance_squared = glm::dot(offset, offset);
+                    out[found] = {other, distance_squared};
+                    found += static_cast<std::uint32_t>(distance_squared <= radius_squared) &
+                             static_cast<std::uint32_t>(other != slot);
+                }
+            }
+
+            count += found;
+            batch.offsets.push_back(static_cast<std::uint32_t>(count));
+        }
+
+        batch.neighbors.resize(count);
+    }
+
+    glm::ivec2 game_neighborhood::get_cell(const glm::vec2& position) const noexcept {
+        // Clamped as floats, a position far off the grid must not overflow the conversion.
+        const glm::vec2 cell = glm::floor((position - m_origin) * m_inverse_cell_size);
+        return {static_cast<int>(std::clamp(cell.x, 0.0f, static_cast<float>(m_dimensions.x - 1))),
+                static_cast<int>(std::clamp(cell.y, 0.0f, static_cast<float>(m_dimensions.y - 1)))};
+    }
+
+    bool game_neighborhood::get_cell_span(const glm::vec2& position, const float radius,
+                                          glm::ivec2& min, glm::ivec2& max) const noexcept {
+        if (m_indices.empty() == true) {
+            return false;
+        }
+
+        const glm::vec2 first =
+            glm::floor((position - glm::vec2{radius, radius} - m_origin) * m_inverse_cell_size);
+        const glm::vec2 last =
+            glm::floor((position + glm::vec2{radius, radius} - m_origin) * m_inverse_cell_size);
+        if (last.x < 0.0f || last.y < 0.0f || first.x >= static_cast<float>(m_dimensions.x) ||
+            first.y >= static_cast<float>(m_dimensions.y)) {
+            return false;
+        }
+
+        min = {static_cast<int>(std::max(first.x, 0.0f)),
+               static_cast<int>(std::max(first.y, 0.0f))};
+        max = {static_cast<int>(std::min(last.x, static_cast<float>(m_dimensions.x - 1))),
+               static_cast<int>(std::min(last.y, static_cast<float>(m_dimensions.y - 1)))};
+        return true;
+    }
+}  // namespace engine
@@ -0,0 +1,145 @@
+/**
+ * @file neighborhood.hxx
+ * @brief Uniform grid of points rebuilt in one counting sort, for "everything within r" queries.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace engine {
+    /**
+     * @brief One point found near another by `game_neighborhood`.
+     */
+    struct game_neighbor {
+        std::uint32_t slot = 0;  ///< Where the point sits in the index, see `get_index`.
+        float distance_squared = 0.0f;
+    };
+
+    /**
+     * @brief Neighbours of a run of consecutive slots, filled by `game_neighborhood::gather`.
+     * @note Reuse one batch across calls, its storage is kept.
+     */
+    struct game_neighbor_batch {
+        std::uint32_t first_slot = 0;
+        std::vector<std::uint32_t> offsets;  ///< Slot `first_slot + i` spans entries i to i + 1.
+        std::vector<game_neighbor> neighbors;
+
+        [[nodiscard]] std::span<const game_neighbor> get(std::uint32_t slot) const {
+            const std::uint32_t i = slot - first_slot;
+            return {neighbors.data() + offsets[i], neighbors.data() + offsets[i + 1]};
+        }
+    };
+
+    /**
+     * @brief Points bucketed into the square cells of a grid, rebuilt from scratch each time they
+     *        move.
+     *
+     * The grid spans the bounds of the points. A rebuild counts the points per cell, turns the
+     * counts into offsets and scatters the points into those offsets, so the index costs two
+     * passes over the points whatever they did since the last rebuild. Cells are laid out row by
+     * row, so the cells of one row around a point hold a single contiguous run of points and a
+     * radius of one cell is three runs. Points are referred to by slot, their place in that
+     * order, and consecutive slots share most of their runs, which `gather` walks for its
+     * batches.
+     *
+     * Cells are grown when the bounds would need more than a few cells per point, so a stray
+     * point far from the rest costs precision rather than memory.
+     */
+    class game_neighborhood {
+    public:
+        /**
+         * @brief Most cells a rebuild lays out per point.
+         */
+        static constexpr std::size_t max_cells_per_point = 4;
+
+        /**
+         * @brief Re-index `positions`, point `i` being `positions[i]`.
+         * @param cell_size Width of a cell. Queries are cheapest with a radius of about one cell.
+         * @note Positions must be finite.
+         */
+        void rebuild(std::span<const glm::vec2> positions, float cell_size);
+
+        void clear();
+
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        /**
+         * @brief Width of a cell as of the last rebuild, which may exceed the one asked for.
+         */
+        [[nodiscard]] float get_cell_size() const noexcept;
+
+        /**
+         * @brief Point at a slot, as its index in the positions last rebuilt from.
+         */
+        [[nodiscard]] std::uint32_t get_index(std::uint32_t slot) const;
+        [[nodiscard]] const glm::vec2& get_position(std::uint32_t slot) const;
+
+        /**
+         * @brief Input index of every slot, in slot order.
+         */
+        [[nodiscard]] std::span<const std::uint32_t> get_indices() const noexcept;
+
+        /**
+         * @brief Points within `radius` of `position`.
+         * @return Number of points written to `out`, the query stops once it is full.
+         */
+        std::size_t query(const glm::vec2& position, float radius,
+                          std::span<game_neighbor> out) const;
+
+        /**
+         * @brief Neighbours within `radius` of every slot from `first_slot` up to `last_slot`,
+         *        leaving out the slot itself.
+         * @param limit Most neighbours kept per slot, 0 for all. Beyond it the first found, not
+         *        the nearest, are kept, which bounds the cost of dense clumps.
+         * @note Batches over separate ranges may be gathered from several threads at once.
+         */
+        void gather(std::uint32_t first_slot, std::uint32_t last_slot, float radius,
+                    std::uint32_t limit, game_neighbor_batch& batch) const;
+
+    private:
+        /**
+         * @brief Cell containing `position`, clamped to the grid.
+         */
+        [[nodiscard]] glm::ivec2 get_cell(const glm::vec2& position) const noexcept;
+
+        /**
+         * @brief Columns and rows of the cells within `radius` of `position`.
+         * @return Whether any of them lie on the grid.
+         */
+        [[nodiscard]] bool get_cell_span(const glm::vec2& position, float radius, glm::ivec2& min,
+                                         glm::ivec2& max) const noexcept;
+
+        std::vector<std::uint32_t> m_cell_starts;  ///< Cell c spans entries c to c + 1.
+        std::vector<std::uint32_t> m_indices;
+        std::vector<glm::vec2> m_positions;
+        std::vector<std::uint32_t> m_point_cells;  ///< Scratch of `rebuild`, by input index.
+        glm::vec2 m_origin = {0.0f, 0.0f};
+        glm::ivec2 m_dimensions = {0, 0};
+        float m_cell_size = 64.0f;
+        float m_inverse_cell_size = 1.0f / 64.0f;
+    };
+
+    inline std::size_t game_neighborhood::size() const noexcept {
+        return m_indices.size();
+    }
+
+    inline float game_neighborhood::get_cell_size() const noexcept {
+        return m_cell_size;
+    }
+
+    inline std::uint32_t game_neighborhood::get_index(const std::uint32_t slot) const {
+        return m_indices[slot];
+    }
+
+    inline const glm::vec2& game_neighborhood::get_position(const std::uint32_t slot) const {
+        return m_positions[slot];
+    }
+
+    inline std::span<const std::uint32_t> game_neighborhood::get_indices() const noexcept {
+        return m_indices;
+    }
+}  // namespace engine
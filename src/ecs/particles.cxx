@@ -0,0 +1,226 @@
+/**
+ * @file particles.cxx
+ * @brief Particle pool simulation.
+ */
+
+#include "particles.hxx"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_PARTICLES_HAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define ENGINE_PARTICLES_HAS_SSE2 0
+#endif
+
+namespace engine {
+    namespace {
+        /**
+         * @brief Where a pass over a pool reads and writes, and what it applies.
+         */
+        struct particle_pass {
+            float* x;
+            float* y;
+            float* velocity_x;
+            float* velocity_y;
+            float* age;
+            const float* inverse_lifetime;
+            float* size;
+            float* red;
+            float* green;
+            float* blue;
+            float* alpha;
+
+            float tick_interval;
+            float damping;
+            glm::vec2 velocity_step;  ///< Acceleration over one tick.
+            float size_start;
+            float size_delta;
+            glm::vec4 color_start;
+            glm::vec4 color_delta;
+        };
+
+        /**
+         * @brief Step particles `first` up to `last` one at a time.
+         * @return Whether any of them expired.
+         */
+        bool step_scalar(const particle_pass& pass, const std::size_t first,
+                         const std::size_t last) {
+            bool is_any_expired = false;
+            for (std::size_t i = first; i < last; ++i) {
+                pass.age[i] += pass.tick_interval;
+                pass.velocity_x[i] = (pass.velocity_x[i] + pass.velocity_step.x) * pass.damping;
+                pass.velocity_y[i] = (pass.velocity_y[i] + pass.velocity_step.y) * pass.damping;
+                pass.x[i] += pass.velocity_x[i] * pass.tick_interval;
+                pass.y[i] += pass.velocity_y[i] * pass.tick_interval;
+
+                const float life = pass.age[i] * pass.inverse_lifetime[i];
+                is_any_expired = is_any_expired || life >= 1.0f;
+
+                const float blend = std::min(life, 1.0f);
+                pass.size[i] = pass.size_start + (pass.size_delta * blend);
+                pass.red[i] = pass.color_start.x + (pass.color_delta.x * blend);
+                pass.green[i] = pass.color_start.y + (pass.color_delta.y * blend);
+                pass.blue[i] = pass.color_start.z + (pass.color_delta.z * blend);
+                pass.alpha[i] = pass.color_start.w + (pass.color_delta.w * blend);
+            }
+
+            return is_any_expired;
+        }
+
+#if ENGINE_PARTICLES_HAS_SSE2
+        /**
+         * @brief Step whole runs of four particles, the same arithmetic as `step_scalar`.
+         * @return Index of the first particle left for the scalar pass.
+         */
+        std::size_t step_sse2(const particle_pass& pass, const std::size_t count,
+                              bool& is_any_expired) {
+            const __m128 interval = _mm_set1_ps(pass.tick_interval);
+            const __m128 damping = _mm_set1_ps(pass.damping);
+            const __m128 step_x = _mm_set1_ps(pass.velocity_step.x);
+            const __m128 step_y = _mm_set1_ps(pass.velocity_step.y);
+            const __m128 one = _mm_set1_ps(1.0f);
+
+            const __m128 size_start = _mm_set1_ps(pass.size_start);
+            const __m128 size_delta = _mm_set1_ps(pass.size_delta);
+            const __m128 red_start = _mm_set1_ps(pass.color_start.x);
+            const __m128 red_delta = _mm_set1_ps(pass.color_delta.x);
+            const __m128 green_start = _mm_set1_ps(pass.color_start.y);
+            const __m128 green_delta = _mm_set1_ps(pass.color_delta.y);
+            const __m128 blue_start = _mm_set1_ps(pass.color_start.z);
+            const __m128 blue_delta = _mm_set1_ps(pass.color_delta.z);
+            const __m128 alpha_start = _mm_set1_ps(pass.color_start.w);
+            const __m128 alpha_delta = _mm_set1_ps(pass.color_delta.w);
+
+            __m128 expired = _mm_setzero_ps();
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                const __m128 age = _mm_add_ps(_mm_loadu_ps(pass.age + i), interval);
+                _mm_storeu_ps(pass.age + i, age);
+
+                const __m128 velocity_x =
+                    _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(pass.velocity_x + i), step_x), damping);
+                const __m128 velocity_y =
+                    _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(pass.velocity_y + i), step_y), damping);
+                _mm_storeu_ps(pass.velocity_x + i, velocity_x);
+                _mm_storeu_ps(pass.velocity_y + i, velocity_y);
+                _mm_storeu_ps(pass.x + i, _mm_add_ps(_mm_loadu_ps(pass.x + i),
+                                                     _mm_mul_ps(velocity_x, interval)));
+                _mm_storeu_ps(pass.y + i, _mm_add_ps(_mm_loadu_ps(pass.y + i),
+                                                     _mm_mul_ps(velocity_y, interval)));
+
+                const __m128 life = _mm_mul_ps(age, _mm_loadu_ps(pass.inverse_lifetime + i));
+                expired = _mm_or_ps(expired, _mm_cmpge_ps(life, one));
+
+                const __m128 blend = _mm_min_ps(life, one);
+                _mm_storeu_ps(pass.size + i, _mm_add_ps(size_start, _mm_mul_ps(size_delta, blend)));
+                _mm_storeu_ps(pass.red + i, _mm_add_ps(red_start, _mm_mul_ps(red_delta, blend)));
+                _mm_storeu_ps(pass.green + i,
+                              _mm_add_ps(green_start, _mm_mul_ps(green_delta, blend)));
+                _mm_storeu_ps(pass.blue + i, _mm_add_ps(blue_start, _mm_mul_ps(blue_delta, blend)));
+                _mm_storeu_ps(pass.alpha + i,
+                              _mm_add_ps(alpha_start, _mm_mul_ps(alpha_delta, blend)));
+            }
+
+            is_any_expired = _mm_movemask_ps(expired) != 0;
+            return i;
+        }
+#endif
+    }  // namespace
+
+    void game_particle_pool::reserve(const std::size_t count) {
+        for (std::vector<float>& channel : m_channels) {
+            channel.reserve(count);
+        }
+    }
+
+    void game_particle_pool::spawn(const glm::vec2& position, const glm::vec2& velocity,
+                                   const float lifetime, const game_particle_motion& motion) {
+        get_channel(particle_channel::x).push_back(position.x);
+        get_channel(particle_channel::y).push_back(position.y);
+        get_channel(particle_channel::velocity_x).push_back(velocity.x);
+        get_channel(particle_channel::velocity_y).push_back(velocity.y);
+        get_channel(particle_channel::age).push_back(0.0f);
+        get_channel(particle_channel::inverse_lifetime)
+            .push_back(lifetime > 0.0f ? 1.0f / lifetime : 1.0f);
+        get_channel(particle_channel::size).push_back(motion.size_start);
+        get_channel(particle_channel::red).push_back(motion.color_start.x);
+        get_channel(particle_channel::green).push_back(motion.color_start.y);
+        get_channel(particle_channel::blue).push_back(motion.color_start.z);
+        get_channel(particle_channel::alpha).push_back(motion.color_start.w);
+    }
+
+    std::size_t game_particle_pool::update(const float tick_interval,
+                                           const game_particle_motion& motion) {
+        const std::size_t count = size();
+        if (count == 0) {
+            return 0;
+        }
+
+        const particle_pass pass = {
+            get_channel(particle_channel::x).data(),
+            get_channel(particle_channel::y).data(),
+            get_channel(particle_channel::velocity_x).data(),
+            get_channel(particle_channel::velocity_y).data(),
+            get_channel(particle_channel::age).data(),
+            get_channel(particle_channel::inverse_lifetime).data(),
+            get_channel(particle_channel::size).data(),
+            get_channel(particle_channel::red).data(),
+            get_channel(particle_channel::green).data(),
+            get_channel(particle_channel::blue).data(),
+            get_channel(particle_channel::alpha).data(),
+            tick_interval,
+            std::max(0.0f, 1.0f - (motion.drag * tick_interval)),
+            motion.acceleration * tick_interval,
+            motion.size_start,
+            motion.size_end - motion.size_start,
+            motion.color_start,
+            motion.color_end - motion.color_start,
+        };
+
+        bool is_any_expired = false;
+        std::size_t first = 0;
+#if ENGINE_PARTICLES_HAS_SSE2
+        first = step_sse2(pass, count, is_any_expired);
+#endif
+        if (step_scalar(pass, first, count) == true) {
+            is_any_expired = true;
+        }
+
+        return is_any_expired == true ? remove_expired() : 0;
+    }
+
+    void game_particle_pool::clear() {
+        for (std::vector<float>& channel : m_channels) {
+            channel.clear();
+        }
+    }
+
+    std::size_t game_particle_pool::remove_expired() {
+        const std::vector<float>& ages = get_channel(particle_channel::age);
+        const std::vector<float>& inverse_lifetimes =
+            get_channel(particle_channel::inverse_lifetime);
+
+        std::size_t count = size();
+        const std::size_t before = count;
+        for (std::size_t i = 0; i < count;) {
+            if (ages[i] * inverse_lifetimes[i] < 1.0f) {
+                ++i;
+                continue;
+            }
+
+            // The last particle takes the place of the expired one and is checked next.
+            --count;
+            for (std::vector<float>& channel : m_channels) {
+                channel[i] = channel[count];
+            }
+        }
+
+        for (std::vector<float>& channel : m_channels) {
+            channel.resize(count);
+        }
+
+        return before - count;
+    }
+}  // namespace engine
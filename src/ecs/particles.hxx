@@ -0,0 +1,110 @@
+/**
+ * @file particles.hxx
+ * @brief Structure-of-arrays particle pools, simulated outside the entity registry.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace engine {
+    /**
+     * @brief Values every particle has, each kept in an array of its own.
+     */
+    enum class particle_channel : std::uint8_t {
+        x,
+        y,
+        velocity_x,
+        velocity_y,
+        age,               ///< Seconds since the particle spawned.
+        inverse_lifetime,  ///< One over the seconds it lives for.
+        size,
+        red,
+        green,
+        blue,
+        alpha,
+        count,
+    };
+
+    /**
+     * @brief How the particles of a pool move and change over their life.
+     */
+    struct game_particle_motion {
+        glm::vec2 acceleration = {0.0f, 0.0f};  ///< Units per second squared, such as gravity.
+        float drag = 0.0f;                      ///< Share of the velocity lost per second.
+
+        /**
+         * @brief Size and colour at spawn and at the end of the lifetime, blended linearly in
+         *        between. Colours run from 0 to 1.
+         */
+        float size_start = 4.0f;
+        float size_end = 4.0f;
+        glm::vec4 color_start = {1.0f, 1.0f, 1.0f, 1.0f};
+        glm::vec4 color_end = {1.0f, 1.0f, 1.0f, 0.0f};
+    };
+
+    /**
+     * @brief Particles of one emitter, one array per `particle_channel`.
+     *
+     * Particles are plain values rather than entities: spawning one appends to every array, an
+     * update is a single pass over the arrays, four particles at a time where SSE2 is available,
+     * and particles past their lifetime are swapped out with the last one. Order is not kept.
+     */
+    class game_particle_pool {
+    public:
+        [[nodiscard]] std::size_t size() const noexcept;
+        [[nodiscard]] bool empty() const noexcept;
+
+        void reserve(std::size_t count);
+
+        /**
+         * @brief Add a particle at age 0, sized and coloured as `motion` starts them.
+         * @param lifetime Seconds the particle lives for, at least one tick is best.
+         */
+        void spawn(const glm::vec2& position, const glm::vec2& velocity, float lifetime,
+                   const game_particle_motion& motion);
+
+        /**
+         * @brief Age, accelerate and move every particle, then drop the ones that expired.
+         * @return Number of particles dropped.
+         */
+        std::size_t update(float tick_interval, const game_particle_motion& motion);
+
+        void clear();
+
+        [[nodiscard]] std::span<const float> get(particle_channel channel) const noexcept;
+
+    private:
+        [[nodiscard]] std::vector<float>& get_channel(particle_channel channel) noexcept;
+
+        /**
+         * @brief Swap out every expired particle.
+         */
+        std::size_t remove_expired();
+
+        std::array<std::vector<float>, static_cast<std::size_t>(particle_channel::count)>
+            m_channels;
+    };
+
+    inline std::size_t game_particle_pool::size() const noexcept {
+        return m_channels.front().size();
+    }
+
+    inline bool game_particle_pool::empty() const noexcept {
+        return m_channels.front().empty();
+    }
+
+    inline std::span<const float> game_particle_pool::get(
+        const particle_channel channel) const noexcept {
+        return m_channels[static_cast<std::size_t>(channel)];
+    }
+
+    inline std::vector<float>& game_particle_pool::get_channel(
+        const particle_channel channel) noexcept {
+        return m_channels[static_cast<std::size_t>(channel)];
+    }
+}  // namespace engine
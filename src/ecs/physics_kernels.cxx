@@ -0,0 +1,431 @@
+/**
+ * @file physics_kernels.cxx
+ * @brief Scalar, SSE2 and deterministic velocity integration kernels, and the runtime dispatch
+ *        that picks between them and the AVX2 kernel.
+ */
+
+#include "physics_kernels.hxx"
+#include "fixed_math.hxx"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_PHYSICS_HAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define ENGINE_PHYSICS_HAS_SSE2 0
+#endif
+
+namespace engine {
+    // The SIMD kernels load components as rows of floats, so pin down the layouts they rely on.
+    static_assert(offsetof(component_transform, position) == 0 &&
+                      offsetof(component_transform, rotation) == 8 &&
+                      sizeof(component_transform) >= 16,
+                  "component_transform layout changed, update the physics kernels.");
+    static_assert(offsetof(component_velocity_linear, value) == 0 &&
+                      offsetof(component_velocity_linear, max_speed) == 8 &&
+                      offsetof(component_velocity_linear, drag) == 12,
+                  "component_velocity_linear layout changed, update the physics kernels.");
+    static_assert(offsetof(component_velocity_angular, value) == 0 &&
+                      offsetof(component_velocity_angular, max_speed) == 4 &&
+                      offsetof(component_velocity_angular, drag) == 8 &&
+                      sizeof(component_velocity_angular) % sizeof(float) == 0,
+                  "component_velocity_angular layout changed, update the physics kernels.");
+    static_assert(offsetof(component_interpolation, previous_position) == 0 &&
+                      offsetof(component_interpolation, previous_rotation) == 8,
+                  "component_interpolation layout changed, update the physics kernels.");
+
+    namespace {
+        inline void store_previous(const component_transform& transform,
+                                   component_interpolation& interpolation) {
+            interpolation.previous_position = transform.position;
+            interpolation.previous_rotation = transform.rotation;
+        }
+
+        inline void step_linear(component_transform& transform,
+                                component_velocity_linear& velocity_linear,
+                                const float tick_interval) {
+            glm::vec2 velocity = velocity_linear.value;
+
+            if (velocity_linear.drag > 0.0f) {
+                const float drag_factor = 1.0f - (velocity_linear.drag * tick_interval);
+                velocity *= std::max(0.0f, drag_factor);
+                velocity_linear.value = velocity;
+            }
+
+            if (velocity_linear.max_speed > 0.0f) {
+                const float speed = glm::length(velocity);
+                if (speed > velocity_linear.max_speed) {
+                    velocity = (velocity / speed) * velocity_linear.max_speed;
+                    velocity_linear.value = velocity;
+                }
+            }
+
+            transform.position += velocity * tick_interval;
+        }
+
+        inline void wrap_rotation(float& rotation) {
+            while (rotation >= 360.0f) {
+                rotation -= 360.0f;
+            }
+
+            while (rotation < 0.0f) {
+                rotation += 360.0f;
+            }
+        }
+
+        inline void step_angular(component_transform& transform,
+                                 component_velocity_angular& angular_velocity,
+                                 const float tick_interval) {
+            float velocity = angular_velocity.value;
+
+            if (angular_velocity.drag > 0.0f) {
+                const float drag_factor = 1.0f - (angular_velocity.drag * tick_interval);
+                velocity *= std::max(0.0f, drag_factor);
+                angular_velocity.value = velocity;
+            }
+
+            if (angular_velocity.max_speed > 0.0f) {
+                if (std::abs(velocity) > angular_velocity.max_speed) {
+                    velocity = std::copysign(angular_velocity.max_speed, velocity);
+                    angular_velocity.value = velocity;
+                }
+            }
+
+            transform.rotation += velocity * tick_interval;
+            wrap_rotation(transform.rotation);
+        }
+
+        /**
+         * @brief `step_linear` in fixed point, writing velocities back in the same cases.
+         */
+        inline void step_linear_fixed(component_transform& transform,
+                                      component_velocity_linear& velocity_linear,
+                                      const game_fixed interval) {
+            game_fixed velocity_x = fixed_from_float(velocity_linear.value.x);
+            game_fixed velocity_y = fixed_from_float(velocity_linear.value.y);
+            bool is_changed = false;
+
+            if (velocity_linear.drag > 0.0f) {
+                const game_fixed factor = std::max<game_fixed>(
+                    0, fixed_one - fixed_mul(fixed_from_float(velocity_linear.drag), interval));
+                velocity_x = fixed_mul(velocity_x, factor);
+                velocity_y = fixed_mul(velocity_y, factor);
+                is_changed = true;
+            }
+
+            if (velocity_linear.max_speed > 0.0f) {
+                // The root is only taken for the bodies actually going too fast.
+                const game_fixed max_speed = fixed_from_float(velocity_linear.max_speed);
+                if (fixed_length_squared(velocity_x, velocity_y) >
+                    fixed_length_squared(max_speed, 0)) {
+                    const game_fixed speed = fixed_length(velocity_x, velocity_y);
+                    velocity_x = (velocity_x * max_speed) / speed;
+                    velocity_y = (velocity_y * max_speed) / speed;
+                    is_changed = true;
+                }
+            }
+
+            if (is_changed == true) {
+                velocity_linear.value = {fixed_to_float(velocity_x), fixed_to_float(velocity_y)};
+            }
+
+            transform.position = {
+                fixed_to_float(fixed_from_float(transform.position.x) +
+                               fixed_mul(velocity_x, interval)),
+                fixed_to_float(fixed_from_float(transform.position.y) +
+                               fixed_mul(velocity_y, interval))};
+        }
+
+        inline void step_angular_fixed(component_transform& transform,
+                                       component_velocity_angular& angular_velocity,
+                                       const game_fixed interval) {
+            constexpr game_fixed full_turn = fixed_from_int(360);
+
+            game_fixed velocity = fixed_from_float(angular_velocity.value);
+            bool is_changed = false;
+
+            if (angular_velocity.drag > 0.0f) {
+                const game_fixed factor = std::max<game_fixed>(
+                    0, fixed_one - fixed_mul(fixed_from_float(angular_velocity.drag), interval));
+                velocity = fixed_mul(velocity, factor);
+                is_changed = true;
+            }
+
+            if (angular_velocity.max_speed > 0.0f) {
+                const game_fixed max_speed = fixed_from_float(angular_velocity.max_speed);
+                if (velocity > max_speed || velocity < -max_speed) {
+                    velocity = velocity < 0 ? -max_speed : max_speed;
+                    is_changed = true;
+                }
+            }
+
+            if (is_changed == true) {
+                angular_velocity.value = fixed_to_float(velocity);
+            }
+
+            game_fixed rotation =
+                (fixed_from_float(transform.rotation) + fixed_mul(velocity, interval)) % full_turn;
+            if (rotation < 0) {
+                rotation += full_turn;
+            }
+            transform.rotation = fixed_to_float(rotation);
+        }
+
+#if ENGINE_PHYSICS_HAS_SSE2
+        inline __m128 select(const __m128 mask, const __m128 if_true, const __m128 if_false) {
+            return _mm_or_ps(_mm_and_ps(mask, if_true), _mm_andnot_ps(mask, if_false));
+        }
+
+        /**
+         * @brief Scale factor for drag, exactly `drag > 0 ? max(0, 1 - drag * dt) : 1`.
+         */
+        inline __m128 drag_factor(const __m128 drag, const __m128 interval) {
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 factor =
+                _mm_max_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(drag, interval)), zero);
+            return select(_mm_cmpgt_ps(drag, zero), factor, _mm_set1_ps(1.0f));
+        }
+
+        void integrate_sse2(const physics_body_run& run, const float tick_interval) {
+            const __m128 interval = _mm_set1_ps(tick_interval);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 full_turn = _mm_set1_ps(360.0f);
+            const __m128 sign_mask = _mm_set1_ps(-0.0f);
+
+            std::size_t i = 0;
+            for (; i + 4 <= run.count; i += 4) {
+                component_transform* transforms = run.transforms + i;
+
+                // Rows of (position.x, position.y, rotation, scale.x).
+                __m128 row0 = _mm_loadu_ps(&transforms[0].position.x);
+                __m128 row1 = _mm_loadu_ps(&transforms[1].position.x);
+                __m128 row2 = _mm_loadu_ps(&transforms[2].position.x);
+                __m128 row3 = _mm_loadu_ps(&transforms[3].position.x);
+
+                if (run.interpolations != nullptr) {
+                    component_interpolation* interpolations = run.interpolations + i;
+                    const __m128 rows[4] = {row0, row1, row2, row3};
+
+                    for (int lane = 0; lane < 4; ++lane) {
+                        _mm_storel_pi(
+                            reinterpret_cast<__m64*>(&interpolations[lane].previous_position.x),
+                            rows[lane]);
+                        _mm_store_ss(&interpolations[lane].previous_rotation,
+                                     _mm_shuffle_ps(rows[lane], rows[lane], _MM_SHUFFLE(2, 2, 2, 2)));
+                    }
+                }
+
+                _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+                __m128& position_x = row0;
+                __m128& position_y = row1;
+                __m128& rotation = row2;
+
+                if (run.linears != nullptr) {
+                    component_velocity_linear* linears = run.linears + i;
+
+                    // Rows of (value.x, value.y, max_speed, drag).
+                    __m128 velocity_x = _mm_loadu_ps(&linears[0].value.x);
+                    __m128 velocity_y = _mm_loadu_ps(&linears[1].value.x);
+                    __m128 max_speed = _mm_loadu_ps(&linears[2].value.x);
+                    __m128 drag = _mm_loadu_ps(&linears[3].value.x);
+                    _MM_TRANSPOSE4_PS(velocity_x, velocity_y, max_speed, drag);
+
+                    const __m128 factor = drag_factor(drag, interval);
+                    velocity_x = _mm_mul_ps(velocity_x, factor);
+                    velocity_y = _mm_mul_ps(velocity_y, factor);
+
+                    const __m128 speed = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(velocity_x, velocity_x),
+                                                                _mm_mul_ps(velocity_y, velocity_y)));
+                    const __m128 clamp =
+                        _mm_and_ps(_mm_cmpgt_ps(max_speed, zero), _mm_cmpgt_ps(speed, max_speed));
+                    velocity_x = select(
+                        clamp, _mm_mul_ps(_mm_div_ps(velocity_x, speed), max_speed), velocity_x);
+                    velocity_y = select(
+                        clamp, _mm_mul_ps(_mm_div_ps(velocity_y, speed), max_speed), velocity_y);
+
+                    position_x = _mm_add_ps(position_x, _mm_mul_ps(velocity_x, interval));
+                    position_y = _mm_add_ps(position_y, _mm_mul_ps(velocity_y, interval));
+
+                    _MM_TRANSPOSE4_PS(velocity_x, velocity_y, max_speed, drag);
+                    _mm_storeu_ps(&linears[0].value.x, velocity_x);
+                    _mm_storeu_ps(&linears[1].value.x, velocity_y);
+                    _mm_storeu_ps(&linears[2].value.x, max_speed);
+                    _mm_storeu_ps(&linears[3].value.x, drag);
+                }
+
+                int needs_wrap = 0;
+                if (run.angulars != nullptr) {
+                    component_velocity_angular* angulars = run.angulars + i;
+
+                    __m128 velocity = _mm_setr_ps(angulars[0].value, angulars[1].value,
+                                                  angulars[2].value, angulars[3].value);
+                    const __m128 max_speed =
+                        _mm_setr_ps(angulars[0].max_speed, angulars[1].max_speed,
+                                    angulars[2].max_speed, angulars[3].max_speed);
+                    const __m128 drag = _mm_setr_ps(angulars[0].drag, angulars[1].drag,
+                                                    angulars[2].drag, angulars[3].drag);
+
+                    velocity = _mm_mul_ps(velocity, drag_factor(drag, interval));
+
+                    const __m128 magnitude = _mm_andnot_ps(sign_mask, velocity);
+                    const __m128 clamp = _mm_and_ps(_mm_cmpgt_ps(max_speed, zero),
+                                                    _mm_cmpgt_ps(magnitude, max_speed));
+                    const __m128 clamped = _mm_or_ps(_mm_andnot_ps(sign_mask, max_speed),
+                                                     _mm_and_ps(sign_mask, velocity));
+                    velocity = select(clamp, clamped, velocity);
+
+                    rotation = _mm_add_ps(rotation, _mm_mul_ps(velocity, interval));
+
+                    // One wrap step per direction covers any tick under a full turn; lanes that
+                    // spin faster are finished by the scalar loop below.
+                    rotation = _mm_sub_ps(
+                        rotation, _mm_and_ps(_mm_cmpge_ps(rotation, full_turn), full_turn));
+                    rotation =
+                        _mm_add_ps(rotation, _mm_and_ps(_mm_cmplt_ps(rotation, zero), full_turn));
+                    needs_wrap = _mm_movemask_ps(_mm_or_ps(_mm_cmpge_ps(rotation, full_turn),
+                                                           _mm_cmplt_ps(rotation, zero)));
+
+                    alignas(16) float velocities[4];
+                    _mm_store_ps(velocities, velocity);
+                    for (int lane = 0; lane < 4; ++lane) {
+                        angulars[lane].value = velocities[lane];
+                    }
+                }
+
+                _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+                _mm_storeu_ps(&transforms[0].position.x, row0);
+                _mm_storeu_ps(&transforms[1].position.x, row1);
+                _mm_storeu_ps(&transforms[2].position.x, row2);
+                _mm_storeu_ps(&transforms[3].position.x, row3);
+
+                for (int lane = 0; needs_wrap != 0 && lane < 4; ++lane) {
+                    if ((needs_wrap & (1 << lane)) != 0) {
+                        wrap_rotation(transforms[lane].rotation);
+                    }
+                }
+            }
+
+            detail::physics_integrate_scalar(run, tick_interval, i);
+        }
+#endif
+    }  // namespace
+
+    namespace detail {
+        void physics_integrate_scalar(const physics_body_run& run, const float tick_interval,
+                                      const std::size_t first) {
+            for (std::size_t i = first; i < run.count; ++i) {
+                component_transform& transform = run.transforms[i];
+
+                if (run.interpolations != nullptr) {
+                    store_previous(transform, run.interpolations[i]);
+                }
+
+                if (run.linears != nullptr) {
+                    step_linear(transform, run.linears[i], tick_interval);
+                }
+
+                if (run.angulars != nullptr) {
+                    step_angular(transform, run.angulars[i], tick_interval);
+                }
+            }
+        }
+
+        void physics_integrate_fixed(const physics_body_run& run, const float tick_interval) {
+            const game_fixed interval = fixed_from_float(tick_interval);
+
+            for (std::size_t i = 0; i < run.count; ++i) {
+                component_transform& transform = run.transforms[i];
+
+                if (run.interpolations != nullptr) {
+                    store_previous(transform, run.interpolations[i]);
+                }
+
+                if (run.linears != nullptr) {
+                    step_linear_fixed(transform, run.linears[i], interval);
+                }
+
+                if (run.angulars != nullptr) {
+                    step_angular_fixed(transform, run.angulars[i], interval);
+                }
+            }
+        }
+    }  // namespace detail
+
+    bool physics_kernel_is_supported(const physics_kernel kernel) noexcept {
+        switch (kernel) {
+            case physics_kernel::automatic:
+            case physics_kernel::scalar:
+            case physics_kernel::deterministic:
+                return true;
+            case physics_kernel::sse2:
+                return ENGINE_PHYSICS_HAS_SSE2 && SDL_HasSSE2();
+            case physics_kernel::avx2:
+                return detail::physics_kernel_avx2_compiled() && SDL_HasAVX2();
+        }
+
+        return false;
+    }
+
+    physics_kernel physics_kernel_resolve(const physics_kernel requested) noexcept {
+        static const physics_kernel best = [] {
+            if (physics_kernel_is_supported(physics_kernel::avx2)) {
+                return physics_kernel::avx2;
+            }
+
+            if (physics_kernel_is_supported(physics_kernel::sse2)) {
+                return physics_kernel::sse2;
+            }
+
+            return physics_kernel::scalar;
+        }();
+
+        if (requested == physics_kernel::automatic ||
+            physics_kernel_is_supported(requested) == false) {
+            return best;
+        }
+
+        return requested;
+    }
+
+    std::string_view physics_kernel_name(const physics_kernel kernel) noexcept {
+        switch (kernel) {
+            case physics_kernel::automatic:
+                return "automatic";
+            case physics_kernel::scalar:
+                return "scalar";
+            case physics_kernel::sse2:
+                return "sse2";
+            case physics_kernel::avx2:
+                return "avx2";
+            case physics_kernel::deterministic:
+                return "deterministic";
+        }
+
+        return "unknown";
+    }
+
+    void physics_kernel_integrate(const physics_kernel kernel, const physics_body_run& run,
+                                  const float tick_interval) {
+        switch (kernel) {
+            case physics_kernel::avx2:
+                detail::physics_integrate_avx2(run, tick_interval);
+                return;
+            case physics_kernel::deterministic:
+                detail::physics_integrate_fixed(run, tick_interval);
+                return;
+#if ENGINE_PHYSICS_HAS_SSE2
+            case physics_kernel::sse2:
+                integrate_sse2(run, tick_interval);
+                return;
+#endif
+            default:
+                detail::physics_integrate_scalar(run, tick_interval, 0);
+                return;
+        }
+    }
+}  // namespace engine
@@ -0,0 +1,64 @@
+/**
+ * @file physics_kernels.hxx
+ * @brief Velocity integration kernels with runtime CPU dispatch.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include "components.hxx"
+
+namespace engine {
+    /**
+     * @brief Instruction set used to integrate physics bodies.
+     * @note Every kernel but `deterministic` produces bit-identical results to the scalar one.
+     *       `deterministic` steps in `game_fixed` arithmetic instead, so the same state and input
+     *       give the same bits on every compiler, flag set and CPU, at the cost of rounding
+     *       positions, velocities and rotations to 1/65536 every tick. It is never picked by
+     *       `automatic`.
+     */
+    enum class physics_kernel { automatic, scalar, sse2, avx2, deterministic };
+
+    /**
+     * @brief A run of bodies whose components sit at the same index in packed arrays.
+     * @note `linears`, `angulars` and `interpolations` may be null when the run lacks them.
+     */
+    struct physics_body_run {
+        component_transform* transforms = nullptr;
+        component_velocity_linear* linears = nullptr;
+        component_velocity_angular* angulars = nullptr;
+        component_interpolation* interpolations = nullptr;
+        std::size_t count = 0;
+    };
+
+    /**
+     * @brief Check whether a kernel was compiled in and is supported by the running CPU.
+     */
+    [[nodiscard]] bool physics_kernel_is_supported(physics_kernel kernel) noexcept;
+
+    /**
+     * @brief Resolve `automatic` (or an unsupported request) to the best kernel available.
+     */
+    [[nodiscard]] physics_kernel physics_kernel_resolve(physics_kernel requested) noexcept;
+
+    [[nodiscard]] std::string_view physics_kernel_name(physics_kernel kernel) noexcept;
+
+    /**
+     * @brief Snapshot interpolation state, then apply drag, max-speed clamp and integration to a
+     *        run of bodies.
+     * @param kernel A resolved kernel, see `physics_kernel_resolve`.
+     * @param run The bodies to integrate.
+     * @param tick_interval Seconds to integrate over.
+     */
+    void physics_kernel_integrate(physics_kernel kernel, const physics_body_run& run,
+                                  float tick_interval);
+
+    namespace detail {
+        void physics_integrate_scalar(const physics_body_run& run, float tick_interval,
+                                      std::size_t first);
+        void physics_integrate_avx2(const physics_body_run& run, float tick_interval);
+        void physics_integrate_fixed(const physics_body_run& run, float tick_interval);
+        [[nodiscard]] bool physics_kernel_avx2_compiled() noexcept;
+    }  // namespace detail
+}  // namespace engine
@@ -0,0 +1,204 @@
+/**
+ * @file physics_kernels_avx2.cxx
+ * @brief AVX2 velocity integration kernel.
+ *
+ * This translation unit is compiled with AVX2 enabled (see CMakeLists.txt) and is only ever
+ * entered after `physics_kernel_is_supported` confirmed the CPU can run it. Keep it free of
+ * inline library code shared with other translation units so no AVX2 instructions leak into
+ * functions the linker might pick for the generic paths.
+ */
+
+#include "physics_kernels.hxx"
+
+#if defined(__AVX2__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#define ENGINE_PHYSICS_HAS_AVX2 1
+#include <immintrin.h>
+#else
+#define ENGINE_PHYSICS_HAS_AVX2 0
+#endif
+
+namespace engine::detail {
+#if ENGINE_PHYSICS_HAS_AVX2
+    namespace {
+        constexpr int lanes = 8;
+
+        inline __m256 combine(const __m128 low, const __m128 high) {
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+        }
+
+        /**
+         * @brief Load the first four floats of eight consecutive components as four columns.
+         */
+        template <class Component>
+        inline void load_columns(Component* components, __m256 (&columns)[4]) {
+            __m128 rows[lanes];
+            for (int lane = 0; lane < lanes; ++lane) {
+                rows[lane] = _mm_loadu_ps(reinterpret_cast<const float*>(&components[lane]));
+            }
+
+            _MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+            _MM_TRANSPOSE4_PS(rows[4], rows[5], rows[6], rows[7]);
+
+            for (int column = 0; column < 4; ++column) {
+                columns[column] = combine(rows[column], rows[column + 4]);
+            }
+        }
+
+        template <class Component>
+        inline void store_columns(Component* components, const __m256 (&columns)[4]) {
+            __m128 rows[lanes];
+            for (int column = 0; column < 4; ++column) {
+                rows[column] = _mm256_castps256_ps128(columns[column]);
+                rows[column + 4] = _mm256_extractf128_ps(columns[column], 1);
+            }
+
+            _MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+            _MM_TRANSPOSE4_PS(rows[4], rows[5], rows[6], rows[7]);
+
+            for (int lane = 0; lane < lanes; ++lane) {
+                _mm_storeu_ps(reinterpret_cast<float*>(&components[lane]), rows[lane]);
+            }
+        }
+
+        inline __m256 drag_factor(const __m256 drag, const __m256 interval) {
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 factor =
+                _mm256_max_ps(_mm256_sub_ps(one, _mm256_mul_ps(drag, interval)), zero);
+            return _mm256_blendv_ps(one, factor, _mm256_cmp_ps(drag, zero, _CMP_GT_OQ));
+        }
+
+        inline void wrap_rotation(float& rotation) {
+            while (rotation >= 360.0f) {
+                rotation -= 360.0f;
+            }
+
+            while (rotation < 0.0f) {
+                rotation += 360.0f;
+            }
+        }
+    }  // namespace
+
+    bool physics_kernel_avx2_compiled() noexcept {
+        return true;
+    }
+
+    void physics_integrate_avx2(const physics_body_run& run, const float tick_interval) {
+        const __m256 interval = _mm256_set1_ps(tick_interval);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 full_turn = _mm256_set1_ps(360.0f);
+        const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+
+        // Float offsets of eight consecutive angular velocity components.
+        constexpr int angular_stride = sizeof(component_velocity_angular) / sizeof(float);
+        const __m256i angular_offsets =
+            _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                               _mm256_set1_epi32(angular_stride));
+
+        std::size_t i = 0;
+        for (; i + lanes <= run.count; i += lanes) {
+            component_transform* transforms = run.transforms + i;
+
+            if (run.interpolations != nullptr) {
+                component_interpolation* interpolations = run.interpolations + i;
+                for (int lane = 0; lane < lanes; ++lane) {
+                    interpolations[lane].previous_position = transforms[lane].position;
+                    interpolations[lane].previous_rotation = transforms[lane].rotation;
+                }
+            }
+
+            // Columns of (position.x, position.y, rotation, scale.x).
+            __m256 transform_columns[4];
+            load_columns(transforms, transform_columns);
+            __m256& position_x = transform_columns[0];
+            __m256& position_y = transform_columns[1];
+            __m256& rotation = transform_columns[2];
+
+            if (run.linears != nullptr) {
+                component_velocity_linear* linears = run.linears + i;
+
+                // Columns of (value.x, value.y, max_speed, drag).
+                __m256 linear_columns[4];
+                load_columns(linears, linear_columns);
+                __m256& velocity_x = linear_columns[0];
+                __m256& velocity_y = linear_columns[1];
+                const __m256 max_speed = linear_columns[2];
+
+                const __m256 factor = drag_factor(linear_columns[3], interval);
+                velocity_x = _mm256_mul_ps(velocity_x, factor);
+                velocity_y = _mm256_mul_ps(velocity_y, factor);
+
+                const __m256 speed = _mm256_sqrt_ps(_mm256_add_ps(
+                    _mm256_mul_ps(velocity_x, velocity_x), _mm256_mul_ps(velocity_y, velocity_y)));
+                const __m256 clamp = _mm256_and_ps(_mm256_cmp_ps(max_speed, zero, _CMP_GT_OQ),
+                                                   _mm256_cmp_ps(speed, max_speed, _CMP_GT_OQ));
+                velocity_x = _mm256_blendv_ps(
+                    velocity_x, _mm256_mul_ps(_mm256_div_ps(velocity_x, speed), max_speed), clamp);
+                velocity_y = _mm256_blendv_ps(
+                    velocity_y, _mm256_mul_ps(_mm256_div_ps(velocity_y, speed), max_speed), clamp);
+
+                position_x = _mm256_add_ps(position_x, _mm256_mul_ps(velocity_x, interval));
+                position_y = _mm256_add_ps(position_y, _mm256_mul_ps(velocity_y, interval));
+
+                store_columns(linears, linear_columns);
+            }
+
+            int needs_wrap = 0;
+            if (run.angulars != nullptr) {
+                component_velocity_angular* angulars = run.angulars + i;
+                const float* base = &angulars[0].value;
+
+                __m256 velocity = _mm256_i32gather_ps(base, angular_offsets, sizeof(float));
+                const __m256 max_speed =
+                    _mm256_i32gather_ps(base + 1, angular_offsets, sizeof(float));
+                const __m256 drag = _mm256_i32gather_ps(base + 2, angular_offsets, sizeof(float));
+
+                velocity = _mm256_mul_ps(velocity, drag_factor(drag, interval));
+
+                const __m256 magnitude = _mm256_andnot_ps(sign_mask, velocity);
+                const __m256 clamp = _mm256_and_ps(_mm256_cmp_ps(max_speed, zero, _CMP_GT_OQ),
+                                                   _mm256_cmp_ps(magnitude, max_speed, _CMP_GT_OQ));
+                const __m256 clamped = _mm256_or_ps(_mm256_andnot_ps(sign_mask, max_speed),
+                                                    _mm256_and_ps(sign_mask, velocity));
+                velocity = _mm256_blendv_ps(velocity, clamped, clamp);
+
+                rotation = _mm256_add_ps(rotation, _mm256_mul_ps(velocity, interval));
+
+                // One wrap step per direction, faster spinners are finished by the scalar loop.
+                rotation = _mm256_sub_ps(
+                    rotation,
+                    _mm256_and_ps(_mm256_cmp_ps(rotation, full_turn, _CMP_GE_OQ), full_turn));
+                rotation = _mm256_add_ps(
+                    rotation, _mm256_and_ps(_mm256_cmp_ps(rotation, zero, _CMP_LT_OQ), full_turn));
+                needs_wrap = _mm256_movemask_ps(
+                    _mm256_or_ps(_mm256_cmp_ps(rotation, full_turn, _CMP_GE_OQ),
+                                 _mm256_cmp_ps(rotation, zero, _CMP_LT_OQ)));
+
+                alignas(32) float velocities[lanes];
+                _mm256_store_ps(velocities, velocity);
+                for (int lane = 0; lane < lanes; ++lane) {
+                    angulars[lane].value = velocities[lane];
+                }
+            }
+
+            store_columns(transforms, transform_columns);
+
+            for (int lane = 0; needs_wrap != 0 && lane < lanes; ++lane) {
+                if ((needs_wrap & (1 << lane)) != 0) {
+                    wrap_rotation(transforms[lane].rotation);
+                }
+            }
+        }
+
+        physics_integrate_scalar(run, tick_interval, i);
+    }
+#else
+    bool physics_kernel_avx2_compiled() noexcept {
+        return false;
+    }
+
+    void physics_integrate_avx2(const physics_body_run& run, const float tick_interval) {
+        physics_integrate_scalar(run, tick_interval, 0);
+    }
+#endif
+}  // namespace engine::detail
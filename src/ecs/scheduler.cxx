@@ -0,0 +1,176 @@
+/**
+ * @file scheduler.cxx
+ * @brief System scheduler implementation.
+ */
+
+#include "scheduler.hxx"
+
+#include <algorithm>
+#include "entities.hxx"
+#include "../utils/timing.hxx"
+#include "../utils/workers.hxx"
+
+namespace engine {
+    bool game_system_access::conflicts_with(const game_system_access& other) const noexcept {
+        if (m_is_exclusive == true || other.m_is_exclusive == true) {
+            return true;
+        }
+
+        for (const component_access& mine : m_components) {
+            for (const component_access& theirs : other.m_components) {
+                if (mine.type != theirs.type) {
+                    continue;
+                }
+
+                if (mine.is_write == true || theirs.is_write == true) {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    void game_system_access::prepare(entt::registry& registry) const {
+        for (const component_access& component : m_components) {
+            component.prepare(registry);
+        }
+    }
+
+    bool game_systems::add(std::string_view name, const game_system_function function,
+                           const game_system_access& access, void* user_data) {
+        if (function == nullptr || find(name) != nullptr) {
+            return false;
+        }
+
+        m_systems.push_back({std::string(name), function, user_data, access, true, {}});
+        m_is_schedule_dirty = true;
+
+        return true;
+    }
+
+    bool game_systems::remove(std::string_view name) {
+        const auto it = std::find_if(m_systems.begin(), m_systems.end(),
+                                     [&](const system_entry& entry) { return entry.name == name; });
+        if (it == m_systems.end()) {
+            return false;
+        }
+
+        m_systems.erase(it);
+        m_is_schedule_dirty = true;
+
+        return true;
+    }
+
+    void game_systems::set_enabled(std::string_view name, const bool is_enabled) {
+        if (system_entry* entry = find(name); entry != nullptr && entry->is_enabled != is_enabled) {
+            entry->is_enabled = is_enabled;
+            m_is_schedule_dirty = true;
+        }
+    }
+
+    bool game_systems::is_enabled(std::string_view name) const {
+        const system_entry* entry = find(name);
+        return entry != nullptr && entry->is_enabled == true;
+    }
+
+    game_system_stats game_systems::get_stats(std::string_view name) const {
+        const system_entry* entry = find(name);
+        return entry != nullptr ? entry->stats : game_system_stats{};
+    }
+
+    void game_systems::update(game_entities& entities, const float tick_interval) {
+        if (m_is_schedule_dirty == true) {
+            build_schedule();
+
+            for (const std::size_t index : m_schedule) {
+                m_systems[index].access.prepare(entities.registry());
+            }
+        }
+
+        for (std::size_t wave = 0; wave + 1 < m_wave_starts.size(); ++wave) {
+            const std::size_t first = m_wave_starts[wave];
+            const std::size_t count = m_wave_starts[wave + 1] - first;
+
+            // A lone system keeps the pool free for its own parallel work.
+            if (m_workers == nullptr || count == 1) {
+                for (std::size_t i = first; i < first + count; ++i) {
+                    run_system(m_schedule[i], entities, tick_interval);
+                }
+                continue;
+            }
+
+            wave_run run{this, &entities, tick_interval, first};
+            m_workers->parallel_for(count, &run_wave_task, &run);
+        }
+    }
+
+    game_systems::system_entry* game_systems::find(std::string_view name) {
+        for (system_entry& entry : m_systems) {
+            if (entry.name == name) {
+                return &entry;
+            }
+        }
+
+        return nullptr;
+    }
+
+    const game_systems::system_entry* game_systems::find(std::string_view name) const {
+        return const_cast<game_systems*>(this)->find(name);
+    }
+
+    void game_systems::build_schedule() {
+        // Each system lands one wave after the latest earlier system it conflicts with.
+        std::vector<std::size_t> waves(m_systems.size(), 0);
+        std::size_t wave_count = 0;
+
+        for (std::size_t i = 0; i < m_systems.size(); ++i) {
+            if (m_systems[i].is_enabled == false) {
+                continue;
+            }
+
+            for (std::size_t j = 0; j < i; ++j) {
+                if (m_systems[j].is_enabled == true &&
+                    m_systems[i].access.conflicts_with(m_systems[j].access) == true) {
+                    waves[i] = std::max(waves[i], waves[j] + 1);
+                }
+            }
+
+            wave_count = std::max(wave_count, waves[i] + 1);
+        }
+
+        m_schedule.clear();
+        m_wave_starts.clear();
+
+        for (std::size_t wave = 0; wave < wave_count; ++wave) {
+            m_wave_starts.push_back(m_schedule.size());
+
+            for (std::size_t i = 0; i < m_systems.size(); ++i) {
+                if (m_systems[i].is_enabled == true && waves[i] == wave) {
+                    m_schedule.push_back(i);
+                }
+            }
+        }
+
+        m_wave_starts.push_back(m_schedule.size());
+        m_is_schedule_dirty = false;
+    }
+
+    void game_systems::run_system(const std::size_t index, game_entities& entities,
+                                  const float tick_interval) {
+        system_entry& entry = m_systems[index];
+
+        const std::uint64_t start = performance_counter_value_current();
+        entry.function(entities, tick_interval, entry.user_data);
+        entry.stats.last_seconds = performance_counter_seconds_since(start);
+
+        entry.stats.total_seconds += entry.stats.last_seconds;
+        ++entry.stats.run_count;
+    }
+
+    void game_systems::run_wave_task(const std::size_t task_index, void* user_data) {
+        auto* run = static_cast<wave_run*>(user_data);
+        run->systems->run_system(run->systems->m_schedule[run->first + task_index],
+                                 *run->entities, run->tick_interval);
+    }
+}  // namespace engine
@@ -0,0 +1,186 @@
+/**
+ * @file scheduler.hxx
+ * @brief Runs registered systems each tick, concurrently where their component access allows.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <entt/entt.hpp>
+
+namespace engine {
+    class game_entities;
+    class game_workers;
+
+    /**
+     * @brief A system run once per tick by `game_systems`.
+     */
+    using game_system_function = void (*)(game_entities& entities, float tick_interval,
+                                          void* user_data);
+
+    /**
+     * @brief The components a system reads and writes.
+     *
+     * Two systems conflict when one writes a component the other reads or writes, and conflicting
+     * systems never run at the same time. Systems that create or destroy entities or add or
+     * remove components change storages they did not declare, so they must either be `exclusive`
+     * or record those changes with the deferred calls on `game_entities`.
+     */
+    class game_system_access {
+    public:
+        template <typename... Components>
+        game_system_access& reads();
+
+        template <typename... Components>
+        game_system_access& writes();
+
+        /**
+         * @brief Never run alongside any other system.
+         */
+        game_system_access& exclusive() noexcept;
+
+        [[nodiscard]] bool conflicts_with(const game_system_access& other) const noexcept;
+
+        /**
+         * @brief Create every declared storage, so concurrent systems never add one to the
+         *        registry at the same time.
+         */
+        void prepare(entt::registry& registry) const;
+
+    private:
+        struct component_access {
+            entt::id_type type;
+            void (*prepare)(entt::registry& registry);
+            bool is_write;
+        };
+
+        template <typename Component>
+        void add(bool is_write);
+
+        template <typename Component>
+        static void prepare_storage(entt::registry& registry);
+
+    private:
+        std::vector<component_access> m_components;
+        bool m_is_exclusive = false;
+    };
+
+    /**
+     * @brief Timing of one system, in seconds.
+     */
+    struct game_system_stats {
+        double last_seconds = 0.0;
+        double total_seconds = 0.0;
+        std::uint64_t run_count = 0;
+    };
+
+    /**
+     * @brief Ordered set of systems run by `update`.
+     *
+     * Systems are scheduled in waves: each one runs after every earlier-registered system it
+     * conflicts with, and the systems of a wave run concurrently on the worker pool. Systems that
+     * do not conflict with anything before them therefore overlap, while conflicting ones keep
+     * their registration order, so results do not depend on the number of threads.
+     */
+    class game_systems {
+    public:
+        game_systems() = default;
+        ~game_systems() = default;
+
+        game_systems(const game_systems&) = delete;
+        game_systems& operator=(const game_systems&) = delete;
+        game_systems(game_systems&&) = default;
+        game_systems& operator=(game_systems&&) = default;
+
+        /**
+         * @brief Register a system after the existing ones.
+         * @return False if a system with this name already exists.
+         */
+        bool add(std::string_view name, game_system_function function,
+                 const game_system_access& access, void* user_data = nullptr);
+
+        bool remove(std::string_view name);
+
+        void set_enabled(std::string_view name, bool is_enabled);
+        [[nodiscard]] bool is_enabled(std::string_view name) const;
+
+        [[nodiscard]] game_system_stats get_stats(std::string_view name) const;
+
+        /**
+         * @brief Pool that waves run on, or null to run every system on the calling thread.
+         */
+        void set_workers(game_workers* workers) noexcept;
+
+        /**
+         * @brief Run every enabled system once and wait for all of them.
+         */
+        void update(game_entities& entities, float tick_interval);
+
+    private:
+        struct system_entry {
+            std::string name;
+            game_system_function function;
+            void* user_data;
+            game_system_access access;
+            bool is_enabled;
+            game_system_stats stats;
+        };
+
+        struct wave_run {
+            game_systems* systems;
+            game_entities* entities;
+            float tick_interval;
+            std::size_t first;
+        };
+
+        [[nodiscard]] system_entry* find(std::string_view name);
+        [[nodiscard]] const system_entry* find(std::string_view name) const;
+
+        void build_schedule();
+        void run_system(std::size_t index, game_entities& entities, float tick_interval);
+
+        static void run_wave_task(std::size_t task_index, void* user_data);
+
+    private:
+        std::vector<system_entry> m_systems;
+        std::vector<std::size_t> m_schedule;     ///< Enabled systems, grouped by wave.
+        std::vector<std::size_t> m_wave_starts;  ///< Offsets into the schedule, plus its end.
+        bool m_is_schedule_dirty = true;
+        game_workers* m_workers = nullptr;
+    };
+
+    template <typename... Components>
+    game_system_access& game_system_access::reads() {
+        (add<Components>(false), ...);
+        return *this;
+    }
+
+    template <typename... Components>
+    game_system_access& game_system_access::writes() {
+        (add<Components>(true), ...);
+        return *this;
+    }
+
+    inline game_system_access& game_system_access::exclusive() noexcept {
+        m_is_exclusive = true;
+        return *this;
+    }
+
+    template <typename Component>
+    void game_system_access::add(const bool is_write) {
+        m_components.push_back(
+            {entt::type_hash<Component>::value(), &prepare_storage<Component>, is_write});
+    }
+
+    template <typename Component>
+    void game_system_access::prepare_storage(entt::registry& registry) {
+        [[maybe_unused]] auto& storage = registry.storage<Component>();
+    }
+
+    inline void game_systems::set_workers(game_workers* workers) noexcept {
+        m_workers = workers;
+    }
+}  // namespace engine
@@ -3,160 +3,3115 @@
 #include <glm/glm.hpp>
 #include "../engine.hxx"
 #include "../utils/resources.hxx"
+#include "../utils/timers.hxx"
+#include "fixed_math.hxx"
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <vector>
 #include <cmath>
+#include <initializer_list>
+#include <limits>
+#include <map>
+#include <string>
+#include <unordered_map>
 
 namespace engine {
-    void system_physics::update(entt::registry& registry, const float tick_interval) {
-        integrate_velocity(registry, tick_interval);
-    }
+    namespace {
+        // The group walks transforms and linear velocities by packed index and the optional
+        // components by a fixed offset from it, so runs are cut at the page boundaries of each.
+        constexpr std::size_t physics_page_size =
+            entt::component_traits<component_transform>::page_size;
 
-    void system_physics::integrate_velocity(entt::registry& registry, float tick_interval) {
-        auto view = registry.view<component_transform>();
+        static_assert(entt::component_traits<component_velocity_linear>::page_size ==
+                              physics_page_size &&
+                          entt::component_traits<component_velocity_angular>::page_size ==
+                              physics_page_size &&
+                          entt::component_traits<component_interpolation>::page_size ==
+                              physics_page_size,
+                      "Physics components must share a storage page size.");
 
-        for (auto [entity, transform] : view.each()) {
-            // If interpolation component exists, store previous position and rotation for later.
-            if (auto* interpolation = registry.try_get<component_interpolation>(entity)) {
-                interpolation->previous_position = transform.position;
-                interpolation->previous_rotation = transform.rotation;
-            }
+        constexpr std::size_t physics_cache_line = 64;
+
+        /**
+         * @brief The one owning group over the physics components.
+         *
+         * entt keeps the transforms and linear velocities of awake, enabled bodies in lockstep at
+         * the front of both packed arrays. Angular velocity and interpolation are optional per
+         * body, so they stay in their own storages and `sort_physics` sorts those to follow the
+         * group. entt allows an owned storage in one owning group only, so no other owning group
+         * may include transform or linear velocity.
+         */
+        auto group_physics(entt::registry& registry) {
+            return registry.group<component_transform, component_velocity_linear>(
+                entt::get<>, entt::exclude<component_sleeping, component_disabled>);
+        }
 
-            if (auto* velocity_linear = registry.try_get<component_velocity_linear>(entity)) {
-                glm::vec2 velocity = velocity_linear->value;
+        /**
+         * @brief Interpolated entities without any velocity. A non-owning group keeps the list as
+         *        entities come and go, so the per-tick walk costs only as much as there are still
+         *        entities rather than a rejection test per interpolated body.
+         */
+        auto group_physics_still(entt::registry& registry) {
+            return registry.group(
+                entt::get<component_transform, component_interpolation>,
+                entt::exclude<component_velocity_linear, component_velocity_angular,
+                              component_disabled>);
+        }
 
-                if (velocity_linear->drag > 0.0f) {
-                    const float drag_factor = 1.0f - (velocity_linear->drag * tick_interval);
-                    velocity *= std::max(0.0f, drag_factor);
-                    velocity_linear->value = velocity;
+        /**
+         * @brief Smallest number of bodies whose components fill whole cache lines in both owned
+         *        storages, so chunks that start on a multiple of it never share a line there.
+         */
+        constexpr std::size_t physics_chunk_granule() {
+            std::size_t granule = 1;
+            for (const std::size_t size :
+                 {sizeof(component_transform), sizeof(component_velocity_linear)}) {
+                while ((granule * size) % physics_cache_line != 0) {
+                    ++granule;
                 }
+            }
+            return granule;
+        }
+
+        static_assert(physics_page_size % physics_chunk_granule() == 0,
+                      "Physics chunks must not straddle a storage page boundary.");
+
+        inline void store_previous(const component_transform& transform,
+                                   component_interpolation& interpolation) {
+            interpolation.previous_position = transform.position;
+            interpolation.previous_rotation = transform.rotation;
+        }
+
+        /**
+         * @brief Packed indices `[first, last)` of the physics group whose bodies agree on having
+         *        angular velocity and interpolation, and find them in the same order in those
+         *        storages, starting at `angular_first` and `interpolation_first`.
+         */
+        struct physics_stretch {
+            std::size_t first = 0;
+            std::size_t last = 0;
+            std::size_t angular_first = 0;
+            std::size_t interpolation_first = 0;
+            bool has_angular = false;
+            bool has_interpolation = false;
+        };
+
+        /**
+         * @brief Everything needed to integrate a slice of the grouped bodies, gathered up front
+         *        so that worker threads never touch the registry itself.
+         */
+        struct physics_pages {
+            component_transform* const* transforms;
+            component_velocity_linear* const* linears;
+            component_velocity_angular* const* angulars;
+            component_interpolation* const* interpolations;
+            const entt::entity* entities;  ///< Packed entities shared by the owned storages.
+
+            const physics_stretch* stretches;
+            std::size_t stretch_count;
+            std::size_t count;  ///< Bodies in the physics group.
+
+            physics_kernel kernel;
+            float tick_interval;
+
+            float sleep_linear_squared;
+            float sleep_angular;
+            std::uint32_t sleep_ticks;
+
+            // The thresholds again for the deterministic kernel, whose bodies rest by fixed
+            // point comparisons.
+            std::uint64_t sleep_linear_squared_fixed;
+            game_fixed sleep_angular_fixed;
 
-                if (velocity_linear->max_speed > 0.0f) {
-                    const float speed = glm::length(velocity);
-                    if (speed > velocity_linear->max_speed) {
-                        velocity = (velocity / speed) * velocity_linear->max_speed;
-                        velocity_linear->value = velocity;
+            bool is_lod_enabled;
+            std::uint64_t tick;
+            const glm::vec2* lod_focus;
+            std::size_t lod_focus_count;
+            std::array<float, 3> lod_distances_squared;
+        };
+
+        /**
+         * @brief splitmix64 finaliser, spreads every input bit over the whole hash.
+         */
+        constexpr std::uint64_t mix_hash(std::uint64_t value) {
+            value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+            value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+            return value ^ (value >> 31);
+        }
+
+        constexpr std::uint64_t combine_hash(const std::uint64_t hash, const float low,
+                                             const float high) {
+            return mix_hash(hash ^ (std::uint64_t{std::bit_cast<std::uint32_t>(low)} |
+                                    (std::uint64_t{std::bit_cast<std::uint32_t>(high)} << 32)));
+        }
+
+        /**
+         * @brief Physics bookkeeping kept in the registry context.
+         */
+        struct physics_state {
+            std::uint64_t tick = 0;
+            bool is_lod_active = false;
+            bool is_order_dirty = true;
+            std::vector<physics_stretch> stretches;
+        };
+
+        void on_physics_order_changed(entt::registry& registry,
+                                      [[maybe_unused]] entt::entity entity) {
+            registry.ctx().get<physics_state>().is_order_dirty = true;
+        }
+
+        template <typename Component>
+        void connect_physics_signals(entt::registry& registry) {
+            registry.on_construct<Component>().template connect<&on_physics_order_changed>();
+            registry.on_destroy<Component>().template connect<&on_physics_order_changed>();
+        }
+
+        /**
+         * @brief Sort the physics group so bodies with the same optional components sit together,
+         *        sort the angular velocity and interpolation storages to follow it, then record
+         *        the stretches the kernels can walk through raw pages.
+         * @note Only runs after a body joined or left the group or changed its optional
+         *       components, so a settled scene does no sparse lookups at all.
+         */
+        void sort_physics(entt::registry& registry, physics_state& state) {
+            auto group = group_physics(registry);
+            auto& angulars = registry.storage<component_velocity_angular>();
+            auto& interpolations = registry.storage<component_interpolation>();
+
+            const auto layout = [&](const entt::entity entity) {
+                return (angulars.contains(entity) ? 2 : 0) +
+                       (interpolations.contains(entity) ? 1 : 0);
+            };
+
+            group.sort([&](const entt::entity left, const entt::entity right) {
+                return layout(left) > layout(right);
+            });
+            angulars.sort_as(group.begin(), group.end());
+            interpolations.sort_as(group.begin(), group.end());
+
+            // A stretch also ends wherever a storage stops following the group one to one, so
+            // the walk stays correct whichever way the sorts lined things up.
+            state.stretches.clear();
+            const entt::entity* entities = registry.storage<component_transform>().data();
+            for (std::size_t i = 0; i < group.size(); ++i) {
+                const entt::entity entity = entities[i];
+                const bool has_angular = angulars.contains(entity);
+                const bool has_interpolation = interpolations.contains(entity);
+                const std::size_t angular_index = has_angular ? angulars.index(entity) : 0;
+                const std::size_t interpolation_index =
+                    has_interpolation ? interpolations.index(entity) : 0;
+
+                if (state.stretches.empty() == false) {
+                    physics_stretch& stretch = state.stretches.back();
+                    const std::size_t offset = i - stretch.first;
+                    if (stretch.has_angular == has_angular &&
+                        stretch.has_interpolation == has_interpolation &&
+                        (has_angular == false || angular_index == stretch.angular_first + offset) &&
+                        (has_interpolation == false ||
+                         interpolation_index == stretch.interpolation_first + offset)) {
+                        stretch.last = i + 1;
+                        continue;
                     }
                 }
 
-                transform.position += velocity * tick_interval;
+                state.stretches.push_back({i, i + 1, angular_index, interpolation_index,
+                                           has_angular, has_interpolation});
+            }
+
+            state.is_order_dirty = false;
+        }
+
+        /**
+         * @brief Count resting ticks and collect the bodies that rested long enough to sleep.
+         */
+        void detect_resting(const physics_pages& pages, const entt::entity* entities,
+                            component_velocity_linear* linears,
+                            const component_velocity_angular* angulars, const std::size_t count,
+                            std::vector<entt::entity>& sleepers) {
+            if (pages.sleep_ticks == 0) {
+                return;
+            }
+
+            const bool is_deterministic = pages.kernel == physics_kernel::deterministic;
+            for (std::size_t i = 0; i < count; ++i) {
+                const glm::vec2 velocity = linears[i].value;
+                bool is_resting = false;
+                if (is_deterministic == true) {
+                    is_resting = fixed_length_squared(fixed_from_float(velocity.x),
+                                                      fixed_from_float(velocity.y)) <=
+                                 pages.sleep_linear_squared_fixed;
+                    is_resting = is_resting && (angulars == nullptr ||
+                                                std::abs(fixed_from_float(angulars[i].value)) <=
+                                                    pages.sleep_angular_fixed);
+                } else {
+                    is_resting = glm::dot(velocity, velocity) <= pages.sleep_linear_squared;
+                    is_resting = is_resting && (angulars == nullptr ||
+                                                std::abs(angulars[i].value) <= pages.sleep_angular);
+                }
+
+                if (is_resting == false) {
+                    linears[i].resting_ticks = 0;
+                    continue;
+                }
+
+                if (++linears[i].resting_ticks >= pages.sleep_ticks) {
+                    sleepers.push_back(entities[i]);
+                }
+            }
+        }
+
+        /**
+         * @brief Pick the number of ticks until a body's next step from its distance to the
+         *        nearest focus point.
+         */
+        void assign_lod_window(const physics_pages& pages, const entt::entity entity,
+                               const component_transform& transform,
+                               component_interpolation& interpolation) {
+            float nearest_squared = std::numeric_limits<float>::max();
+            for (std::size_t i = 0; i < pages.lod_focus_count; ++i) {
+                const glm::vec2 offset = transform.position - pages.lod_focus[i];
+                nearest_squared = std::min(nearest_squared, glm::dot(offset, offset));
             }
 
-            if (auto* angular_velocity = registry.try_get<component_velocity_angular>(entity)) {
-                float velocity = angular_velocity->value;
+            std::size_t level = 0;
+            while (level < pages.lod_distances_squared.size() &&
+                   nearest_squared > pages.lod_distances_squared[level]) {
+                ++level;
+            }
+
+            // Step on the ticks where tick + index is a multiple of the rate, so consecutive
+            // entities of a bucket land on consecutive ticks. A body that just changed bucket
+            // gets a shorter window until it is back in phase.
+            const std::uint64_t mask = (std::uint64_t{1} << level) - 1;
+            const std::uint64_t phase = (pages.tick + entt::to_entity(entity)) & mask;
+            interpolation.lod_window = static_cast<std::uint8_t>(mask + 1 - phase);
+            interpolation.lod_elapsed = 0;
+        }
 
-                if (angular_velocity->drag > 0.0f) {
-                    const float drag_factor = 1.0f - (angular_velocity->drag * tick_interval);
-                    velocity *= std::max(0.0f, drag_factor);
-                    angular_velocity->value = velocity;
+        /**
+         * @brief Integrate one page run of interpolated bodies under update-rate LOD.
+         * @note Stretches of bodies stepped every tick still go through the wide kernel, the
+         *       others are stepped one at a time over the ticks they accumulated.
+         */
+        void integrate_lod_run(const physics_pages& pages, const entt::entity* entities,
+                               const physics_body_run& run, std::vector<entt::entity>& sleepers) {
+            std::size_t i = 0;
+            while (i < run.count) {
+                std::size_t end = i;
+                while (end < run.count && run.interpolations[end].lod_window == 1) {
+                    ++end;
                 }
 
-                if (angular_velocity->max_speed > 0.0f) {
-                    if (std::abs(velocity) > angular_velocity->max_speed) {
-                        velocity = std::copysign(angular_velocity->max_speed, velocity);
-                        angular_velocity->value = velocity;
+                component_velocity_angular* angulars =
+                    run.angulars == nullptr ? nullptr : run.angulars + i;
+
+                if (end > i) {
+                    physics_kernel_integrate(
+                        pages.kernel,
+                        {run.transforms + i, run.linears + i, angulars, run.interpolations + i,
+                         end - i},
+                        pages.tick_interval);
+                } else {
+                    component_interpolation& interpolation = run.interpolations[i];
+                    if (++interpolation.lod_elapsed < interpolation.lod_window) {
+                        ++i;
+                        continue;
                     }
+
+                    end = i + 1;
+                    detail::physics_integrate_scalar(
+                        {run.transforms + i, run.linears + i, angulars, &interpolation, 1},
+                        pages.tick_interval * static_cast<float>(interpolation.lod_window), 0);
                 }
 
-                transform.rotation += velocity * tick_interval;
+                detect_resting(pages, entities + i, run.linears + i, angulars, end - i,
+                               sleepers);
 
-                // Normalize rotation.
-                while (transform.rotation >= 360.0f) {
-                    transform.rotation -= 360.0f;
+                for (; i < end; ++i) {
+                    assign_lod_window(pages, entities[i], run.transforms[i],
+                                      run.interpolations[i]);
                 }
+            }
+        }
+
+        /**
+         * @brief Integrate packed indices `[first, last)` of the physics group.
+         *
+         * Each stretch is cut into runs that stay within one page of every storage it touches,
+         * and each run goes to the kernel straight from the pages.
+         */
+        void integrate_packed_range(const physics_pages& pages, const std::size_t first,
+                                    const std::size_t last, std::vector<entt::entity>& sleepers) {
+            const auto page_left = [](const std::size_t index) {
+                return physics_page_size - index % physics_page_size;
+            };
+
+            for (std::size_t index = 0; index < pages.stretch_count; ++index) {
+                const physics_stretch& stretch = pages.stretches[index];
+                const std::size_t end = std::min(last, stretch.last);
+
+                for (std::size_t i = std::max(first, stretch.first); i < end;) {
+                    const std::size_t angular_index = stretch.angular_first + (i - stretch.first);
+                    const std::size_t interpolation_index =
+                        stretch.interpolation_first + (i - stretch.first);
+
+                    std::size_t count = std::min(end - i, page_left(i));
+                    physics_body_run run = {
+                        pages.transforms[i / physics_page_size] + i % physics_page_size,
+                        pages.linears[i / physics_page_size] + i % physics_page_size};
+
+                    if (stretch.has_angular == true) {
+                        count = std::min(count, page_left(angular_index));
+                        run.angulars = pages.angulars[angular_index / physics_page_size] +
+                                       angular_index % physics_page_size;
+                    }
+                    if (stretch.has_interpolation == true) {
+                        count = std::min(count, page_left(interpolation_index));
+                        run.interpolations =
+                            pages.interpolations[interpolation_index / physics_page_size] +
+                            interpolation_index % physics_page_size;
+                    }
+                    run.count = count;
+
+                    if (stretch.has_interpolation == true && pages.is_lod_enabled == true) {
+                        integrate_lod_run(pages, pages.entities + i, run, sleepers);
+                    } else {
+                        physics_kernel_integrate(pages.kernel, run, pages.tick_interval);
+                        detect_resting(pages, pages.entities + i, run.linears, run.angulars, count,
+                                       sleepers);
+                    }
 
-                while (transform.rotation < 0.0f) {
-                    transform.rotation += 360.0f;
+                    i += count;
                 }
             }
         }
-    }
 
-    void system_renderer::update(entt::registry& registry, game_renderer* renderer,
-                                 game_resources& resources, const float fraction_to_next_tick) {
-        // TODO: Optimize all of this rubbish. Also, make the layering work.
+        struct physics_chunks {
+            const physics_pages* pages;
+            std::size_t chunk_size;
+            std::size_t count;
+            std::vector<std::vector<entt::entity>>* sleepers;  ///< One list per chunk.
+        };
 
-        // Render sprites.
-        auto resource_sprite_view =
-            registry.view<component_transform, component_renderable, component_sprite>();
-        for (auto [entity, transform, renderable, sprite_comp] : resource_sprite_view.each()) {
-            if (renderable.is_visible == false) {
-                continue;
+        void integrate_chunk(const std::size_t chunk_index, void* user_data) {
+            const auto* chunks = static_cast<const physics_chunks*>(user_data);
+            const std::size_t first = chunk_index * chunks->chunk_size;
+
+            integrate_packed_range(*chunks->pages, first,
+                                   std::min(first + chunks->chunk_size, chunks->count),
+                                   (*chunks->sleepers)[chunk_index]);
+        }
+
+        /**
+         * @brief Stop bodies dead and tag them, they stay put until something wakes them.
+         */
+        void put_to_sleep(entt::registry& registry, const std::vector<entt::entity>& sleepers) {
+            for (const entt::entity entity : sleepers) {
+                registry.get<component_velocity_linear>(entity).value = {0.0f, 0.0f};
+
+                if (auto* angular = registry.try_get<component_velocity_angular>(entity)) {
+                    angular->value = 0.0f;
+                }
+
+                // Nothing moves while asleep, so the renderer must not blend in an old position,
+                // and the body steps on the first tick after it wakes.
+                if (auto* interpolation = registry.try_get<component_interpolation>(entity)) {
+                    const auto& transform = registry.get<component_transform>(entity);
+                    *interpolation = {transform.position, transform.rotation};
+                }
+
+                registry.emplace<component_sleeping>(entity);
+            }
+        }
+
+        /**
+         * @brief Wheel keys with this bit set are scheduled callbacks, the rest are entities.
+         */
+        constexpr std::uint64_t timer_key_callback = std::uint64_t{1} << 32;
+
+        struct lifetime_timer {
+            entt::entity entity = entt::null;
+            game_entity_callback callback = nullptr;
+            void* user_data = nullptr;
+            float seconds = 0.0f;
+            std::uint64_t interval_ticks = 0;
+            std::uint32_t generation = 0;
+            bool is_repeating = false;
+            bool is_active = false;
+        };
+
+        /**
+         * @brief Per-registry state of `system_lifetime`, kept in the registry context.
+         */
+        struct lifetime_state {
+            game_timer_wheel wheel;
+            std::vector<lifetime_timer> timers;
+            std::vector<std::uint32_t> free_timers;
+            std::vector<entt::entity> pending_lifetimes;
+            std::vector<std::uint32_t> pending_timers;
+            std::vector<std::uint64_t> expired;  ///< Reused between ticks.
+            float tick_interval = 0.0f;          ///< Of the latest update.
+        };
+
+        /**
+         * @brief Whole ticks until `seconds` have passed, at least one.
+         */
+        std::uint64_t seconds_to_ticks(const float seconds, const float tick_interval) {
+            constexpr float max_ticks = 1e15f;
+            const float ticks = std::ceil(seconds / tick_interval);
+
+            // Also catches NaN from a zero or broken interval.
+            if ((ticks >= 1.0f) == false) {
+                return 1;
+            }
+
+            return static_cast<std::uint64_t>(std::min(ticks, max_ticks));
+        }
+
+        void on_lifetime_changed(entt::registry& registry, const entt::entity entity) {
+            // Unfiled until the next update, whatever expiry a replacement was copied with.
+            registry.get<component_lifetime>(entity).expiry_tick = 0;
+            registry.ctx().get<lifetime_state>().pending_lifetimes.push_back(entity);
+        }
+
+        void release_timer(lifetime_state& state, const std::uint32_t slot) {
+            lifetime_timer& timer = state.timers[slot];
+            timer.callback = nullptr;
+            timer.user_data = nullptr;
+            timer.is_active = false;
+            ++timer.generation;
+
+            state.free_timers.push_back(slot);
+        }
+
+        /**
+         * @brief Blend two rotations in degrees along the shorter way around.
+         */
+        float mix_rotation(const float previous, const float current, const float fraction) {
+            float difference = current - previous;
+            if (difference > 180.0f) {
+                difference -= 360.0f;
+            } else if (difference < -180.0f) {
+                difference += 360.0f;
+            }
+
+            return previous + (difference * fraction);
+        }
+
+        enum class render_motion : std::uint8_t { still, interpolated, attached };
+
+        /**
+         * @brief Where one entry of a render list is drawn this frame.
+         */
+        struct render_transform {
+            glm::vec2 position;
+            float rotation;
+            glm::vec2 scale;
+        };
+
+        render_transform blend_transform(const glm::vec2& previous_position,
+                                         const float previous_rotation,
+                                         const component_transform& next, const float fraction) {
+            return {glm::mix(previous_position, next.position, fraction),
+                    mix_rotation(previous_rotation, next.rotation, fraction), next.scale};
+        }
+
+        /**
+         * @brief One entity in a render list, with everything the draw loop would look up.
+         */
+        struct render_entry {
+            entt::entity entity;
+            void* resource;  ///< game_sprite or game_text_dynamic, null while the key is unknown.
+            render_motion motion;
+        };
+
+        /**
+         * @brief Dense list of drawable entities with O(1) insert and erase by entity.
+         */
+        struct render_list {
+            std::vector<render_entry> entries;
+            std::vector<std::uint32_t> slots;  ///< Entity index to entry position + 1, 0 if absent.
+            std::vector<render_transform> transforms;  ///< Rebuilt every frame, one per entry.
+
+            void erase(const std::uint32_t position) {
+                slots[entt::to_entity(entries[position].entity)] = 0;
+
+                if (position + 1 != entries.size()) {
+                    entries[position] = entries.back();
+                    slots[entt::to_entity(entries[position].entity)] = position + 1;
+                }
+
+                entries.pop_back();
+            }
+        };
+
+        /**
+         * @brief Render lists of a registry, kept in its context and fed by registry signals.
+         */
+        struct render_state {
+            render_list sprites;
+            render_list texts;
+            std::vector<entt::entity> pending;  ///< Entities changed since the last prepare.
+            std::vector<std::uint32_t> pending_slots;  ///< Entity index to pending position + 1.
+            const game_resources* resources = nullptr;
+            std::uint64_t resources_generation = 0;
+        };
+
+        /**
+         * @brief Queue `entity` for the next prepare, once per entity index.
+         * @note Registries that are never prepared keep at most one entry per index, and only the
+         *       newest version is kept as it also settles the entries of older ones.
+         */
+        void on_render_changed(entt::registry& registry, const entt::entity entity) {
+            render_state& state = registry.ctx().get<render_state>();
+
+            const std::size_t index = entt::to_entity(entity);
+            if (index >= state.pending_slots.size()) {
+                state.pending_slots.resize(index + 1, 0);
+            }
+
+            if (state.pending_slots[index] != 0) {
+                state.pending[state.pending_slots[index] - 1] = entity;
+                return;
+            }
+
+            state.pending.push_back(entity);
+            state.pending_slots[index] = static_cast<std::uint32_t>(state.pending.size());
+        }
+
+        template <typename Component, bool is_updated>
+        void connect_render_signals(entt::registry& registry) {
+            registry.on_construct<Component>().template connect<&on_render_changed>();
+            registry.on_destroy<Component>().template connect<&on_render_changed>();
+
+            if constexpr (is_updated == true) {
+                registry.on_update<Component>().template connect<&on_render_changed>();
+            }
+        }
+
+        void* resolve_resource(game_resources& resources, const component_sprite& sprite) {
+            return resources.sprite_get(sprite.resource_key);
+        }
+
+        void* resolve_resource(game_resources& resources, const component_text_dynamic& text) {
+            return resources.text_dynamic_get(text.resource_key);
+        }
+
+        render_motion get_render_motion(const entt::registry& registry, const entt::entity entity) {
+            if (registry.all_of<component_hierarchy>(entity) == true) {
+                return render_motion::attached;
+            }
+
+            if (registry.all_of<component_interpolation>(entity) == true) {
+                return render_motion::interpolated;
+            }
+
+            return render_motion::still;
+        }
+
+        /**
+         * @brief Bring the entry of one changed entity in line with its components.
+         */
+        template <typename Component>
+        void refresh_render_entry(entt::registry& registry, render_list& list,
+                                  const entt::entity entity, game_resources* resources) {
+            const std::size_t index = entt::to_entity(entity);
+            if (index >= list.slots.size()) {
+                list.slots.resize(index + 1, 0);
+            }
+
+            // An entry for another version of this index means one of the two was destroyed.
+            if (list.slots[index] != 0 && list.entries[list.slots[index] - 1].entity != entity) {
+                if (registry.valid(list.entries[list.slots[index] - 1].entity) == true) {
+                    return;
+                }
+
+                list.erase(list.slots[index] - 1);
+            }
+
+            const bool is_drawn =
+                registry.valid(entity) == true &&
+                registry.all_of<component_transform, component_renderable, Component>(entity) ==
+                    true &&
+                registry.all_of<component_disabled>(entity) == false;
+
+            if (is_drawn == false) {
+                if (list.slots[index] != 0) {
+                    list.erase(list.slots[index] - 1);
+                }
+                return;
+            }
+
+            if (list.slots[index] == 0) {
+                list.entries.push_back({entity, nullptr, render_motion::still});
+                list.slots[index] = static_cast<std::uint32_t>(list.entries.size());
+            }
+
+            render_entry& entry = list.entries[list.slots[index] - 1];
+            entry.resource = resources != nullptr
+                                 ? resolve_resource(*resources, registry.get<Component>(entity))
+                                 : nullptr;
+            entry.motion = get_render_motion(registry, entity);
+        }
+
+        /**
+         * @brief Blend every entry of `list` to the frame, in list order so that drawing reads
+         *        the results front to back.
+         */
+        void interpolate_render_list(entt::registry& registry, render_list& list,
+                                     const float fraction_to_next_tick) {
+            auto& transforms = registry.storage<component_transform>();
+            auto& interpolations = registry.storage<component_interpolation>();
+            auto& hierarchies = registry.storage<component_hierarchy>();
+
+            list.transforms.resize(list.entries.size());
+            for (std::size_t i = 0; i < list.entries.size(); ++i) {
+                const render_entry& entry = list.entries[i];
+
+                if (entry.motion == render_motion::attached) {
+                    // Attached entities draw from their cached world transform.
+                    const component_hierarchy& node = hierarchies.get(entry.entity);
+                    list.transforms[i] =
+                        blend_transform(node.previous_world.position, node.previous_world.rotation,
+                                        node.world, fraction_to_next_tick);
+                    continue;
+                }
+
+                const component_transform& transform = transforms.get(entry.entity);
+                if (entry.motion == render_motion::interpolated) {
+                    const component_interpolation& interp = interpolations.get(entry.entity);
+                    list.transforms[i] =
+                        blend_transform(interp.previous_position, interp.previous_rotation,
+                                        transform, interp.get_fraction(fraction_to_next_tick));
+                } else {
+                    list.transforms[i] = {transform.position, transform.rotation, transform.scale};
+                }
+            }
+        }
+
+        void refresh_render_lists(entt::registry& registry, render_state& state,
+                                  game_resources* resources) {
+            for (const entt::entity entity : state.pending) {
+                refresh_render_entry<component_sprite>(registry, state.sprites, entity, resources);
+                refresh_render_entry<component_text_dynamic>(registry, state.texts, entity,
+                                                             resources);
+                state.pending_slots[entt::to_entity(entity)] = 0;
+            }
+
+            state.pending.clear();
+        }
+
+        template <typename Component>
+        void resolve_render_list(entt::registry& registry, render_list& list,
+                                 game_resources& resources) {
+            for (render_entry& entry : list.entries) {
+                entry.resource = resolve_resource(resources, registry.get<Component>(entry.entity));
+            }
+        }
+
+        struct hierarchy_state {
+            bool is_order_dirty = false;
+            std::vector<std::pair<entt::entity, entt::entity>> edges;  ///< Parent and child.
+            std::vector<entt::entity> stack;
+            std::vector<entt::entity> orphans;
+        };
+
+        void on_hierarchy_changed(entt::registry& registry, [[maybe_unused]] entt::entity entity) {
+            registry.ctx().get<hierarchy_state>().is_order_dirty = true;
+        }
+
+        bool is_same_transform(const component_transform& left, const component_transform& right) {
+            return left.position == right.position && left.rotation == right.rotation &&
+                   left.scale == right.scale;
+        }
+
+        component_transform compose_transform(const component_transform& parent,
+                                              const component_transform& local,
+                                              const component_hierarchy& node) {
+            component_transform world = local;
+            glm::vec2 offset = local.position;
+
+            if (node.is_scale_inherited == true) {
+                offset *= parent.scale;
+                world.scale *= parent.scale;
+            }
+
+            if (node.is_rotation_inherited == true) {
+                const float radians = glm::radians(parent.rotation);
+                const float cosine = std::cos(radians);
+                const float sine = std::sin(radians);
+                offset = {offset.x * cosine - offset.y * sine, offset.x * sine + offset.y * cosine};
+
+                world.rotation = std::fmod(parent.rotation + local.rotation, 360.0f);
+                if (world.rotation < 0.0f) {
+                    world.rotation += 360.0f;
+                }
             }
 
-            if (auto* sprite = resources.sprite_get(sprite_comp.resource_key)) {
-                glm::vec2 render_position = transform.position;
-                float render_rotation = transform.rotation;
+            world.position = parent.position + offset;
+            return world;
+        }
+
+        /**
+         * @brief Number every attached entity depth-first and sort the storage to match.
+         */
+        void sort_hierarchy(entt::registry& registry, hierarchy_state& state) {
+            auto& nodes = registry.storage<component_hierarchy>();
+
+            state.edges.clear();
+            for (auto [entity, node] : nodes.each()) {
+                state.edges.emplace_back(node.parent, entity);
+            }
+            std::sort(state.edges.begin(), state.edges.end());
 
-                // Apply interpolation if available
-                if (auto* interp = registry.try_get<component_interpolation>(entity)) {
-                    render_position = glm::mix(interp->previous_position, transform.position,
-                                               fraction_to_next_tick);
+            std::uint32_t order = 0;
+            for (const auto& [parent, child] : state.edges) {
+                // Start a walk from every entity whose parent is not attached itself.
+                if (nodes.contains(parent) == true) {
+                    continue;
+                }
 
-                    // Interpolate rotation with wrap-around
-                    const float previous_rotation = interp->previous_rotation;
-                    const float current_rotation = transform.rotation;
+                state.stack.push_back(child);
+                while (state.stack.empty() == false) {
+                    const entt::entity current = state.stack.back();
+                    state.stack.pop_back();
+                    nodes.get(current).order = order++;
 
-                    float rotation_diff = current_rotation - previous_rotation;
-                    if (rotation_diff > 180.0f) {
-                        rotation_diff -= 360.0f;
-                    } else if (rotation_diff < -180.0f) {
-                        rotation_diff += 360.0f;
+                    const auto first =
+                        std::lower_bound(state.edges.begin(), state.edges.end(), current,
+                                         [](const auto& edge, const entt::entity value) {
+                                             return edge.first < value;
+                                         });
+                    auto last = first;
+                    while (last != state.edges.end() && last->first == current) {
+                        ++last;
                     }
 
-                    render_rotation = previous_rotation + (rotation_diff * fraction_to_next_tick);
+                    // Pushed in reverse, so siblings come out in entity order.
+                    while (last != first) {
+                        --last;
+                        state.stack.push_back(last->second);
+                    }
                 }
+            }
+
+            registry.sort<component_hierarchy>(
+                [](const component_hierarchy& left, const component_hierarchy& right) {
+                    return left.order < right.order;
+                });
+
+            state.is_order_dirty = false;
+        }
+
+        struct entity_pool {
+            std::vector<entt::entity> released;  ///< May hold entities destroyed since, skipped.
+            game_pool_stats stats;
+        };
 
-                sprite->set_rotation(render_rotation);
-                sprite->set_scale(transform.scale);
+        /**
+         * @brief Every pool of a registry, kept in its context.
+         */
+        struct pool_state {
+            std::vector<entity_pool> pools;
+            std::map<std::string, std::uint32_t, std::less<>> indices;
+        };
 
-                renderer->sprite_draw_world(sprite, render_position);
+        void note_spawned(game_pool_stats& stats) {
+            ++stats.active;
+            ++stats.spawned;
+            stats.high_water = std::max(stats.high_water, stats.active);
+        }
+
+        void on_pooled_destroyed(entt::registry& registry, const entt::entity entity) {
+            const component_pooled& pooled = registry.get<component_pooled>(entity);
+            game_pool_stats& stats = registry.ctx().get<pool_state>().pools[pooled.pool].stats;
+
+            --stats.capacity;
+            if (pooled.is_active == true) {
+                --stats.active;
             }
         }
 
-        // Render dynamic text
-        auto dynamic_text_view =
-            registry.view<component_transform, component_renderable, component_text_dynamic>();
-        for (auto [entity, transform, renderable, text_comp] : dynamic_text_view.each()) {
-            if (renderable.is_visible == false) {
-                continue;
+        /**
+         * @brief A collider as filed in one cell, with the bounds and layers the pair test needs
+         *        so that testing a cell never leaves its occupant array.
+         */
+        struct collision_entry {
+            entt::entity entity;
+            std::uint32_t layers;
+            std::uint32_t mask;
+            glm::vec2 min;
+            glm::vec2 max;
+        };
+
+        /**
+         * @brief Where one collider is filed, indexed by entity index.
+         */
+        struct collision_proxy {
+            glm::vec2 min = {0.0f, 0.0f};  ///< Filed bounds, enlarged by the grid margin.
+            glm::vec2 max = {0.0f, 0.0f};
+            glm::ivec2 cell_min = {0, 0};
+            glm::ivec2 cell_max = {0, 0};
+            bool is_filed = false;   ///< Listed in the cells from `cell_min` to `cell_max`.
+            bool is_marked = false;  ///< Waiting in `collision_state::moved`.
+        };
+
+        struct collision_cell {
+            glm::ivec2 coordinates;
+            std::vector<collision_entry> occupants;
+        };
+
+        /**
+         * @brief The spatial hash of a registry, kept in its context.
+         * @note Cells are never removed one by one, emptied ones are dropped in bulk once they
+         *       make up most of the grid.
+         */
+        struct collision_state {
+            float cell_size = 256.0f;
+            float inverse_cell_size = 1.0f / 256.0f;
+            float margin = 8.0f;
+            std::vector<collision_proxy> proxies;
+            std::unordered_map<std::uint64_t, std::uint32_t> cell_indices;
+            std::vector<collision_cell> cells;
+            std::size_t empty_cells = 0;
+            std::vector<entt::entity> moved;
+            std::vector<game_collision_pair> pairs;
+            std::vector<game_collision_contact> contacts;
+        };
+
+        constexpr std::size_t collision_compact_threshold = 1024;
+
+        /**
+         * @brief Most cells a continuous collider is swept through. Longer sweeps are teleports
+         *        rather than movement, and are left to the discrete pass.
+         */
+        constexpr std::int64_t continuous_cell_limit = 256;
+
+        std::uint64_t get_cell_key(const int x, const int y) {
+            return (std::uint64_t{static_cast<std::uint32_t>(x)} << 32) |
+                   static_cast<std::uint32_t>(y);
+        }
+
+        glm::ivec2 get_cell(const collision_state& state, const glm::vec2 position) {
+            return glm::ivec2(glm::floor(position * state.inverse_cell_size));
+        }
+
+        collision_proxy& get_collision_proxy(collision_state& state, const entt::entity entity) {
+            const auto index = static_cast<std::size_t>(entt::to_entity(entity));
+            if (index >= state.proxies.size()) {
+                state.proxies.resize(index + 1);
+            }
+
+            return state.proxies[index];
+        }
+
+        void unfile_collider(collision_state& state, const entt::entity entity,
+                             collision_proxy& proxy) {
+            if (proxy.is_filed == false) {
+                return;
             }
 
-            if (auto* text = resources.text_dynamic_get(text_comp.resource_key)) {
-                glm::vec2 render_position = transform.position;
+            for (int y = proxy.cell_min.y; y <= proxy.cell_max.y; ++y) {
+                for (int x = proxy.cell_min.x; x <= proxy.cell_max.x; ++x) {
+                    std::vector<collision_entry>& occupants =
+                        state.cells[state.cell_indices.at(get_cell_key(x, y))].occupants;
+
+                    *std::find_if(occupants.begin(), occupants.end(),
+                                  [&](const collision_entry& entry) {
+                                      return entry.entity == entity;
+                                  }) = occupants.back();
+                    occupants.pop_back();
 
-                // Apply interpolation if available
-                if (auto* interp = registry.try_get<component_interpolation>(entity)) {
-                    render_position = glm::mix(interp->previous_position, transform.position,
-                                               fraction_to_next_tick);
+                    if (occupants.empty() == true) {
+                        ++state.empty_cells;
+                    }
                 }
+            }
+
+            proxy.is_filed = false;
+        }
 
-                // Apply transform properties
-                text->set_scale(transform.scale);
-                text->set_rotation(transform.rotation);
+        void file_collider(collision_state& state, const collision_entry& entry,
+                           collision_proxy& proxy) {
+            for (int y = proxy.cell_min.y; y <= proxy.cell_max.y; ++y) {
+                for (int x = proxy.cell_min.x; x <= proxy.cell_max.x; ++x) {
+                    const auto [found, is_new] = state.cell_indices.try_emplace(
+                        get_cell_key(x, y), static_cast<std::uint32_t>(state.cells.size()));
 
-                renderer->text_draw_world(text, render_position);
+                    if (is_new == true) {
+                        state.cells.push_back({{x, y}, {}});
+                    } else if (state.cells[found->second].occupants.empty() == true) {
+                        --state.empty_cells;
+                    }
+
+                    state.cells[found->second].occupants.push_back(entry);
+                }
             }
+
+            proxy.is_filed = true;
         }
-    }
 
-    // Lifetime System Implementation
-    void system_lifetime::update(entt::registry& registry, float tick_interval) {
-        auto view = registry.view<component_lifetime>();
-        std::vector<entt::entity> entities_to_destroy;
+        glm::vec2 get_collider_extent(const component_collider& collider) {
+            return collider.shape == collider_shape::circle
+                       ? glm::vec2{collider.radius, collider.radius}
+                       : collider.half_size;
+        }
+
+        /**
+         * @brief Re-file a collider once it left its enlarged bounds, or always when `is_forced`.
+         */
+        void refresh_collider(collision_state& state, const entt::entity entity,
+                              const component_collider& collider,
+                              const component_transform& transform, const bool is_forced) {
+            collision_proxy& proxy = get_collision_proxy(state, entity);
+
+            const glm::vec2 extent = get_collider_extent(collider);
+            const glm::vec2 min = transform.position - extent;
+            const glm::vec2 max = transform.position + extent;
+
+            if (is_forced == false && proxy.is_filed == true && min.x >= proxy.min.x &&
+                min.y >= proxy.min.y && max.x <= proxy.max.x && max.y <= proxy.max.y) {
+                return;
+            }
+
+            unfile_collider(state, entity, proxy);
+
+            const glm::vec2 margin = {state.margin, state.margin};
+            proxy.min = min - margin;
+            proxy.max = max + margin;
+            proxy.cell_min = get_cell(state, proxy.min);
+            proxy.cell_max = get_cell(state, proxy.max);
+
+            file_collider(state, {entity, collider.layers, collider.mask, proxy.min, proxy.max},
+                          proxy);
+        }
+
+        void refresh_marked_collider(entt::registry& registry, collision_state& state,
+                                     const entt::entity entity) {
+            // Destroyed colliders were unfiled on the spot, their slot may already be reused.
+            if (registry.valid(entity) == false) {
+                return;
+            }
+
+            collision_proxy& proxy = get_collision_proxy(state, entity);
+            proxy.is_marked = false;
+
+            const auto* collider = registry.try_get<component_collider>(entity);
+            const auto* transform = registry.try_get<component_transform>(entity);
+            if (collider == nullptr || transform == nullptr ||
+                registry.all_of<component_disabled>(entity) == true) {
+                unfile_collider(state, entity, proxy);
+                return;
+            }
+
+            refresh_collider(state, entity, *collider, *transform, true);
+        }
+
+        /**
+         * @brief Drop emptied cells once they make up most of the grid.
+         */
+        void compact_cells(collision_state& state) {
+            if (state.empty_cells < collision_compact_threshold ||
+                state.empty_cells * 2 < state.cells.size()) {
+                return;
+            }
 
-        for (auto [entity, lifetime] : view.each()) {
-            lifetime.remaining_seconds -= tick_interval;
+            std::erase_if(state.cells,
+                          [](const collision_cell& cell) { return cell.occupants.empty(); });
 
-            if (lifetime.remaining_seconds <= 0.0f) {
-                entities_to_destroy.push_back(entity);
+            state.cell_indices.clear();
+            for (std::size_t i = 0; i < state.cells.size(); ++i) {
+                const glm::ivec2 coordinates = state.cells[i].coordinates;
+                state.cell_indices.emplace(get_cell_key(coordinates.x, coordinates.y),
+                                           static_cast<std::uint32_t>(i));
             }
+
+            state.empty_cells = 0;
+        }
+
+        /**
+         * @brief Append the candidate pairs of one cell.
+         * @note A pair sharing several cells is only reported from the first cell both are filed
+         *       in. The tests are combined without branching, since nearly every one fails.
+         */
+        void collect_cell_pairs(collision_state& state, const collision_cell& cell) {
+            const std::vector<collision_entry>& occupants = cell.occupants;
+
+            for (std::size_t i = 0; i < occupants.size(); ++i) {
+                const collision_entry& first = occupants[i];
+
+                for (std::size_t j = i + 1; j < occupants.size(); ++j) {
+                    const collision_entry& second = occupants[j];
+
+                    const bool is_candidate =
+                        ((first.layers & second.mask) != 0) & ((second.layers & first.mask) != 0) &
+                        (first.max.x >= second.min.x) & (second.max.x >= first.min.x) &
+                        (first.max.y >= second.min.y) & (second.max.y >= first.min.y);
+
+                    if (is_candidate == true &&
+                        get_cell(state, glm::max(first.min, second.min)) == cell.coordinates) {
+                        state.pairs.push_back({first.entity, second.entity});
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Unit vector along `value`, or along `fallback` when `value` is too short to tell.
+         */
+        glm::vec2 get_direction(const glm::vec2& value, const glm::vec2& fallback) {
+            constexpr float epsilon = std::numeric_limits<float>::epsilon();
+
+            if (const float length = glm::length(value); length > epsilon) {
+                return value / length;
+            }
+
+            if (const float length = glm::length(fallback); length > epsilon) {
+                return fallback / length;
+            }
+
+            return {0.0f, 1.0f};
         }
 
-        // Destroy expired entities.
-        for (auto entity : entities_to_destroy) {
-            registry.destroy(entity);
+        /**
+         * @brief Time of impact of a point moving from `origin` by `motion` with a circle.
+         * @note A point that starts inside touches at time 0.
+         */
+        bool sweep_circle(const glm::vec2& origin, const glm::vec2& motion,
+                          const glm::vec2& center, const float radius, float& time,
+                          glm::vec2& normal) {
+            const glm::vec2 offset = origin - center;
+            const float outside = glm::dot(offset, offset) - (radius * radius);
+            if (outside <= 0.0f) {
+                time = 0.0f;
+                normal = get_direction(offset, -motion);
+                return true;
+            }
+
+            const float approach = glm::dot(offset, motion);
+            if (approach >= 0.0f) {
+                return false;
+            }
+
+            const float speed = glm::dot(motion, motion);
+            const float discriminant = (approach * approach) - (speed * outside);
+            if (discriminant < 0.0f) {
+                return false;
+            }
+
+            const float hit = (-approach - std::sqrt(discriminant)) / speed;
+            if (hit > 1.0f) {
+                return false;
+            }
+
+            time = hit;
+            normal = get_direction(offset + (motion * hit), -motion);
+            return true;
         }
+
+        /**
+         * @brief Time of impact of a point moving from `origin` by `motion` with a box.
+         */
+        bool sweep_box(const glm::vec2& origin, const glm::vec2& motion, const glm::vec2& center,
+                       const glm::vec2& half_size, float& time, glm::vec2& normal) {
+            const glm::vec2 min = center - half_size;
+            const glm::vec2 max = center + half_size;
+            float enter = 0.0f;
+            float exit = 1.0f;
+            glm::vec2 face = {0.0f, 0.0f};
+
+            for (int axis = 0; axis < 2; ++axis) {
+                if (std::abs(motion[axis]) < std::numeric_limits<float>::epsilon()) {
+                    if (origin[axis] < min[axis] || origin[axis] > max[axis]) {
+                        return false;
+                    }
+                    continue;
+                }
+
+                const float inverse = 1.0f / motion[axis];
+                float near = (min[axis] - origin[axis]) * inverse;
+                float far = (max[axis] - origin[axis]) * inverse;
+                float side = -1.0f;
+                if (near > far) {
+                    std::swap(near, far);
+                    side = 1.0f;
+                }
+
+                if (near > enter) {
+                    enter = near;
+                    face = {0.0f, 0.0f};
+                    face[axis] = side;
+                }
+
+                exit = std::min(exit, far);
+                if (enter > exit) {
+                    return false;
+                }
+            }
+
+            time = enter;
+            normal = (face.x != 0.0f || face.y != 0.0f) ? face
+                                                        : get_direction(origin - center, -motion);
+            return true;
+        }
+
+        /**
+         * @brief Time of impact of a point moving from `origin` by `motion` with a box whose
+         *        corners are rounded by `radius`, which is a circle and a box swept against each
+         *        other.
+         */
+        bool sweep_rounded_box(const glm::vec2& origin, const glm::vec2& motion,
+                               const glm::vec2& center, const glm::vec2& half_size,
+                               const float radius, float& time, glm::vec2& normal) {
+            if (sweep_box(origin, motion, center, half_size + glm::vec2{radius, radius}, time,
+                          normal) == false) {
+                return false;
+            }
+
+            // Only a point entering next to a corner can still miss the rounding.
+            const glm::vec2 local = origin + (motion * time) - center;
+            if (std::abs(local.x) <= half_size.x || std::abs(local.y) <= half_size.y) {
+                return true;
+            }
+
+            const glm::vec2 corner = {local.x < 0.0f ? -half_size.x : half_size.x,
+                                      local.y < 0.0f ? -half_size.y : half_size.y};
+            return sweep_circle(origin, motion, center + corner, radius, time, normal);
+        }
+
+        /**
+         * @brief Time of impact of `mover` moving from `origin` by `motion` with `other` resting
+         *        at `center`, as a point swept against both shapes combined.
+         */
+        bool sweep_colliders(const component_collider& mover, const component_collider& other,
+                             const glm::vec2& origin, const glm::vec2& motion,
+                             const glm::vec2& center, float& time, glm::vec2& normal) {
+            const bool is_mover_circle = mover.shape == collider_shape::circle;
+            const bool is_other_circle = other.shape == collider_shape::circle;
+
+            if (is_mover_circle == true && is_other_circle == true) {
+                return sweep_circle(origin, motion, center, mover.radius + other.radius, time,
+                                    normal);
+            }
+
+            if (is_mover_circle == false && is_other_circle == false) {
+                return sweep_box(origin, motion, center, mover.half_size + other.half_size, time,
+                                 normal);
+            }
+
+            return sweep_rounded_box(origin, motion, center,
+                                     is_mover_circle == true ? other.half_size : mover.half_size,
+                                     is_mover_circle == true ? mover.radius : other.radius, time,
+                                     normal);
+        }
+
+        /**
+         * @brief Sweep one continuous collider through the cells along its path and record the
+         *        earliest contact.
+         */
+        void sweep_continuous_collider(entt::registry& registry, collision_state& state,
+                                       const entt::entity entity,
+                                       const component_collider& collider,
+                                       const glm::vec2& origin, const glm::vec2& destination) {
+            const glm::vec2 motion = destination - origin;
+            if (motion.x == 0.0f && motion.y == 0.0f) {
+                return;
+            }
+
+            const glm::vec2 extent = get_collider_extent(collider);
+            const glm::vec2 swept_min = glm::min(origin, destination) - extent;
+            const glm::vec2 swept_max = glm::max(origin, destination) + extent;
+            const glm::ivec2 cell_min = get_cell(state, swept_min);
+            const glm::ivec2 cell_max = get_cell(state, swept_max);
+
+            const std::int64_t cell_count = std::int64_t{cell_max.x - cell_min.x + 1} *
+                                            std::int64_t{cell_max.y - cell_min.y + 1};
+            if (cell_count > continuous_cell_limit) {
+                return;
+            }
+
+            const auto& colliders = registry.storage<component_collider>();
+            const auto& transforms = registry.storage<component_transform>();
+            game_collision_contact contact = {entity, entt::null, 1.0f};
+
+            for (int y = cell_min.y; y <= cell_max.y; ++y) {
+                for (int x = cell_min.x; x <= cell_max.x; ++x) {
+                    const auto found = state.cell_indices.find(get_cell_key(x, y));
+                    if (found == state.cell_indices.end()) {
+                        continue;
+                    }
+
+                    for (const collision_entry& entry : state.cells[found->second].occupants) {
+                        const bool is_candidate =
+                            entry.entity != entity && (collider.layers & entry.mask) != 0 &&
+                            (entry.layers & collider.mask) != 0 && entry.max.x >= swept_min.x &&
+                            swept_max.x >= entry.min.x && entry.max.y >= swept_min.y &&
+                            swept_max.y >= entry.min.y;
+                        if (is_candidate == false) {
+                            continue;
+                        }
+
+                        float time = 0.0f;
+                        glm::vec2 normal = {0.0f, 0.0f};
+                        if (sweep_colliders(collider, colliders.get(entry.entity), origin, motion,
+                                            transforms.get(entry.entity).position, time,
+                                            normal) == true &&
+                            (contact.second == entt::null || time < contact.time)) {
+                            contact.second = entry.entity;
+                            contact.time = time;
+                            contact.normal = normal;
+                        }
+                    }
+                }
+            }
+
+            if (contact.second != entt::null) {
+                contact.position = origin + (motion * contact.time);
+                state.contacts.push_back(contact);
+            }
+        }
+
+        void on_collider_changed(entt::registry& registry, const entt::entity entity) {
+            system_collision::mark_moved(registry, entity);
+        }
+
+        void on_collider_disabled(entt::registry& registry, const entt::entity entity) {
+            if (registry.all_of<component_collider>(entity) == true) {
+                system_collision::mark_moved(registry, entity);
+            }
+        }
+
+        void on_collider_destroyed(entt::registry& registry, const entt::entity entity) {
+            collision_state& state = registry.ctx().get<collision_state>();
+            collision_proxy& proxy = get_collision_proxy(state, entity);
+
+            unfile_collider(state, entity, proxy);
+            proxy = {};
+        }
+
+        /**
+         * @brief The tile grid of a registry, kept in its context.
+         */
+        struct tile_state {
+            game_tile_grid grid;
+            std::uint32_t layers = 1;
+            std::vector<entt::entity> blocked;
+        };
+
+        /**
+         * @brief Exact contact between two colliders, the normal pointing from `first` to
+         *        `second`.
+         * @return False when they do not touch.
+         */
+        bool collide_colliders(const component_collider& first, const glm::vec2& first_center,
+                               const component_collider& second, const glm::vec2& second_center,
+                               glm::vec2& normal, glm::vec2& position, float& penetration) {
+            const glm::vec2 offset = second_center - first_center;
+            const bool is_first_circle = first.shape == collider_shape::circle;
+            const bool is_second_circle = second.shape == collider_shape::circle;
+
+            if (is_first_circle == true && is_second_circle == true) {
+                const float reach = first.radius + second.radius;
+                const float distance_squared = glm::dot(offset, offset);
+                if (distance_squared > reach * reach) {
+                    return false;
+                }
+
+                normal = get_direction(offset, {0.0f, 1.0f});
+                penetration = reach - std::sqrt(distance_squared);
+                position = first_center + (normal * (first.radius - (penetration * 0.5f)));
+                return true;
+            }
+
+            if (is_first_circle == false && is_second_circle == false) {
+                const glm::vec2 overlap = first.half_size + second.half_size - glm::abs(offset);
+                if (overlap.x < 0.0f || overlap.y < 0.0f) {
+                    return false;
+                }
+
+                const int axis = overlap.x < overlap.y ? 0 : 1;
+                normal = {0.0f, 0.0f};
+                normal[axis] = offset[axis] < 0.0f ? -1.0f : 1.0f;
+                penetration = overlap[axis];
+                position = (glm::max(first_center - first.half_size,
+                                     second_center - second.half_size) +
+                            glm::min(first_center + first.half_size,
+                                     second_center + second.half_size)) *
+                           0.5f;
+                return true;
+            }
+
+            // A circle and a box touch at the point of the box closest to the circle's centre.
+            const component_collider& circle = is_first_circle == true ? first : second;
+            const component_collider& box = is_first_circle == true ? second : first;
+            const glm::vec2 box_center = is_first_circle == true ? second_center : first_center;
+            const glm::vec2 local = (is_first_circle == true ? first_center : second_center) -
+                                    box_center;
+            glm::vec2 closest = glm::clamp(local, -box.half_size, box.half_size);
+            glm::vec2 outward = {0.0f, 0.0f};  // from the box towards the circle
+
+            if (closest == local) {
+                // The centre is inside, so the circle leaves through the nearest face.
+                const glm::vec2 gap = box.half_size - glm::abs(local);
+                const int axis = gap.x < gap.y ? 0 : 1;
+                outward[axis] = local[axis] < 0.0f ? -1.0f : 1.0f;
+                closest[axis] = outward[axis] * box.half_size[axis];
+                penetration = gap[axis] + circle.radius;
+            } else {
+                const glm::vec2 gap = local - closest;
+                const float distance_squared = glm::dot(gap, gap);
+                if (distance_squared > circle.radius * circle.radius) {
+                    return false;
+                }
+
+                const float distance = std::sqrt(distance_squared);
+                outward = gap / distance;
+                penetration = circle.radius - distance;
+            }
+
+            normal = is_first_circle == true ? -outward : outward;
+            position = box_center + closest;
+            return true;
+        }
+
+        constexpr std::uint32_t no_solver_body = UINT32_MAX;
+
+        /**
+         * @brief The contact solver of a registry and the buffers each update refills, kept in
+         *        its context.
+         */
+        struct solver_state {
+            game_contact_solver solver;
+            std::vector<game_solver_body> bodies;   ///< Index 0 stands for every immovable one.
+            std::vector<entt::entity> entities;     ///< Entity of each body.
+            std::vector<std::uint8_t> is_sleeping;  ///< Of each body.
+            std::vector<std::uint32_t> slots;       ///< Body of each entity index, while updating.
+            std::vector<game_solver_contact> contacts;
+            std::vector<std::uint32_t> islands;  ///< Island of each body.
+            std::vector<std::uint8_t> is_island_awake;
+            std::vector<std::uint32_t> island_resting;  ///< Fewest resting ticks of each island.
+            game_solver_stats stats;
+        };
+
+        /**
+         * @brief Body index of `entity` in this update, 0 for immovable ones.
+         */
+        std::uint32_t get_solver_body(entt::registry& registry, solver_state& state,
+                                      const entt::entity entity) {
+            const auto index = static_cast<std::size_t>(entt::to_entity(entity));
+            if (index >= state.slots.size()) {
+                state.slots.resize(index + 1, no_solver_body);
+            }
+
+            if (state.slots[index] != no_solver_body) {
+                return state.slots[index];
+            }
+
+            const auto* body = registry.try_get<component_body>(entity);
+            const auto* linear = registry.try_get<component_velocity_linear>(entity);
+            if (body == nullptr || linear == nullptr) {
+                return 0;
+            }
+
+            // Without an angular velocity there is nothing to spin.
+            const auto* angular = registry.try_get<component_velocity_angular>(entity);
+            const game_solver_body solver_body = {
+                linear->value, angular != nullptr ? glm::radians(angular->value) : 0.0f,
+                body->inverse_mass, angular != nullptr ? body->inverse_inertia : 0.0f};
+            if (solver_body.is_static() == true) {
+                return 0;
+            }
+
+            state.slots[index] = static_cast<std::uint32_t>(state.bodies.size());
+            state.bodies.push_back(solver_body);
+            state.entities.push_back(entity);
+            state.is_sleeping.push_back(registry.all_of<component_sleeping>(entity) == true ? 1
+                                                                                           : 0);
+
+            return state.slots[index];
+        }
+
+        /**
+         * @brief Test the broadphase pairs exactly and collect the touching ones with a body.
+         */
+        void collect_solver_contacts(entt::registry& registry, solver_state& state) {
+            const auto& colliders = registry.storage<component_collider>();
+            const auto& transforms = registry.storage<component_transform>();
+            constexpr component_body immovable = {0.0f, 0.0f};
+
+            for (const game_collision_pair& pair : system_collision::get_pairs(registry)) {
+                // Order each pair the same way every tick, so its key and normal carry over.
+                entt::entity first = pair.first;
+                entt::entity second = pair.second;
+                if (entt::to_integral(first) > entt::to_integral(second)) {
+                    std::swap(first, second);
+                }
+
+                // Pairs are as of the last collision update, and may have been destroyed since.
+                if (colliders.contains(first) == false || colliders.contains(second) == false ||
+                    transforms.contains(first) == false || transforms.contains(second) == false) {
+                    continue;
+                }
+
+                const glm::vec2 first_center = transforms.get(first).position;
+                const glm::vec2 second_center = transforms.get(second).position;
+                glm::vec2 normal = {0.0f, 0.0f};
+                glm::vec2 position = {0.0f, 0.0f};
+                float penetration = 0.0f;
+                if (collide_colliders(colliders.get(first), first_center, colliders.get(second),
+                                      second_center, normal, position, penetration) == false) {
+                    continue;
+                }
+
+                const std::uint32_t first_body = get_solver_body(registry, state, first);
+                const std::uint32_t second_body = get_solver_body(registry, state, second);
+                if (first_body == 0 && second_body == 0) {
+                    continue;
+                }
+
+                const auto* first_material = registry.try_get<component_body>(first);
+                const auto* second_material = registry.try_get<component_body>(second);
+                if (first_material == nullptr) {
+                    first_material = &immovable;
+                }
+                if (second_material == nullptr) {
+                    second_material = &immovable;
+                }
+
+                state.contacts.push_back(
+                    {(std::uint64_t{entt::to_integral(first)} << 32) | entt::to_integral(second),
+                     first_body, second_body, normal, position - first_center,
+                     position - second_center, penetration,
+                     std::sqrt(first_material->friction * second_material->friction),
+                     std::max(first_material->restitution, second_material->restitution)});
+            }
+
+            for (std::size_t i = 1; i < state.entities.size(); ++i) {
+                state.slots[static_cast<std::size_t>(entt::to_entity(state.entities[i]))] =
+                    no_solver_body;
+            }
+        }
+
+        /**
+         * @brief Wake the sleepers of islands with an awake body, and drop the contacts of
+         *        islands where everything sleeps.
+         */
+        void wake_solver_islands(entt::registry& registry, solver_state& state,
+                                 const std::uint32_t island_count) {
+            state.is_island_awake.assign(island_count, 0);
+            for (std::size_t i = 1; i < state.bodies.size(); ++i) {
+                if (state.is_sleeping[i] == 0) {
+                    state.is_island_awake[state.islands[i]] = 1;
+                }
+            }
+
+            for (std::size_t i = 1; i < state.bodies.size(); ++i) {
+                if (state.is_sleeping[i] == 1 && state.is_island_awake[state.islands[i]] == 1) {
+                    registry.remove<component_sleeping>(state.entities[i]);
+                    registry.get<component_velocity_linear>(state.entities[i]).resting_ticks = 0;
+                    state.is_sleeping[i] = 0;
+                    ++state.stats.woken;
+                }
+            }
+
+            std::erase_if(state.contacts, [&](const game_solver_contact& contact) {
+                const std::uint32_t body = contact.first != 0 ? contact.first : contact.second;
+                return state.is_island_awake[state.islands[body]] == 0;
+            });
+        }
+
+        /**
+         * @brief Write the solved velocities back, and let every island rest as long as its
+         *        busiest body so that it falls asleep as one.
+         */
+        void store_solver_bodies(entt::registry& registry, solver_state& state,
+                                 const std::uint32_t island_count) {
+            state.island_resting.assign(island_count, UINT32_MAX);
+
+            for (std::size_t i = 1; i < state.bodies.size(); ++i) {
+                if (state.is_sleeping[i] == 1) {
+                    continue;
+                }
+
+                auto& linear = registry.get<component_velocity_linear>(state.entities[i]);
+                linear.value = state.bodies[i].linear_velocity;
+                auto* angular = registry.try_get<component_velocity_angular>(state.entities[i]);
+                if (angular != nullptr) {
+                    angular->value = glm::degrees(state.bodies[i].angular_velocity);
+                }
+
+                std::uint32_t& resting = state.island_resting[state.islands[i]];
+                resting = std::min(resting, linear.resting_ticks);
+            }
+
+            for (std::size_t i = 1; i < state.bodies.size(); ++i) {
+                if (state.is_sleeping[i] == 0) {
+                    registry.get<component_velocity_linear>(state.entities[i]).resting_ticks =
+                        state.island_resting[state.islands[i]];
+                }
+            }
+        }
+
+        enum class spatial_extent : std::uint8_t { point, sprite, collider };
+
+        /**
+         * @brief Where one entity is filed in the spatial tree, indexed by entity index.
+         */
+        struct spatial_proxy {
+            glm::vec2 offset = {0.0f, 0.0f};  ///< Top left corner relative to the position.
+            glm::vec2 size = {0.0f, 0.0f};
+            std::int32_t leaf = game_aabb_tree::null_node;
+            spatial_extent extent = spatial_extent::point;
+
+            /**
+             * @brief The entity waiting in `spatial_state::moved`, with its version. A destroyed
+             *        entity can be marked by its other components after its slot was reset, and
+             *        must not hide a new entity reusing the slot.
+             */
+            entt::entity marked = entt::null;
+        };
+
+        /**
+         * @brief The spatial tree of a registry, kept in its context.
+         */
+        struct spatial_state {
+            game_aabb_tree tree;
+            std::vector<spatial_proxy> proxies;
+            std::vector<entt::entity> moved;
+            game_resources* resources = nullptr;
+            std::uint64_t resources_generation = 0;
+        };
+
+        spatial_proxy& get_spatial_proxy(spatial_state& state, const entt::entity entity) {
+            const auto index = static_cast<std::size_t>(entt::to_entity(entity));
+            if (index >= state.proxies.size()) {
+                state.proxies.resize(index + 1);
+            }
+
+            return state.proxies[index];
+        }
+
+        void unfile_spatial(spatial_state& state, spatial_proxy& proxy) {
+            if (proxy.leaf != game_aabb_tree::null_node) {
+                state.tree.remove(proxy.leaf);
+                proxy.leaf = game_aabb_tree::null_node;
+            }
+        }
+
+        /**
+         * @brief Look up what the entity's bounds are made of, see `system_spatial`.
+         */
+        void resolve_spatial_extent(const entt::registry& registry, const spatial_state& state,
+                                    const entt::entity entity, spatial_proxy& proxy) {
+            const auto* sprite_component = registry.try_get<component_sprite>(entity);
+            if (state.resources != nullptr && sprite_component != nullptr) {
+                if (const game_sprite* sprite =
+                        state.resources->sprite_get(sprite_component->resource_key);
+                    sprite != nullptr) {
+                    proxy.extent = spatial_extent::sprite;
+                    proxy.offset = -sprite->get_origin();
+                    proxy.size = sprite->get_size();
+                    return;
+                }
+            }
+
+            if (const auto* collider = registry.try_get<component_collider>(entity); collider) {
+                const glm::vec2 extent = get_collider_extent(*collider);
+                proxy.extent = spatial_extent::collider;
+                proxy.offset = -extent;
+                proxy.size = extent * 2.0f;
+                return;
+            }
+
+            proxy.extent = spatial_extent::point;
+            proxy.offset = {0.0f, 0.0f};
+            proxy.size = {0.0f, 0.0f};
+        }
+
+        /**
+         * @brief World bounds of an entity, matching `game_renderer::sprite_draw_world` for
+         *        sprites: the size is scaled but the origin is not, and rotation is about it.
+         */
+        game_aabb get_spatial_bounds(const spatial_proxy& proxy, const component_transform& world) {
+            if (proxy.extent != spatial_extent::sprite) {
+                return {world.position + proxy.offset, world.position + proxy.offset + proxy.size};
+            }
+
+            const glm::vec2 near = proxy.offset;
+            const glm::vec2 far = proxy.offset + (proxy.size * world.scale);
+            if (world.rotation == 0.0f) {
+                return {world.position + glm::min(near, far), world.position + glm::max(near, far)};
+            }
+
+            const float radians = glm::radians(world.rotation);
+            const float cos = std::cos(radians);
+            const float sin = std::sin(radians);
+            const std::array<glm::vec2, 4> corners = {
+                near, glm::vec2{far.x, near.y}, glm::vec2{near.x, far.y}, far};
+
+            game_aabb bounds = {glm::vec2{std::numeric_limits<float>::max()},
+                                glm::vec2{std::numeric_limits<float>::lowest()}};
+            for (const glm::vec2& corner : corners) {
+                const glm::vec2 rotated = {(corner.x * cos) - (corner.y * sin),
+                                           (corner.x * sin) + (corner.y * cos)};
+                bounds.min = glm::min(bounds.min, rotated);
+                bounds.max = glm::max(bounds.max, rotated);
+            }
+
+            return {world.position + bounds.min, world.position + bounds.max};
+        }
+
+        /**
+         * @brief Update the bounds of a filed entity, the tree only re-inserts it once they left
+         *        its enlarged bounds.
+         */
+        void refit_spatial(spatial_state& state, const entt::entity entity,
+                           const component_transform& world) {
+            spatial_proxy& proxy = get_spatial_proxy(state, entity);
+            if (proxy.leaf != game_aabb_tree::null_node) {
+                state.tree.move(proxy.leaf, get_spatial_bounds(proxy, world));
+            }
+        }
+
+        void refresh_marked_spatial(entt::registry& registry, spatial_state& state,
+                                    const entt::entity entity) {
+            // Destroyed entities were removed on the spot, their slot may already be reused.
+            if (registry.valid(entity) == false) {
+                return;
+            }
+
+            spatial_proxy& proxy = get_spatial_proxy(state, entity);
+            proxy.marked = entt::null;
+
+            if (registry.all_of<component_transform>(entity) == false ||
+                registry.all_of<component_disabled>(entity) == true) {
+                unfile_spatial(state, proxy);
+                return;
+            }
+
+            resolve_spatial_extent(registry, state, entity, proxy);
+
+            const game_aabb bounds =
+                get_spatial_bounds(proxy, system_hierarchy::get_world(registry, entity));
+            if (proxy.leaf == game_aabb_tree::null_node) {
+                proxy.leaf = state.tree.insert(bounds, entity);
+            } else {
+                state.tree.move(proxy.leaf, bounds, false);
+            }
+        }
+
+        void on_spatial_changed(entt::registry& registry, const entt::entity entity) {
+            system_spatial::mark_moved(registry, entity);
+        }
+
+        void on_spatial_destroyed(entt::registry& registry, const entt::entity entity) {
+            spatial_state& state = registry.ctx().get<spatial_state>();
+            spatial_proxy& proxy = get_spatial_proxy(state, entity);
+
+            unfile_spatial(state, proxy);
+            proxy = {};
+        }
+
+        template <typename Component>
+        void connect_spatial_signals(entt::registry& registry) {
+            registry.on_construct<Component>().template connect<&on_spatial_changed>();
+            registry.on_update<Component>().template connect<&on_spatial_changed>();
+            registry.on_destroy<Component>().template connect<&on_spatial_changed>();
+        }
+
+        /**
+         * @brief The flocking agents of a registry and their index, kept in its context.
+         */
+        struct flocking_state {
+            game_neighborhood neighborhood;
+
+            // In view order, which is the index the neighbourhood knows each agent by.
+            std::vector<entt::entity> agents;
+            std::vector<glm::vec2> positions;
+            std::vector<std::uint32_t> slots;
+
+            // In slot order.
+            std::vector<glm::vec2> velocities;
+            std::vector<std::uint32_t> flocks;
+            std::vector<glm::vec2> steered;
+
+            std::vector<game_neighbor_batch> batches;  ///< One per task, kept for their storage.
+            game_flocking_stats stats;
+        };
+
+        struct flocking_chunks {
+            flocking_state* state;
+            const system_flocking_settings* settings;
+            float tick_interval;
+            std::size_t chunk_size;
+        };
+
+        glm::vec2 clamp_length(const glm::vec2& value, const float max) {
+            const float length_squared = glm::dot(value, value);
+            return length_squared > max * max ? value * (max / std::sqrt(length_squared)) : value;
+        }
+
+        /**
+         * @brief Steer the agents of slots `first` up to `last`, reading only what the update
+         *        started from and writing only their own slots.
+         */
+        void steer_range(flocking_state& state, const system_flocking_settings& settings,
+                         const float tick_interval, const std::uint32_t first,
+                         const std::uint32_t last, game_neighbor_batch& batch) {
+            const game_neighborhood& neighborhood = state.neighborhood;
+            neighborhood.gather(first, last, settings.radius, settings.max_neighbors, batch);
+
+            const float inverse_radius = settings.radius > 0.0f ? 1.0f / settings.radius : 0.0f;
+            const float inverse_speed =
+                settings.max_speed > 0.0f ? 1.0f / settings.max_speed : 0.0f;
+
+            for (std::uint32_t slot = first; slot < last; ++slot) {
+                const glm::vec2 position = neighborhood.get_position(slot);
+                const glm::vec2 velocity = state.velocities[slot];
+                const std::uint32_t flock = state.flocks[slot];
+
+                glm::vec2 separation = {0.0f, 0.0f};
+                glm::vec2 heading = {0.0f, 0.0f};
+                glm::vec2 center = {0.0f, 0.0f};
+                std::uint32_t flockmates = 0;
+                for (const game_neighbor& neighbor : batch.get(slot)) {
+                    const glm::vec2 other = neighborhood.get_position(neighbor.slot);
+
+                    // Pushed away along the line between them, harder the closer they are.
+                    if (neighbor.distance_squared > 0.0f) {
+                        const float distance = std::sqrt(neighbor.distance_squared);
+                        separation += (position - other) *
+                                      ((1.0f - (distance * inverse_radius)) / distance);
+                    }
+
+                    if (state.flocks[neighbor.slot] == flock) {
+                        heading += state.velocities[neighbor.slot];
+                        center += other;
+                        ++flockmates;
+                    }
+                }
+
+                // Each rule is scaled to about one at full strength, so the weights compare.
+                glm::vec2 steering = separation * settings.separation;
+                if (flockmates > 0) {
+                    const float inverse_count = 1.0f / static_cast<float>(flockmates);
+                    steering += ((heading * inverse_count) - velocity) *
+                                (inverse_speed * settings.alignment);
+                    steering += ((center * inverse_count) - position) *
+                                (inverse_radius * settings.cohesion);
+                }
+
+                const glm::vec2 acceleration =
+                    clamp_length(steering * settings.max_acceleration, settings.max_acceleration);
+                state.steered[slot] =
+                    clamp_length(velocity + (acceleration * tick_interval), settings.max_speed);
+            }
+        }
+
+        void steer_chunk(const std::size_t chunk_index, void* user_data) {
+            const auto* chunks = static_cast<const flocking_chunks*>(user_data);
+            flocking_state& state = *chunks->state;
+            const std::size_t first = chunk_index * chunks->chunk_size;
+            const std::size_t last = std::min(first + chunks->chunk_size, state.agents.size());
+
+            steer_range(state, *chunks->settings, chunks->tick_interval,
+                        static_cast<std::uint32_t>(first), static_cast<std::uint32_t>(last),
+                        state.batches[chunk_index]);
+        }
+
+        /**
+         * @brief The navigation grid of a registry and the fields its agents asked for, kept in
+         *        its context.
+         */
+        struct flow_state {
+            game_flow_fields fields;
+            std::vector<std::uint32_t> requests;  ///< Field of each agent, in view order.
+        };
+
+        /**
+         * @brief Pool of one emitter and what spawning carries over between ticks.
+         */
+        struct particle_emitter {
+            entt::entity owner = entt::null;  ///< Null once the emitter is destroyed.
+            game_particle_pool pool;
+            game_particle_motion motion;
+            std::string sprite_key;
+            float pending = 0.0f;  ///< Share of a particle owed to the next tick.
+            std::uint32_t seed = 1;
+        };
+
+        /**
+         * @brief The particle pools of a registry, kept in its context.
+         */
+        struct particles_state {
+            std::vector<particle_emitter> emitters;
+            std::vector<std::uint32_t> indices;  ///< Emitter of each entity index.
+            float tick_interval = 0.0f;
+            game_particle_stats stats;
+        };
+
+        constexpr std::uint32_t no_emitter = UINT32_MAX;
+
+        std::uint32_t& get_emitter_index(particles_state& state, const entt::entity entity) {
+            const auto index = static_cast<std::size_t>(entt::to_entity(entity));
+            if (index >= state.indices.size()) {
+                state.indices.resize(index + 1, no_emitter);
+            }
+
+            return state.indices[index];
+        }
+
+        void on_emitter_destroyed(entt::registry& registry, const entt::entity entity) {
+            particles_state& state = registry.ctx().get<particles_state>();
+            std::uint32_t& index = get_emitter_index(state, entity);
+            if (index != no_emitter) {
+                state.emitters[index].owner = entt::null;
+                index = no_emitter;
+            }
+        }
+
+        /**
+         * @brief Next value of an emitter's xorshift sequence, from 0 up to 1.
+         */
+        float next_particle_random(std::uint32_t& seed) {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            return static_cast<float>(seed >> 8) * (1.0f / 16777216.0f);
+        }
+
+        void spawn_particles(particle_emitter& target, const component_emitter& emitter,
+                             const glm::vec2& origin, const std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) {
+                const float offset = next_particle_random(target.seed) - 0.5f;
+                const float angle = glm::radians(emitter.direction + (offset * emitter.spread));
+                const float speed = glm::mix(emitter.speed_min, emitter.speed_max,
+                                             next_particle_random(target.seed));
+                const float lifetime = glm::mix(emitter.lifetime_min, emitter.lifetime_max,
+                                                next_particle_random(target.seed));
+                target.pool.spawn(origin, glm::vec2{std::cos(angle), std::sin(angle)} * speed,
+                                  lifetime, emitter.motion);
+            }
+        }
+
+        struct particles_tasks {
+            particles_state* state;
+            float tick_interval;
+        };
+
+        void simulate_particles(const std::size_t task_index, void* user_data) {
+            const auto* tasks = static_cast<const particles_tasks*>(user_data);
+            particle_emitter& target = tasks->state->emitters[task_index];
+            static_cast<void>(target.pool.update(tasks->tick_interval, target.motion));
+        }
+    }  // namespace
+
+    void system_physics::attach(entt::registry& registry) {
+        if (registry.ctx().contains<physics_state>() == true) {
+            return;
+        }
+
+        registry.ctx().emplace<physics_state>();
+
+        // Anything that moves a body in or out of the group, or changes which optional
+        // components it has, reorders the packed arrays.
+        connect_physics_signals<component_transform>(registry);
+        connect_physics_signals<component_velocity_linear>(registry);
+        connect_physics_signals<component_velocity_angular>(registry);
+        connect_physics_signals<component_interpolation>(registry);
+        connect_physics_signals<component_sleeping>(registry);
+        connect_physics_signals<component_disabled>(registry);
+    }
+
+    void system_physics::update(entt::registry& registry, const float tick_interval,
+                                const system_physics_settings& settings) {
+        integrate_velocity(registry, tick_interval, settings);
+    }
+
+    system_physics_counts system_physics::count_bodies(entt::registry& registry) {
+        system_physics_counts counts;
+        counts.awake = group_physics(registry).size();
+        counts.sleeping = registry.storage<component_sleeping>().size();
+
+        auto angular_view = registry.view<component_transform, component_velocity_angular>(
+            entt::exclude<component_velocity_linear, component_sleeping, component_disabled>);
+        for ([[maybe_unused]] const entt::entity entity : angular_view) {
+            ++counts.awake;
+        }
+
+        return counts;
+    }
+
+    std::uint64_t system_physics::hash_state(const entt::registry& registry) {
+        // Bodies are hashed one by one and summed, which no order changes.
+        std::uint64_t sum = 0;
+        std::uint64_t count = 0;
+        for (auto [entity, transform] : registry.view<component_transform>().each()) {
+            std::uint64_t hash = mix_hash(entt::to_integral(entity));
+            hash = combine_hash(hash, transform.position.x, transform.position.y);
+            hash = combine_hash(hash, transform.rotation, 0.0f);
+            hash = combine_hash(hash, transform.scale.x, transform.scale.y);
+
+            if (const auto* linear = registry.try_get<component_velocity_linear>(entity); linear) {
+                hash = combine_hash(hash, linear->value.x, linear->value.y);
+                hash = mix_hash(hash ^ linear->resting_ticks);
+            }
+
+            if (const auto* angular = registry.try_get<component_velocity_angular>(entity);
+                angular) {
+                hash = combine_hash(hash, angular->value, 0.0f);
+            }
+
+            if (registry.all_of<component_sleeping>(entity) == true) {
+                hash = mix_hash(hash ^ 1);
+            }
+
+            sum += hash;
+            ++count;
+        }
+
+        return mix_hash(sum ^ count);
+    }
+
+    void system_physics::integrate_velocity(entt::registry& registry, float tick_interval,
+                                            const system_physics_settings& settings) {
+        physics_state& state = registry.ctx().get<physics_state>();
+        if (state.is_order_dirty == true) {
+            sort_physics(registry, state);
+        }
+
+        auto& interpolations = registry.storage<component_interpolation>();
+
+        physics_pages pages{};
+        pages.count = group_physics(registry).size();
+        pages.transforms = registry.storage<component_transform>().raw();
+        pages.linears = registry.storage<component_velocity_linear>().raw();
+        pages.angulars = registry.storage<component_velocity_angular>().raw();
+        pages.interpolations = interpolations.raw();
+        pages.entities = registry.storage<component_transform>().data();
+        pages.stretches = state.stretches.data();
+        pages.stretch_count = state.stretches.size();
+        pages.kernel = physics_kernel_resolve(settings.kernel);
+        pages.tick_interval = tick_interval;
+        pages.sleep_linear_squared =
+            settings.sleep_linear_threshold * settings.sleep_linear_threshold;
+        pages.sleep_angular = settings.sleep_angular_threshold;
+        pages.sleep_ticks = settings.sleep_ticks;
+        pages.sleep_linear_squared_fixed =
+            fixed_length_squared(fixed_from_float(settings.sleep_linear_threshold), 0);
+        pages.sleep_angular_fixed = fixed_from_float(settings.sleep_angular_threshold);
+
+        // Distances to the focus points are float math, so deterministic runs step every body.
+        pages.is_lod_enabled = settings.is_lod_enabled == true &&
+                               settings.lod_focus.empty() == false &&
+                               pages.kernel != physics_kernel::deterministic;
+        pages.tick = ++state.tick;
+        pages.lod_focus = settings.lod_focus.data();
+        pages.lod_focus_count = settings.lod_focus.size();
+        for (std::size_t i = 0; i < settings.lod_distances.size(); ++i) {
+            pages.lod_distances_squared[i] = settings.lod_distances[i] * settings.lod_distances[i];
+        }
+
+        // Bodies left mid-window when LOD turns off must blend over a single tick again.
+        if (state.is_lod_active == true && pages.is_lod_enabled == false) {
+            for (auto [entity, interpolation] : interpolations.each()) {
+                interpolation.lod_window = 1;
+                interpolation.lod_elapsed = 0;
+            }
+        }
+        state.is_lod_active = pages.is_lod_enabled;
+
+        // Chunks start on whole cache lines of every storage, so no two threads write one line.
+        constexpr std::size_t granule = physics_chunk_granule();
+        const std::size_t chunk_size =
+            std::max<std::size_t>((settings.parallel_chunk_size + granule - 1) / granule, 1) *
+            granule;
+        const std::size_t chunk_count = (pages.count + chunk_size - 1) / chunk_size;
+
+        std::vector<entt::entity> sleepers;
+
+        if (settings.workers != nullptr && chunk_count > 1) {
+            // Every body is integrated independently with the same kernel, and sleepers are
+            // merged in chunk order, so the split does not change the results.
+            std::vector<std::vector<entt::entity>> chunk_sleepers(chunk_count);
+            physics_chunks chunks{&pages, chunk_size, pages.count, &chunk_sleepers};
+            settings.workers->parallel_for(chunk_count, &integrate_chunk, &chunks);
+
+            for (const auto& chunk : chunk_sleepers) {
+                sleepers.insert(sleepers.end(), chunk.begin(), chunk.end());
+            }
+        } else {
+            integrate_packed_range(pages, 0, pages.count, sleepers);
+        }
+
+        // Angular velocity only, rare enough to be served by a plain view.
+        auto angular_view = registry.view<component_transform, component_velocity_angular>(
+            entt::exclude<component_velocity_linear, component_sleeping, component_disabled>);
+        for (auto [entity, transform, angular_velocity] : angular_view.each()) {
+            component_interpolation* interpolation =
+                interpolations.contains(entity) ? &interpolations.get(entity) : nullptr;
+
+            physics_kernel_integrate(pages.kernel,
+                                     {&transform, nullptr, &angular_velocity, interpolation, 1},
+                                     tick_interval);
+        }
+
+        // Interpolated entities that do not move on their own still need a fresh snapshot.
+        // Moving bodies had theirs written by the kernels above: the interpolation pages follow
+        // the group, so the snapshot is a store in the same linear pass as the step rather than a
+        // copy of its own. Flipping a previous/current pair of arrays instead would need a second
+        // copy of `component_transform`, the storage every other system reads.
+        for (auto [entity, transform, interpolation] : group_physics_still(registry).each()) {
+            store_previous(transform, interpolation);
+        }
+
+        // Tagging shuffles the groups, so it waits until nothing iterates them.
+        put_to_sleep(registry, sleepers);
+    }
+
+    // Hierarchy System Implementation
+    void system_hierarchy::attach(entt::registry& registry) {
+        if (registry.ctx().contains<hierarchy_state>() == true) {
+            return;
+        }
+
+        registry.ctx().emplace<hierarchy_state>();
+        registry.on_construct<component_hierarchy>().connect<&on_hierarchy_changed>();
+        registry.on_update<component_hierarchy>().connect<&on_hierarchy_changed>();
+        registry.on_destroy<component_hierarchy>().connect<&on_hierarchy_changed>();
+    }
+
+    void system_hierarchy::update(entt::registry& registry) {
+        hierarchy_state& state = registry.ctx().get<hierarchy_state>();
+        auto& nodes = registry.storage<component_hierarchy>();
+        auto& transforms = registry.storage<component_transform>();
+
+        if (state.is_order_dirty == true) {
+            sort_hierarchy(registry, state);
+        }
+
+        state.orphans.clear();
+
+        // Depth-first order puts every parent before its children, so their world is final.
+        for (auto [entity, node] : nodes.each()) {
+            node.previous_world = node.world;
+
+            const component_transform* parent_world = nullptr;
+            if (nodes.contains(node.parent) == true) {
+                parent_world = &nodes.get(node.parent).world;
+            } else if (transforms.contains(node.parent) == true) {
+                parent_world = &transforms.get(node.parent);
+            }
+
+            if (parent_world == nullptr || transforms.contains(entity) == false) {
+                state.orphans.push_back(entity);
+                continue;
+            }
+
+            const component_transform& local = transforms.get(entity);
+            if (is_same_transform(local, node.composed_local) == true &&
+                is_same_transform(*parent_world, node.composed_parent) == true) {
+                continue;
+            }
+
+            node.composed_local = local;
+            node.composed_parent = *parent_world;
+            node.world = compose_transform(*parent_world, local, node);
+        }
+
+        for (const entt::entity orphan : state.orphans) {
+            detach_child(registry, orphan);
+        }
+    }
+
+    bool system_hierarchy::attach_child(entt::registry& registry, const entt::entity child,
+                                        const entt::entity parent,
+                                        const bool is_rotation_inherited,
+                                        const bool is_scale_inherited) {
+        if (child == parent || registry.valid(child) == false || registry.valid(parent) == false) {
+            return false;
+        }
+
+        auto& transforms = registry.storage<component_transform>();
+        if (transforms.contains(child) == false || transforms.contains(parent) == false) {
+            return false;
+        }
+
+        auto& nodes = registry.storage<component_hierarchy>();
+        for (entt::entity ancestor = parent; nodes.contains(ancestor) == true;) {
+            ancestor = nodes.get(ancestor).parent;
+            if (ancestor == child) {
+                return false;
+            }
+        }
+
+        // Composed right away, so the child is in place before the next tick.
+        component_hierarchy node{};
+        node.parent = parent;
+        node.is_rotation_inherited = is_rotation_inherited;
+        node.is_scale_inherited = is_scale_inherited;
+        node.composed_local = transforms.get(child);
+        node.composed_parent = get_world(registry, parent);
+        node.world = compose_transform(node.composed_parent, node.composed_local, node);
+        node.previous_world = node.world;
+
+        registry.emplace_or_replace<component_hierarchy>(child, node);
+        return true;
+    }
+
+    void system_hierarchy::detach_child(entt::registry& registry, const entt::entity child) {
+        if (registry.valid(child) == false) {
+            return;
+        }
+
+        if (const auto* node = registry.try_get<component_hierarchy>(child); node) {
+            if (auto* transform = registry.try_get<component_transform>(child); transform) {
+                *transform = node->world;
+            }
+
+            registry.remove<component_hierarchy>(child);
+        }
+    }
+
+    const component_transform& system_hierarchy::get_world(const entt::registry& registry,
+                                                           const entt::entity entity) {
+        if (const auto* node = registry.try_get<component_hierarchy>(entity); node) {
+            return node->world;
+        }
+
+        return registry.get<component_transform>(entity);
+    }
+
+    // Renderer System Implementation
+    void system_renderer::attach(entt::registry& registry) {
+        if (registry.ctx().contains<render_state>() == true) {
+            return;
+        }
+
+        registry.ctx().emplace<render_state>();
+
+        // Anything that can move an entity in or out of a render list, or change how it is drawn.
+        connect_render_signals<component_sprite, true>(registry);
+        connect_render_signals<component_text_dynamic, true>(registry);
+        connect_render_signals<component_renderable, false>(registry);
+        connect_render_signals<component_transform, false>(registry);
+        connect_render_signals<component_interpolation, false>(registry);
+        connect_render_signals<component_hierarchy, false>(registry);
+        connect_render_signals<component_disabled, false>(registry);
+    }
+
+    void system_renderer::prepare(entt::registry& registry, game_resources& resources) {
+        render_state& state = registry.ctx().get<render_state>();
+        refresh_render_lists(registry, state, &resources);
+
+        // Cached resource pointers only survive as long as the resources they came from.
+        if (state.resources != &resources ||
+            state.resources_generation != resources.get_generation()) {
+            state.resources = &resources;
+            state.resources_generation = resources.get_generation();
+
+            resolve_render_list<component_sprite>(registry, state.sprites, resources);
+            resolve_render_list<component_text_dynamic>(registry, state.texts, resources);
+        }
+    }
+
+    void system_renderer::prepare(entt::registry& registry) {
+        render_state& state = registry.ctx().get<render_state>();
+        refresh_render_lists(registry, state, nullptr);
+
+        // Entries refreshed without resources are resolved by the next call with them.
+        state.resources = nullptr;
+    }
+
+    void system_renderer::interpolate(entt::registry& registry, const float fraction_to_next_tick) {
+        render_state& state = registry.ctx().get<render_state>();
+        interpolate_render_list(registry, state.sprites, fraction_to_next_tick);
+        interpolate_render_list(registry, state.texts, fraction_to_next_tick);
+    }
+
+    void system_renderer::update(entt::registry& registry, game_renderer* renderer,
+                                 game_resources& resources, const float fraction_to_next_tick) {
+        // TODO: Make the layering work.
+        prepare(registry, resources);
+        interpolate(registry, fraction_to_next_tick);
+
+        const render_state& state = registry.ctx().get<render_state>();
+
+        // Render sprites.
+        for (std::size_t i = 0; i < state.sprites.entries.size(); ++i) {
+            const render_entry& entry = state.sprites.entries[i];
+            if (entry.resource == nullptr) {
+                continue;
+            }
+
+            const render_transform& transform = state.sprites.transforms[i];
+            auto* sprite = static_cast<game_sprite*>(entry.resource);
+            sprite->set_rotation(transform.rotation);
+            sprite->set_scale(transform.scale);
+
+            renderer->sprite_draw_world(sprite, transform.position);
+        }
+
+        // Render dynamic text
+        for (std::size_t i = 0; i < state.texts.entries.size(); ++i) {
+            const render_entry& entry = state.texts.entries[i];
+            if (entry.resource == nullptr) {
+                continue;
+            }
+
+            const render_transform& transform = state.texts.transforms[i];
+            auto* text = static_cast<game_text_dynamic*>(entry.resource);
+            text->set_scale(transform.scale);
+            text->set_rotation(transform.rotation);
+
+            renderer->text_draw_world(text, transform.position);
+        }
+    }
+
+    std::size_t system_renderer::count_pending(const entt::registry& registry) {
+        return registry.ctx().get<render_state>().pending.size();
+    }
+
+    // Lifetime System Implementation
+    void system_lifetime::attach(entt::registry& registry) {
+        if (registry.ctx().contains<lifetime_state>() == true) {
+            return;
+        }
+
+        registry.ctx().emplace<lifetime_state>();
+        registry.on_construct<component_lifetime>().connect<&on_lifetime_changed>();
+        registry.on_update<component_lifetime>().connect<&on_lifetime_changed>();
+    }
+
+    void system_lifetime::update(game_entities& entities, const float tick_interval) {
+        entt::registry& registry = entities.registry();
+        lifetime_state& state = registry.ctx().get<lifetime_state>();
+        auto& lifetimes = registry.storage<component_lifetime>();
+        const std::uint64_t tick = state.wheel.get_tick();
+        state.tick_interval = tick_interval;
+
+        // File everything scheduled since the last tick.
+        for (const entt::entity entity : state.pending_lifetimes) {
+            if (lifetimes.contains(entity) == false) {
+                continue;
+            }
+
+            component_lifetime& lifetime = lifetimes.get(entity);
+            lifetime.expiry_tick =
+                tick + seconds_to_ticks(lifetime.remaining_seconds, tick_interval);
+            state.wheel.insert(lifetime.expiry_tick, entt::to_integral(entity));
+        }
+        state.pending_lifetimes.clear();
+
+        for (const std::uint32_t slot : state.pending_timers) {
+            lifetime_timer& timer = state.timers[slot];
+            if (timer.is_active == false) {
+                release_timer(state, slot);
+                continue;
+            }
+
+            timer.interval_ticks = seconds_to_ticks(timer.seconds, tick_interval);
+            state.wheel.insert(tick + timer.interval_ticks, timer_key_callback | slot);
+        }
+        state.pending_timers.clear();
+
+        state.expired.clear();
+        state.wheel.advance(state.expired);
+        const std::uint64_t now = state.wheel.get_tick();
+
+        for (const std::uint64_t key : state.expired) {
+            if ((key & timer_key_callback) == 0) {
+                // A replaced lifetime leaves its old key behind, only the latest one counts.
+                const auto entity = static_cast<entt::entity>(static_cast<std::uint32_t>(key));
+                if (lifetimes.contains(entity) == true &&
+                    lifetimes.get(entity).expiry_tick == now) {
+                    entities.destroy(entity);
+                }
+                continue;
+            }
+
+            const auto slot = static_cast<std::uint32_t>(key);
+
+            // Copied, since the callback may schedule more timers and grow the array.
+            const lifetime_timer timer = state.timers[slot];
+            if (timer.is_active == false || registry.valid(timer.entity) == false ||
+                registry.all_of<component_disabled>(timer.entity) == true) {
+                release_timer(state, slot);
+                continue;
+            }
+
+            if (timer.is_repeating == true) {
+                state.wheel.insert(now + timer.interval_ticks, key);
+            } else {
+                release_timer(state, slot);
+            }
+
+            timer.callback(entities, timer.entity, timer.user_data);
+        }
+    }
+
+    float system_lifetime::get_remaining(const entt::registry& registry,
+                                         const entt::entity entity) {
+        const auto* lifetime = registry.try_get<component_lifetime>(entity);
+        if (lifetime == nullptr) {
+            return 0.0f;
+        }
+
+        // Not filed into the wheel yet, so nothing has run down.
+        if (lifetime->expiry_tick == 0) {
+            return lifetime->remaining_seconds;
+        }
+
+        const lifetime_state& state = registry.ctx().get<lifetime_state>();
+        const std::uint64_t tick = state.wheel.get_tick();
+        if (lifetime->expiry_tick <= tick) {
+            return 0.0f;
+        }
+
+        return static_cast<float>(lifetime->expiry_tick - tick) * state.tick_interval;
+    }
+
+    game_timer_handle system_lifetime::schedule(entt::registry& registry, entt::entity entity,
+                                                const float seconds, const bool is_repeating,
+                                                const game_entity_callback callback,
+                                                void* user_data) {
+        if (callback == nullptr || registry.valid(entity) == false) {
+            return {};
+        }
+
+        lifetime_state& state = registry.ctx().get<lifetime_state>();
+
+        std::uint32_t slot = 0;
+        if (state.free_timers.empty() == true) {
+            slot = static_cast<std::uint32_t>(state.timers.size());
+            state.timers.emplace_back();
+        } else {
+            slot = state.free_timers.back();
+            state.free_timers.pop_back();
+        }
+
+        lifetime_timer& timer = state.timers[slot];
+        timer.entity = entity;
+        timer.callback = callback;
+        timer.user_data = user_data;
+        timer.seconds = seconds;
+        timer.interval_ticks = 0;
+        timer.is_repeating = is_repeating;
+        timer.is_active = true;
+
+        state.pending_timers.push_back(slot);
+
+        return {slot, timer.generation};
+    }
+
+    void system_lifetime::cancel(entt::registry& registry, const game_timer_handle handle) {
+        lifetime_state& state = registry.ctx().get<lifetime_state>();
+
+        // The slot is released once the wheel hands its key back.
+        if (handle.slot < state.timers.size() &&
+            state.timers[handle.slot].generation == handle.generation) {
+            state.timers[handle.slot].is_active = false;
+        }
+    }
+
+    // Pool System Implementation
+    void system_pool::attach(entt::registry& registry) {
+        if (registry.ctx().contains<pool_state>() == true) {
+            return;
+        }
+
+        registry.ctx().emplace<pool_state>();
+        registry.on_destroy<component_pooled>().connect<&on_pooled_destroyed>();
+    }
+
+    entt::entity system_pool::acquire(entt::registry& registry, std::string_view key) {
+        pool_state& state = registry.ctx().get<pool_state>();
+
+        const auto found = state.indices.find(key);
+        if (found == state.indices.end()) {
+            return entt::null;
+        }
+
+        entity_pool& pool = state.pools[found->second];
+
+        while (pool.released.empty() == false) {
+            const entt::entity entity = pool.released.back();
+            pool.released.pop_back();
+
+            // Released entities that were destroyed in the meantime are simply dropped here.
+            if (registry.valid(entity) == false) {
+                continue;
+            }
+
+            auto* pooled = registry.try_get<component_pooled>(entity);
+            if (pooled == nullptr || pooled->is_active == true) {
+                continue;
+            }
+
+            pooled->is_active = true;
+            registry.remove<component_disabled>(entity);
+
+            note_spawned(pool.stats);
+            ++pool.stats.reused;
+
+            return entity;
+        }
+
+        return entt::null;
+    }
+
+    void system_pool::adopt(entt::registry& registry, const entt::entity entity,
+                            std::string_view key, const bool is_active) {
+        if (registry.valid(entity) == false || registry.all_of<component_pooled>(entity) == true) {
+            return;
+        }
+
+        pool_state& state = registry.ctx().get<pool_state>();
+
+        auto found = state.indices.find(key);
+        if (found == state.indices.end()) {
+            found = state.indices
+                        .emplace(std::string(key), static_cast<std::uint32_t>(state.pools.size()))
+                        .first;
+            state.pools.emplace_back();
+        }
+
+        entity_pool& pool = state.pools[found->second];
+        registry.emplace<component_pooled>(entity, found->second, is_active);
+        ++pool.stats.capacity;
+
+        if (is_active == true) {
+            note_spawned(pool.stats);
+        } else {
+            registry.emplace_or_replace<component_disabled>(entity);
+            pool.released.push_back(entity);
+        }
+    }
+
+    void system_pool::release(entt::registry& registry, const entt::entity entity) {
+        if (registry.valid(entity) == false) {
+            return;
+        }
+
+        auto* pooled = registry.try_get<component_pooled>(entity);
+        if (pooled == nullptr || pooled->is_active == false) {
+            return;
+        }
+
+        pooled->is_active = false;
+        entity_pool& pool = registry.ctx().get<pool_state>().pools[pooled->pool];
+
+        // Written before tagging, which moves the entity out of the physics groups.
+        if (auto* linear = registry.try_get<component_velocity_linear>(entity); linear) {
+            linear->value = {0.0f, 0.0f};
+            linear->resting_ticks = 0;
+        }
+
+        if (auto* angular = registry.try_get<component_velocity_angular>(entity); angular) {
+            angular->value = 0.0f;
+        }
+
+        registry.remove<component_lifetime, component_sleeping>(entity);
+        registry.emplace_or_replace<component_disabled>(entity);
+
+        --pool.stats.active;
+        ++pool.stats.released;
+        pool.released.push_back(entity);
+    }
+
+    game_pool_stats system_pool::get_stats(const entt::registry& registry, std::string_view key) {
+        const pool_state& state = registry.ctx().get<pool_state>();
+
+        const auto found = state.indices.find(key);
+        if (found == state.indices.end()) {
+            return {};
+        }
+
+        return state.pools[found->second].stats;
+    }
+
+    // Collision System Implementation
+    void system_collision::attach(entt::registry& registry) {
+        if (registry.ctx().contains<collision_state>() == true) {
+            return;
+        }
+
+        registry.ctx().emplace<collision_state>();
+        registry.on_construct<component_collider>().connect<&on_collider_changed>();
+        registry.on_update<component_collider>().connect<&on_collider_changed>();
+        registry.on_destroy<component_collider>().connect<&on_collider_destroyed>();
+        registry.on_construct<component_disabled>().connect<&on_collider_disabled>();
+        registry.on_destroy<component_disabled>().connect<&on_collider_disabled>();
+    }
+
+    void system_collision::set_grid(entt::registry& registry, const float cell_size,
+                                    const float margin) {
+        collision_state& state = registry.ctx().get<collision_state>();
+        if (cell_size <= 0.0f || margin < 0.0f) {
+            return;
+        }
+
+        state.cell_size = cell_size;
+        state.inverse_cell_size = 1.0f / cell_size;
+        state.margin = margin;
+        state.cells.clear();
+        state.cell_indices.clear();
+        state.empty_cells = 0;
+
+        for (collision_proxy& proxy : state.proxies) {
+            proxy.is_filed = false;
+        }
+
+        for (const entt::entity entity : registry.view<component_collider>()) {
+            mark_moved(registry, entity);
+        }
+    }
+
+    void system_collision::mark_moved(entt::registry& registry, const entt::entity entity) {
+        collision_state& state = registry.ctx().get<collision_state>();
+        collision_proxy& proxy = get_collision_proxy(state, entity);
+
+        if (proxy.is_marked == false) {
+            proxy.is_marked = true;
+            state.moved.push_back(entity);
+        }
+    }
+
+    void system_collision::update(entt::registry& registry) {
+        collision_state& state = registry.ctx().get<collision_state>();
+
+        auto moving =
+            registry.view<component_collider, component_transform, component_velocity_linear>(
+                entt::exclude<component_sleeping, component_disabled>);
+        for (auto [entity, collider, transform, linear_velocity] : moving.each()) {
+            refresh_collider(state, entity, collider, transform, false);
+        }
+
+        for (const entt::entity entity : state.moved) {
+            refresh_marked_collider(registry, state, entity);
+        }
+        state.moved.clear();
+
+        compact_cells(state);
+
+        state.pairs.clear();
+        for (const collision_cell& cell : state.cells) {
+            collect_cell_pairs(state, cell);
+        }
+
+        state.contacts.clear();
+        auto continuous = registry.view<component_continuous, component_collider,
+                                        component_transform, component_interpolation>(
+            entt::exclude<component_sleeping, component_disabled>);
+        for (auto [entity, collider, transform, interpolation] : continuous.each()) {
+            // Under update-rate LOD a body that was not stepped this tick keeps the segment it
+            // was already swept along.
+            if (interpolation.lod_elapsed != 0) {
+                continue;
+            }
+
+            sweep_continuous_collider(registry, state, entity, collider,
+                                      interpolation.previous_position, transform.position);
+        }
+    }
+
+    std::span<const game_collision_pair> system_collision::get_pairs(
+        const entt::registry& registry) {
+        return registry.ctx().get<collision_state>().pairs;
+    }
+
+    std::span<const game_collision_contact> system_collision::get_contacts(
+        const entt::registry& registry) {
+        return registry.ctx().get<collision_state>().contacts;
+    }
+
+    // Tiles System Implementation
+    void system_tiles::attach(entt::registry& registry) {
+        if (registry.ctx().contains<tile_state>() == false) {
+            registry.ctx().emplace<tile_state>();
+        }
+    }
+
+    void system_tiles::update(entt::registry& registry, const float tick_interval) {
+        tile_state& state = registry.ctx().get<tile_state>();
+        state.blocked.clear();
+
+        if (state.grid.get_chunk_count() == 0) {
+            return;
+        }
+
+        const auto& interpolations = registry.storage<component_interpolation>();
+        auto moving =
+            registry.view<component_collider, component_transform, component_velocity_linear>(
+                entt::exclude<component_sleeping, component_disabled, component_hierarchy>);
+        for (auto [entity, collider, transform, linear_velocity] : moving.each()) {
+            if ((collider.mask & state.layers) == 0) {
+                continue;
+            }
+
+            // With a snapshot, the step is exactly what moved the body since it was taken, whatever
+            // the kernel or LOD window. Under update-rate LOD a body only moved if it was stepped.
+            glm::vec2 start = transform.position - (linear_velocity.value * tick_interval);
+            if (interpolations.contains(entity) == true) {
+                const component_interpolation& interpolation = interpolations.get(entity);
+                if (interpolation.lod_elapsed != 0) {
+                    continue;
+                }
+                start = interpolation.previous_position;
+            }
+
+            const glm::vec2 motion = transform.position - start;
+            const game_tile_move result =
+                state.grid.move(start, get_collider_extent(collider), motion);
+            if (result.is_blocked_x == false && result.is_blocked_y == false) {
+                continue;
+            }
+
+            transform.position = result.center;
+            if (result.is_blocked_x == true) {
+                linear_velocity.value.x = 0.0f;
+            }
+            if (result.is_blocked_y == true) {
+                linear_velocity.value.y = 0.0f;
+            }
+
+            state.blocked.push_back(entity);
+        }
+    }
+
+    game_tile_grid& system_tiles::get_grid(entt::registry& registry) {
+        return registry.ctx().get<tile_state>().grid;
+    }
+
+    const game_tile_grid& system_tiles::get_grid(const entt::registry& registry) {
+        return registry.ctx().get<tile_state>().grid;
+    }
+
+    void system_tiles::set_layers(entt::registry& registry, const std::uint32_t layers) {
+        registry.ctx().get<tile_state>().layers = layers;
+    }
+
+    std::span<const entt::entity> system_tiles::get_blocked(const entt::registry& registry) {
+        return registry.ctx().get<tile_state>().blocked;
+    }
+
+    // Solver System Implementation
+    void system_solver::attach(entt::registry& registry) {
+        if (registry.ctx().contains<solver_state>() == false) {
+            registry.ctx().emplace<solver_state>();
+        }
+    }
+
+    void system_solver::update(entt::registry& registry, const float tick_interval,
+                               const game_solver_settings& settings) {
+        solver_state& state = registry.ctx().get<solver_state>();
+        state.stats = {};
+        state.bodies.assign(1, game_solver_body{});
+        state.entities.assign(1, entt::null);
+        state.is_sleeping.assign(1, 0);
+        state.contacts.clear();
+
+        collect_solver_contacts(registry, state);
+
+        const std::uint32_t island_count =
+            state.solver.find_islands(state.bodies, state.contacts, state.islands);
+        wake_solver_islands(registry, state, island_count);
+
+        state.solver.solve(state.bodies, state.contacts, tick_interval, settings);
+        store_solver_bodies(registry, state, island_count);
+
+        state.stats.contacts = state.contacts.size();
+        state.stats.warm_started = state.solver.get_warm_started_count();
+        state.stats.islands = island_count;
+    }
+
+    game_solver_stats system_solver::get_stats(const entt::registry& registry) {
+        return registry.ctx().get<solver_state>().stats;
+    }
+
+    // Spatial System Implementation
+    void system_spatial::attach(entt::registry& registry) {
+        if (registry.ctx().contains<spatial_state>() == true) {
+            return;
+        }
+
+        registry.ctx().emplace<spatial_state>();
+        registry.on_construct<component_transform>().connect<&on_spatial_changed>();
+        registry.on_destroy<component_transform>().connect<&on_spatial_destroyed>();
+
+        // Anything that changes an entity's extent, how its world transform is found or whether
+        // it is filed at all.
+        connect_spatial_signals<component_sprite>(registry);
+        connect_spatial_signals<component_collider>(registry);
+        connect_spatial_signals<component_hierarchy>(registry);
+        connect_spatial_signals<component_disabled>(registry);
+    }
+
+    void system_spatial::set_resources(entt::registry& registry, game_resources* resources) {
+        spatial_state& state = registry.ctx().get<spatial_state>();
+        state.resources = resources;
+        state.resources_generation = resources != nullptr ? resources->get_generation() : 0;
+
+        for (const entt::entity entity : registry.view<component_transform>()) {
+            mark_moved(registry, entity);
+        }
+    }
+
+    void system_spatial::set_margin(entt::registry& registry, const float margin) {
+        spatial_state& state = registry.ctx().get<spatial_state>();
+        if (margin < 0.0f) {
+            return;
+        }
+
+        state.tree.clear();
+        state.tree.set_margin(margin);
+
+        for (spatial_proxy& proxy : state.proxies) {
+            proxy.leaf = game_aabb_tree::null_node;
+        }
+
+        for (const entt::entity entity : registry.view<component_transform>()) {
+            mark_moved(registry, entity);
+        }
+    }
+
+    void system_spatial::mark_moved(entt::registry& registry, const entt::entity entity) {
+        spatial_state& state = registry.ctx().get<spatial_state>();
+        spatial_proxy& proxy = get_spatial_proxy(state, entity);
+
+        if (proxy.marked != entity) {
+            proxy.marked = entity;
+            state.moved.push_back(entity);
+        }
+    }
+
+    void system_spatial::update(entt::registry& registry) {
+        spatial_state& state = registry.ctx().get<spatial_state>();
+
+        // Sprite sizes may have changed along with the resources they came from.
+        if (state.resources != nullptr &&
+            state.resources_generation != state.resources->get_generation()) {
+            state.resources_generation = state.resources->get_generation();
+
+            for (const spatial_proxy& proxy : state.proxies) {
+                if (proxy.leaf != game_aabb_tree::null_node) {
+                    mark_moved(registry, state.tree.get_entity(proxy.leaf));
+                }
+            }
+        }
+
+        for (const entt::entity entity : state.moved) {
+            refresh_marked_spatial(registry, state, entity);
+        }
+        state.moved.clear();
+
+        auto linear = registry.view<component_transform, component_velocity_linear>(
+            entt::exclude<component_sleeping, component_disabled, component_hierarchy>);
+        for (auto [entity, transform, velocity] : linear.each()) {
+            refit_spatial(state, entity, transform);
+        }
+
+        auto angular = registry.view<component_transform, component_velocity_angular>(
+            entt::exclude<component_sleeping, component_disabled, component_hierarchy,
+                          component_velocity_linear>);
+        for (auto [entity, transform, velocity] : angular.each()) {
+            refit_spatial(state, entity, transform);
+        }
+
+        auto attached = registry.view<component_hierarchy>(entt::exclude<component_disabled>);
+        for (auto [entity, node] : attached.each()) {
+            refit_spatial(state, entity, node.world);
+        }
+    }
+
+    const game_aabb_tree& system_spatial::get_tree(const entt::registry& registry) {
+        return registry.ctx().get<spatial_state>().tree;
+    }
+
+    // Flocking System Implementation
+    void system_flocking::attach(entt::registry& registry) {
+        if (registry.ctx().contains<flocking_state>() == false) {
+            registry.ctx().emplace<flocking_state>();
+        }
+    }
+
+    void system_flocking::update(entt::registry& registry, const float tick_interval,
+                                 const system_flocking_settings& settings) {
+        flocking_state& state = registry.ctx().get<flocking_state>();
+        state.agents.clear();
+        state.positions.clear();
+
+        auto agents = registry.view<component_flock, component_transform,
+                                    component_velocity_linear>(
+            entt::exclude<component_sleeping, component_disabled, component_hierarchy>);
+        for (auto [entity, flock, transform, linear_velocity] : agents.each()) {
+            state.agents.push_back(entity);
+            state.positions.push_back(transform.position);
+        }
+
+        const std::size_t count = state.agents.size();
+        state.neighborhood.rebuild(state.positions, settings.radius);
+        state.stats = {count, 0};
+        if (count == 0) {
+            return;
+        }
+
+        // Everything steering reads is copied into slot order first, so neighbours in one cell
+        // are read from consecutive memory.
+        state.slots.resize(count);
+        state.velocities.resize(count);
+        state.flocks.resize(count);
+        state.steered.resize(count);
+        const std::span<const std::uint32_t> indices = state.neighborhood.get_indices();
+        for (std::uint32_t slot = 0; slot < count; ++slot) {
+            const entt::entity entity = state.agents[indices[slot]];
+            state.slots[indices[slot]] = slot;
+            state.velocities[slot] = agents.get<component_velocity_linear>(entity).value;
+            state.flocks[slot] = agents.get<component_flock>(entity).flock;
+        }
+
+        const std::size_t chunk_size = std::max<std::size_t>(settings.parallel_chunk_size, 1);
+        const std::size_t chunk_count = (count + chunk_size - 1) / chunk_size;
+        if (state.batches.size() < chunk_count) {
+            state.batches.resize(chunk_count);
+        }
+
+        flocking_chunks chunks{&state, &settings, tick_interval, chunk_size};
+        if (settings.workers != nullptr && chunk_count > 1) {
+            settings.workers->parallel_for(chunk_count, &steer_chunk, &chunks);
+        } else {
+            for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+                steer_chunk(chunk, &chunks);
+            }
+        }
+
+        for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+            state.stats.neighbors += state.batches[chunk].neighbors.size();
+        }
+
+        // The view walks the agents in the order they were collected in.
+        std::size_t index = 0;
+        for (auto [entity, flock, transform, linear_velocity] : agents.each()) {
+            linear_velocity.value = state.steered[state.slots[index++]];
+        }
+    }
+
+    game_flocking_stats system_flocking::get_stats(const entt::registry& registry) {
+        return registry.ctx().get<flocking_state>().stats;
+    }
+
+    const game_neighborhood& system_flocking::get_neighborhood(const entt::registry& registry) {
+        return registry.ctx().get<flocking_state>().neighborhood;
+    }
+
+    entt::entity system_flocking::get_agent(const entt::registry& registry,
+                                            const std::uint32_t slot) {
+        const flocking_state& state = registry.ctx().get<flocking_state>();
+        return state.agents[state.neighborhood.get_index(slot)];
+    }
+
+    // Flow System Implementation
+    void system_flow::attach(entt::registry& registry) {
+        if (registry.ctx().contains<flow_state>() == false) {
+            registry.ctx().emplace<flow_state>();
+        }
+    }
+
+    void system_flow::update(entt::registry& registry, const float tick_interval,
+                             const system_flow_settings& settings) {
+        flow_state& state = registry.ctx().get<flow_state>();
+        game_flow_fields& fields = state.fields;
+        state.requests.clear();
+
+        auto agents = registry.view<component_flow_agent, component_transform,
+                                    component_velocity_linear>(
+            entt::exclude<component_sleeping, component_disabled, component_hierarchy>);
+
+        // Agents sent together tend to be walked together, so the last goal saves most lookups.
+        glm::ivec2 last_goal = {0, 0};
+        std::uint32_t last_field = game_flow_fields::invalid_field;
+        for (auto [entity, agent, transform, linear_velocity] : agents.each()) {
+            const glm::ivec2 goal = fields.get_tile(agent.destination);
+            if (last_field == game_flow_fields::invalid_field || (goal == last_goal) == false) {
+                last_goal = goal;
+                last_field = fields.request(goal);
+            }
+            state.requests.push_back(last_field);
+        }
+
+        fields.build(settings.workers);
+
+        const float inverse_tick = tick_interval > 0.0f ? 1.0f / tick_interval : 0.0f;
+        std::size_t index = 0;
+        for (auto [entity, agent, transform, linear_velocity] : agents.each()) {
+            const std::uint32_t field = state.requests[index++];
+            if (field == game_flow_fields::invalid_field) {
+                linear_velocity.value = {0.0f, 0.0f};
+                continue;
+            }
+
+            // On the goal tile the field has no step left, so the agent closes in by itself
+            // without overshooting.
+            if (fields.get_tile(transform.position) == fields.get_goal(field)) {
+                const glm::vec2 offset = agent.destination - transform.position;
+                const float distance = glm::length(offset);
+                linear_velocity.value =
+                    distance > 0.0f ? offset * std::min(agent.speed / distance, inverse_tick)
+                                    : glm::vec2{0.0f, 0.0f};
+                continue;
+            }
+
+            linear_velocity.value = fields.sample(field, transform.position) * agent.speed;
+        }
+    }
+
+    game_flow_fields& system_flow::get_fields(entt::registry& registry) {
+        return registry.ctx().get<flow_state>().fields;
+    }
+
+    const game_flow_fields& system_flow::get_fields(const entt::registry& registry) {
+        return registry.ctx().get<flow_state>().fields;
+    }
+
+    // Particles System Implementation
+    void system_particles::attach(entt::registry& registry) {
+        if (registry.ctx().contains<particles_state>() == true) {
+            return;
+        }
+
+        registry.ctx().emplace<particles_state>();
+        registry.on_destroy<component_emitter>().connect<&on_emitter_destroyed>();
+    }
+
+    void system_particles::update(entt::registry& registry, const float tick_interval,
+                                  const system_particles_settings& settings) {
+        particles_state& state = registry.ctx().get<particles_state>();
+        state.tick_interval = tick_interval;
+        state.stats = {};
+
+        std::size_t alive = 0;
+        for (const particle_emitter& target : state.emitters) {
+            alive += target.pool.size();
+        }
+
+        auto emitters = registry.view<component_emitter, component_transform>(
+            entt::exclude<component_disabled>);
+        for (auto [entity, emitter, transform] : emitters.each()) {
+            std::uint32_t& index = get_emitter_index(state, entity);
+            if (index == no_emitter) {
+                index = static_cast<std::uint32_t>(state.emitters.size());
+                particle_emitter& created = state.emitters.emplace_back();
+                created.owner = entity;
+                created.seed = (static_cast<std::uint32_t>(entt::to_integral(entity)) *
+                                0x9e3779b9u) | 1u;
+            }
+
+            particle_emitter& target = state.emitters[index];
+            target.motion = emitter.motion;
+            if (target.sprite_key != emitter.sprite_key) {
+                target.sprite_key = emitter.sprite_key;
+            }
+
+            if (emitter.is_emitting == false) {
+                target.pending = 0.0f;
+                continue;
+            }
+
+            // Spawns over a budget are dropped rather than owed, so a full emitter does not
+            // burst once room frees up.
+            target.pending += emitter.rate * tick_interval;
+            const auto wanted = static_cast<std::size_t>(target.pending);
+            target.pending -= static_cast<float>(wanted);
+
+            const std::size_t size = target.pool.size();
+            const std::size_t count =
+                std::min({wanted, emitter.budget > size ? emitter.budget - size : 0,
+                          settings.max_particles > alive ? settings.max_particles - alive : 0});
+            state.stats.spawned += count;
+            state.stats.dropped += wanted - count;
+            alive += count;
+
+            const glm::vec2& origin = system_hierarchy::get_world(registry, entity).position;
+            spawn_particles(target, emitter, origin, count);
+        }
+
+        particles_tasks tasks{&state, tick_interval};
+        if (settings.workers != nullptr && state.emitters.size() > 1) {
+            settings.workers->parallel_for(state.emitters.size(), &simulate_particles, &tasks);
+        } else {
+            for (std::size_t i = 0; i < state.emitters.size(); ++i) {
+                simulate_particles(i, &tasks);
+            }
+        }
+
+        // Pools of destroyed emitters go once their last particle has.
+        for (std::size_t i = 0; i < state.emitters.size();) {
+            if (state.emitters[i].owner != entt::null || state.emitters[i].pool.empty() == false) {
+                state.stats.particles += state.emitters[i].pool.size();
+                ++i;
+                continue;
+            }
+
+            state.emitters[i] = std::move(state.emitters.back());
+            state.emitters.pop_back();
+            if (i < state.emitters.size() && state.emitters[i].owner != entt::null) {
+                get_emitter_index(state, state.emitters[i].owner) = static_cast<std::uint32_t>(i);
+            }
+        }
+        state.stats.emitters = state.emitters.size();
+    }
+
+    void system_particles::draw(const entt::registry& registry, game_renderer* renderer,
+                                game_resources& resources, const float fraction_to_next_tick) {
+        const particles_state& state = registry.ctx().get<particles_state>();
+        const float lead_seconds = fraction_to_next_tick * state.tick_interval;
+
+        for (const particle_emitter& target : state.emitters) {
+            const game_particle_pool& pool = target.pool;
+            if (pool.empty() == true) {
+                continue;
+            }
+
+            game_sprite* sprite = nullptr;
+            if (target.sprite_key.empty() == false) {
+                sprite = resources.sprite_get(target.sprite_key);
+                if (sprite == nullptr) {
+                    continue;
+                }
+            }
+
+            game_quad_batch batch;
+            batch.x = pool.get(particle_channel::x).data();
+            batch.y = pool.get(particle_channel::y).data();
+            batch.sizes = pool.get(particle_channel::size).data();
+            batch.red = pool.get(particle_channel::red).data();
+            batch.green = pool.get(particle_channel::green).data();
+            batch.blue = pool.get(particle_channel::blue).data();
+            batch.alpha = pool.get(particle_channel::alpha).data();
+            batch.velocity_x = pool.get(particle_channel::velocity_x).data();
+            batch.velocity_y = pool.get(particle_channel::velocity_y).data();
+            batch.lead_seconds = lead_seconds;
+            batch.count = pool.size();
+
+            renderer->quads_draw_world(sprite, batch);
+        }
+    }
+
+    game_particle_stats system_particles::get_stats(const entt::registry& registry) {
+        return registry.ctx().get<particles_state>().stats;
+    }
+
+    const game_particle_pool* system_particles::get_pool(const entt::registry& registry,
+                                                         const entt::entity entity) {
+        const particles_state& state = registry.ctx().get<particles_state>();
+        const auto index = static_cast<std::size_t>(entt::to_entity(entity));
+        if (index >= state.indices.size() || state.indices[index] == no_emitter ||
+            state.emitters[state.indices[index]].owner != entity) {
+            return nullptr;
+        }
+
+        return &state.emitters[state.indices[index]].pool;
     }
 }  // namespace engine
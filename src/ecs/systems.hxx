@@ -1,35 +1,693 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
 #include <entt/entt.hpp>
+#include "aabb_tree.hxx"
 #include "components.hxx"
+#include "contact_solver.hxx"
+#include "flow_field.hxx"
+#include "neighborhood.hxx"
+#include "particles.hxx"
+#include "tile_grid.hxx"
+#include "physics_kernels.hxx"
 
 namespace engine {
     class game_renderer;
     class game_resources;
+    class game_workers;
+    class game_entities;
 
+    /**
+     * @brief Callback run by a scheduled timer on the entity it was scheduled for.
+     */
+    using game_entity_callback = void (*)(game_entities& entities, entt::entity entity,
+                                          void* user_data);
+
+    /**
+     * @brief Identifies a scheduled callback so it can be cancelled.
+     * @note Stays safe to use after the timer fired or was cancelled.
+     */
+    struct game_timer_handle {
+        std::uint32_t slot = UINT32_MAX;
+        std::uint32_t generation = 0;
+    };
+
+    /**
+     * @brief Tunables for `system_physics`, owned by `game_entities`.
+     */
+    struct system_physics_settings {
+        /**
+         * @brief Integration kernel, `automatic` picks the widest one the CPU supports.
+         * @note `deterministic` makes ticks reproducible across builds for lockstep and replays,
+         *       and turns update-rate LOD off.
+         */
+        physics_kernel kernel = physics_kernel::automatic;
+
+        /**
+         * @brief Pool to spread integration over, or null to stay on the calling thread.
+         * @note Results are identical for any pool size.
+         */
+        game_workers* workers = nullptr;
+
+        /**
+         * @brief Bodies per parallel task, rounded up so every chunk starts on a cache line.
+         */
+        std::size_t parallel_chunk_size = 4096;
+
+        /**
+         * @brief Speeds at or below these count as resting, in units and degrees per second.
+         */
+        float sleep_linear_threshold = 1.0f;
+        float sleep_angular_threshold = 1.0f;
+
+        /**
+         * @brief Consecutive resting ticks before a body falls asleep, 0 disables sleeping.
+         * @note Only bodies with a linear velocity fall asleep. Sleeping bodies are tagged with
+         *       `component_sleeping` and skipped until `game_entities` wakes them.
+         */
+        std::uint32_t sleep_ticks = 64;
+
+        /**
+         * @brief Step interpolated bodies far from every focus point less often.
+         * @note Bodies beyond `lod_distances[k]` from the nearest focus are stepped every 2, 4 or
+         *       8 ticks over the accumulated interval. Each body is phased by its entity index, so
+         *       every tick steps the same share of a bucket. With no focus points every body is
+         *       stepped each tick. Sleep counts steps rather than ticks.
+         */
+        bool is_lod_enabled = false;
+        std::array<float, 3> lod_distances = {2000.0f, 4000.0f, 8000.0f};
+
+        /**
+         * @brief World positions the LOD distances are measured from, usually the cameras of the
+         *        active scene, which `game_scenes` refreshes every tick.
+         */
+        std::vector<glm::vec2> lod_focus;
+    };
+
+    /**
+     * @brief Number of moving bodies that `system_physics` integrates or skips.
+     */
+    struct system_physics_counts {
+        std::size_t awake = 0;
+        std::size_t sleeping = 0;
+    };
+
+    /**
+     * @brief Physics system that integrates linear and angular velocities.
+     * @note Bodies are walked through one owning group so that transforms and linear velocities
+     *       sit in lockstep packed arrays. The group and the angular velocity and interpolation
+     *       storages are sorted together whenever bodies come, go or change shape, so the kernels
+     *       read every component straight from its pages. The group claims the transform and
+     *       linear velocity storages, so no other owning group may be created over these
+     *       components.
+     */
     class system_physics {
     public:
-        static void update(entt::registry& registry, float tick_interval);
+        /**
+         * @brief Set up the tick counter that update-rate LOD is phased by.
+         * @note Must run before the first update, `game_entities` does this for you.
+         */
+        static void attach(entt::registry& registry);
+
+        static void update(entt::registry& registry, float tick_interval,
+                           const system_physics_settings& settings = {});
+
+        [[nodiscard]] static system_physics_counts count_bodies(entt::registry& registry);
+
+        /**
+         * @brief Hash of every transform, velocity and sleeping tag, to check after each tick
+         *        that lockstep peers or a replay still agree.
+         * @note Bodies are combined regardless of storage order, so registries holding the same
+         *       entities in the same state hash alike however they were filled.
+         */
+        [[nodiscard]] static std::uint64_t hash_state(const entt::registry& registry);
 
     private:
-        static void integrate_velocity(entt::registry& registry, float tick_interval);
+        static void integrate_velocity(entt::registry& registry, float tick_interval,
+                                       const system_physics_settings& settings);
+    };
+
+    /**
+     * @brief Composes the world transforms of attached entities.
+     *
+     * Attached entities are kept sorted depth-first in the `component_hierarchy` storage, so every
+     * parent is composed before its children and the pass is one linear sweep. An entity is only
+     * recomputed when its local transform or its parent's world transform differs from the ones
+     * it was last composed from, so still subtrees cost a comparison each.
+     */
+    class system_hierarchy {
+    public:
+        /**
+         * @brief Start tracking structural changes to `component_hierarchy`.
+         * @note Must run before the first entity is attached, `game_entities` does this for you.
+         */
+        static void attach(entt::registry& registry);
+
+        /**
+         * @brief Snapshot last tick's world transforms and compose the new ones.
+         * @note Children whose parent was destroyed are detached where they stand.
+         */
+        static void update(entt::registry& registry);
+
+        /**
+         * @brief Make `child` follow `parent`, its transform becoming the offset from the parent.
+         * @return False if either entity has no transform or `child` is an ancestor of `parent`.
+         */
+        static bool attach_child(entt::registry& registry, entt::entity child, entt::entity parent,
+                                 bool is_rotation_inherited, bool is_scale_inherited);
+
+        /**
+         * @brief Detach `child` from its parent, keeping it at its current world transform.
+         */
+        static void detach_child(entt::registry& registry, entt::entity child);
+
+        /**
+         * @brief World transform of any entity, its own transform if it is not attached.
+         */
+        [[nodiscard]] static const component_transform& get_world(const entt::registry& registry,
+                                                                  entt::entity entity);
     };
 
     /**
      * @brief Rendering system for sprites with ECS components
-     * @note currently only renders entities with sprites and with interpolated transform components
+     * @note Draws every enabled entity with a transform, a `component_renderable` and a sprite or
+     *       dynamic text, whether it is interpolated, attached to a parent or still.
+     *
+     * Drawable entities are kept in persistent render lists with their sprite or text already
+     * looked up. Registry signals record which entities changed, and only those are revisited
+     * before drawing, so preparing a frame costs in proportion to what changed since the last
+     * one. Replace `component_sprite` or `component_text_dynamic` through the registry when
+     * changing their key, writes in place are not noticed.
+     *
+     * Each frame every listed entity's transform is blended to the frame in one packed pass
+     * before anything is drawn, sprites and texts alike, so the draw loops only read the result.
      */
     class system_renderer {
     public:
+        /**
+         * @brief Create the render lists and start listening for changes.
+         * @note Must run before the first drawable entity is created, `game_entities` does this
+         *       for you.
+         */
+        static void attach(entt::registry& registry);
+
+        /**
+         * @brief Apply the changes recorded since the last call to the render lists.
+         * @note Called by `update`, exposed to measure or warm up render preparation.
+         */
+        static void prepare(entt::registry& registry, game_resources& resources);
+
+        /**
+         * @brief Apply the recorded changes without looking up sprites and texts, which the next
+         *        call with resources does. For measuring without a renderer.
+         */
+        static void prepare(entt::registry& registry);
+
+        /**
+         * @brief Blend the transform of every listed entity to `fraction_to_next_tick` into the
+         *        render transforms that drawing reads.
+         * @note Called by `update` after `prepare`, exposed to measure the pass on its own.
+         */
+        static void interpolate(entt::registry& registry, float fraction_to_next_tick);
+
         static void update(entt::registry& registry, game_renderer* renderer,
                            game_resources& resources, float fraction_to_next_tick);
+
+        /**
+         * @brief Number of entities changed since the last `prepare`, each counted once.
+         */
+        [[nodiscard]] static std::size_t count_pending(const entt::registry& registry);
     };
 
     /**
-     * @brief Lifetime system that handles entity expiration
+     * @brief Lifetime system that handles entity expiration and scheduled callbacks.
+     *
+     * Both are filed into one timing wheel by expiry tick, so a tick only touches the lifetimes
+     * and callbacks that are actually due. Seconds are turned into ticks on the first update
+     * after scheduling, rounding up, so the tick interval may change between scenes.
      */
     class system_lifetime {
     public:
+        /**
+         * @brief Create the wheel and start listening for `component_lifetime` changes.
+         * @note Must run before the first lifetime is added, `game_entities` does this for you.
+         */
+        static void attach(entt::registry& registry);
+
+        static void update(game_entities& entities, float tick_interval);
+
+        /**
+         * @brief Seconds until the lifetime of `entity` runs out, 0 if it has none.
+         * @note Counted in whole ticks of the latest update. A lifetime added or replaced since
+         *       then reports its `remaining_seconds` as given.
+         */
+        [[nodiscard]] static float get_remaining(const entt::registry& registry,
+                                                 entt::entity entity);
+
+        static game_timer_handle schedule(entt::registry& registry, entt::entity entity,
+                                          float seconds, bool is_repeating,
+                                          game_entity_callback callback, void* user_data);
+        static void cancel(entt::registry& registry, game_timer_handle handle);
+    };
+
+    /**
+     * @brief Usage statistics of one entity pool.
+     */
+    struct game_pool_stats {
+        std::size_t capacity = 0;    ///< Entities owned by the pool, active or released.
+        std::size_t active = 0;      ///< Entities spawned and not yet released.
+        std::size_t high_water = 0;  ///< Most entities that were active at once.
+        std::uint64_t spawned = 0;
+        std::uint64_t reused = 0;  ///< Spawns served by a released entity instead of a new one.
+        std::uint64_t released = 0;
+    };
+
+    /**
+     * @brief Bookkeeping for pools of entities that are disabled and reused instead of destroyed.
+     *
+     * Each pool is named by a key and tracks its released entities in a free list. Releasing tags
+     * the entity with `component_disabled`, which every system excludes, and spawning removes the
+     * tag again, so components and storage slots survive the round trip.
+     */
+    class system_pool {
+    public:
+        /**
+         * @brief Create the pool table and start tracking destroyed pooled entities.
+         * @note Must run before the first entity is pooled, `game_entities` does this for you.
+         */
+        static void attach(entt::registry& registry);
+
+        /**
+         * @brief Take a released entity from the pool named `key` and enable it.
+         * @return The entity with its velocities at rest, or null if nothing was released.
+         */
+        [[nodiscard]] static entt::entity acquire(entt::registry& registry, std::string_view key);
+
+        /**
+         * @brief Hand ownership of a new entity to the pool named `key`.
+         * @param is_active Whether the entity counts as spawned, or goes straight to the free list.
+         */
+        static void adopt(entt::registry& registry, entt::entity entity, std::string_view key,
+                          bool is_active = true);
+
+        /**
+         * @brief Disable a pooled entity and return it to its pool.
+         * @note Velocities are zeroed and `component_lifetime` is removed, since neither should
+         *       carry over into the next spawn. Does nothing for entities that are not pooled.
+         */
+        static void release(entt::registry& registry, entt::entity entity);
+
+        [[nodiscard]] static game_pool_stats get_stats(const entt::registry& registry,
+                                                       std::string_view key);
+    };
+
+    /**
+     * @brief Two colliders whose bounding boxes overlap and whose layers accept each other.
+     */
+    struct game_collision_pair {
+        entt::entity first = entt::null;
+        entt::entity second = entt::null;
+    };
+
+    /**
+     * @brief The first collider a continuous collider touched during the last tick.
+     */
+    struct game_collision_contact {
+        entt::entity first = entt::null;  ///< The continuous collider.
+        entt::entity second = entt::null;
+        float time = 0.0f;  ///< Fraction of the tick, 0 at the previous position, 1 at the current.
+        glm::vec2 position = {0.0f, 0.0f};  ///< Where `first` was when they touched.
+        glm::vec2 normal = {0.0f, 0.0f};    ///< Unit length, pointing from `second` to `first`.
+    };
+
+    /**
+     * @brief Spatial hash broadphase over `component_collider`.
+     *
+     * Each collider is filed into every grid cell its bounds touch, enlarged by a margin, and
+     * each cell keeps copies of its occupants' bounds and layers in a flat array. Only moved
+     * colliders are looked at: awake bodies with a linear velocity are checked every update and
+     * re-filed once they leave their enlarged bounds, everything else only after its collider
+     * changed, it was moved through `game_entities` or it was marked with `mark_moved`.
+     *
+     * Pairs are reported when the enlarged bounds overlap, so they are candidates for an exact
+     * test rather than contacts.
+     *
+     * Colliders tagged `component_continuous` are also swept from their previous position to
+     * their current one through the cells along the way, and the earliest time of impact with an
+     * exact shape is reported as a contact, on the tick they were stepped under update-rate LOD.
+     * Other colliders are taken where they are at the end of the tick.
+     */
+    class system_collision {
+    public:
+        /**
+         * @brief Create the grid and start tracking added, removed and disabled colliders.
+         * @note Must run before the first collider is added, `game_entities` does this for you.
+         */
+        static void attach(entt::registry& registry);
+
+        /**
+         * @brief Resize the grid and re-file every collider.
+         * @param cell_size Works best at a few times the typical collider, 256 by default.
+         * @param margin How far a collider may move before it is re-filed. Larger margins re-file
+         *        less often but report more candidates, 8 by default.
+         */
+        static void set_grid(entt::registry& registry, float cell_size, float margin);
+
+        /**
+         * @brief Re-file a collider on the next update, after its transform was written directly.
+         */
+        static void mark_moved(entt::registry& registry, entt::entity entity);
+
+        /**
+         * @brief Re-file moved colliders and collect this update's candidate pairs.
+         */
+        static void update(entt::registry& registry);
+
+        /**
+         * @brief Candidate pairs found by the last update, each reported once.
+         */
+        [[nodiscard]] static std::span<const game_collision_pair> get_pairs(
+            const entt::registry& registry);
+
+        /**
+         * @brief Contacts of continuous colliders found by the last update, at most one each.
+         */
+        [[nodiscard]] static std::span<const game_collision_contact> get_contacts(
+            const entt::registry& registry);
+    };
+
+    /**
+     * @brief Stops moving colliders at the solid tiles of a `game_tile_grid`.
+     *
+     * Runs after physics moved everything: each awake, unattached collider with a linear velocity
+     * is moved again from where it started the tick, one axis at a time against the grid, and
+     * stops flush with the first solid tile in its way, losing its velocity along that axis so it
+     * slides along walls. Colliders are tested as their bounding box, and only against the tiles
+     * they cross, so static geometry costs nothing per wall.
+     */
+    class system_tiles {
+    public:
+        /**
+         * @brief Create the empty grid.
+         * @note Must run before the first update, `game_entities` does this for you.
+         */
+        static void attach(entt::registry& registry);
+
+        /**
+         * @brief Pull back this tick's movement of colliders that ran into solid tiles.
+         * @note Runs after `system_physics::update`, with the same tick interval.
+         */
         static void update(entt::registry& registry, float tick_interval);
+
+        [[nodiscard]] static game_tile_grid& get_grid(entt::registry& registry);
+        [[nodiscard]] static const game_tile_grid& get_grid(const entt::registry& registry);
+
+        /**
+         * @brief Layers the tiles are on, colliders whose mask shares none of them pass through.
+         *        1 by default.
+         */
+        static void set_layers(entt::registry& registry, std::uint32_t layers);
+
+        /**
+         * @brief Colliders stopped by a tile during the last update.
+         */
+        [[nodiscard]] static std::span<const entt::entity> get_blocked(
+            const entt::registry& registry);
+    };
+
+    /**
+     * @brief What the last `system_solver::update` worked on.
+     */
+    struct game_solver_stats {
+        std::size_t contacts = 0;      ///< Touching pairs solved, resting islands excluded.
+        std::size_t warm_started = 0;  ///< Contacts that carried their impulses over.
+        std::size_t islands = 0;       ///< Groups of bodies touching each other, asleep or not.
+        std::size_t woken = 0;         ///< Sleeping bodies woken by an awake island.
+    };
+
+    /**
+     * @brief Resolves contacts between rigid bodies, see `component_body`.
+     *
+     * The broadphase candidates of the last collision update are tested exactly, and the touching
+     * ones are solved by a `game_contact_solver` that persists in the registry context, so
+     * contacts that last are warm started. Colliders are axis aligned, so only circles spin.
+     *
+     * Bodies touching each other form islands. An island with any awake body wakes all of its
+     * members, an island where every body sleeps is left out of the solve, and the members of an
+     * island share their resting ticks so that `system_physics` puts them to sleep together.
+     */
+    class system_solver {
+    public:
+        /**
+         * @brief Create the solver.
+         * @note Must run before the first update, `game_entities` does this for you.
+         */
+        static void attach(entt::registry& registry);
+
+        /**
+         * @brief Solve the contacts among the last collision update's pairs, changing velocities.
+         * @note Runs after `system_collision::update`, positions catch up on the next physics
+         *       update.
+         */
+        static void update(entt::registry& registry, float tick_interval,
+                           const game_solver_settings& settings = {});
+
+        [[nodiscard]] static game_solver_stats get_stats(const entt::registry& registry);
+    };
+
+    /**
+     * @brief Keeps a `game_aabb_tree` of every enabled entity with a `component_transform`, for
+     *        region, point and ray queries.
+     *
+     * Bounds follow the entity's sprite as it is drawn, scaled and rotated about its origin, fall
+     * back to its collider while the sprite is missing or unknown, and shrink to its position for
+     * anything else. Like the broadphase, only moved entities are looked at: awake bodies with a
+     * velocity and attached entities every update, everything else after its components
+     * changed, it was moved through `game_entities` or it was marked with `mark_moved`.
+     */
+    class system_spatial {
+    public:
+        /**
+         * @brief Create the tree and start tracking added, removed and disabled entities.
+         * @note Must run before the first transform is added, `game_entities` does this for you.
+         */
+        static void attach(entt::registry& registry);
+
+        /**
+         * @brief Where sprite sizes are looked up, until then every entity is sized by its
+         *        collider or as a point. Scenes set their own resources.
+         */
+        static void set_resources(entt::registry& registry, game_resources* resources);
+
+        /**
+         * @brief How far an entity may move before it is re-inserted, and re-insert everything.
+         * @note Larger margins re-insert less often but make queries visit more of the tree,
+         *       16 by default.
+         */
+        static void set_margin(entt::registry& registry, float margin);
+
+        /**
+         * @brief Refit an entity on the next update, after its transform was written directly.
+         */
+        static void mark_moved(entt::registry& registry, entt::entity entity);
+
+        /**
+         * @brief Refit moved entities to their current bounds.
+         */
+        static void update(entt::registry& registry);
+
+        /**
+         * @brief The tree as of the last update, destroyed entities are removed right away.
+         */
+        [[nodiscard]] static const game_aabb_tree& get_tree(const entt::registry& registry);
+    };
+
+    /**
+     * @brief Tunables for `system_flocking`, owned by `game_entities`.
+     */
+    struct system_flocking_settings {
+        /**
+         * @brief How far agents see each other, also the cell size of the neighbourhood index.
+         */
+        float radius = 64.0f;
+
+        /**
+         * @brief Weights of keeping clear of neighbours, matching their heading and closing in
+         *        on their centre, each a share of `max_acceleration`.
+         */
+        float separation = 1.5f;
+        float alignment = 1.0f;
+        float cohesion = 1.0f;
+
+        float max_speed = 150.0f;         ///< Units per second.
+        float max_acceleration = 300.0f;  ///< Units per second squared.
+
+        /**
+         * @brief Most neighbours an agent steers by, 0 for all of them. Bounds the cost of
+         *        agents packed into a clump.
+         */
+        std::uint32_t max_neighbors = 32;
+
+        /**
+         * @brief Pool to spread steering over, or null to stay on the calling thread.
+         * @note Results are identical for any pool size.
+         */
+        game_workers* workers = nullptr;
+
+        /**
+         * @brief Agents per parallel task, taken as runs of the index so tasks cover whole cells
+         *        most of the time.
+         */
+        std::size_t parallel_chunk_size = 2048;
+    };
+
+    /**
+     * @brief Work done by the last flocking update.
+     */
+    struct game_flocking_stats {
+        std::size_t agents = 0;
+        std::size_t neighbors = 0;  ///< Over every agent, after `max_neighbors`.
+    };
+
+    /**
+     * @brief Steers agents with `component_flock` by separation, alignment and cohesion.
+     *
+     * Every update re-indexes the agents in a `game_neighborhood` and gathers the neighbours of
+     * runs of its slots in parallel. Agents are steered from the velocities they had before the
+     * update, so the order runs are done in never shows in the results.
+     */
+    class system_flocking {
+    public:
+        static void attach(entt::registry& registry);
+
+        /**
+         * @brief Add this tick's steering to the linear velocity of every awake agent.
+         * @note Attached, sleeping and disabled agents are neither steered nor seen.
+         */
+        static void update(entt::registry& registry, float tick_interval,
+                           const system_flocking_settings& settings = {});
+
+        [[nodiscard]] static game_flocking_stats get_stats(const entt::registry& registry);
+
+        /**
+         * @brief The agents as of the last update, which other AI may query too.
+         * @note Slots index into the agents of that update, see `get_agent`.
+         */
+        [[nodiscard]] static const game_neighborhood& get_neighborhood(
+            const entt::registry& registry);
+
+        /**
+         * @brief Entity of a slot of the neighbourhood.
+         */
+        [[nodiscard]] static entt::entity get_agent(const entt::registry& registry,
+                                                    std::uint32_t slot);
+    };
+
+    /**
+     * @brief Tunables for `system_flow`, owned by `game_entities`.
+     */
+    struct system_flow_settings {
+        /**
+         * @brief Pool to build flow fields on, one field per task, or null to stay on the calling
+         *        thread.
+         */
+        game_workers* workers = nullptr;
+    };
+
+    /**
+     * @brief Walks agents with `component_flow_agent` to their destinations over the navigation
+     *        grid of a `game_flow_fields`.
+     *
+     * Agents heading to the same tile share one field, so the cost of pathfinding follows the
+     * number of destinations rather than the number of agents. Each agent moves at its speed
+     * along the step of the tile it stands on, and once on the tile of its destination heads
+     * straight for it, stopping there. Agents off the grid or cut off from their destination
+     * stand still.
+     */
+    class system_flow {
+    public:
+        /**
+         * @brief Create the empty navigation grid.
+         * @note Must run before the first update, `game_entities` does this for you.
+         */
+        static void attach(entt::registry& registry);
+
+        /**
+         * @brief Build the fields agents need, then set the linear velocity of every awake agent.
+         * @note Attached, sleeping and disabled agents are left alone.
+         */
+        static void update(entt::registry& registry, float tick_interval,
+                           const system_flow_settings& settings = {});
+
+        [[nodiscard]] static game_flow_fields& get_fields(entt::registry& registry);
+        [[nodiscard]] static const game_flow_fields& get_fields(const entt::registry& registry);
+    };
+
+    /**
+     * @brief Tunables for `system_particles`, owned by `game_entities`.
+     */
+    struct system_particles_settings {
+        /**
+         * @brief Most particles alive at once over every emitter. Spawns past it, or past the
+         *        budget of their emitter, are dropped.
+         */
+        std::size_t max_particles = 65536;
+
+        /**
+         * @brief Pool to simulate emitters on, one emitter per task, or null to stay on the
+         *        calling thread.
+         */
+        game_workers* workers = nullptr;
+    };
+
+    /**
+     * @brief Work done by the last particles update.
+     */
+    struct game_particle_stats {
+        std::size_t emitters = 0;   ///< Pools simulated, including those of destroyed emitters.
+        std::size_t particles = 0;  ///< Alive after the update.
+        std::size_t spawned = 0;
+        std::size_t dropped = 0;  ///< Spawns refused by a budget.
+    };
+
+    /**
+     * @brief Spawns, simulates and draws the particles of every `component_emitter`.
+     *
+     * Each emitter owns a `game_particle_pool`, so particles never touch the registry: a tick is
+     * one pass over the arrays of each pool and a frame is one geometry call per emitter. Pools
+     * of destroyed emitters keep simulating until their last particle expires.
+     */
+    class system_particles {
+    public:
+        /**
+         * @brief Create the pools and start tracking destroyed emitters.
+         * @note Must run before the first emitter is added, `game_entities` does this for you.
+         */
+        static void attach(entt::registry& registry);
+
+        /**
+         * @brief Spawn from every enabled emitter within the budgets, then step every pool.
+         */
+        static void update(entt::registry& registry, float tick_interval,
+                           const system_particles_settings& settings = {});
+
+        /**
+         * @brief Draw every pool as one batch, led along particle velocities by the fraction of
+         *        a tick since the last update.
+         */
+        static void draw(const entt::registry& registry, game_renderer* renderer,
+                         game_resources& resources, float fraction_to_next_tick);
+
+        [[nodiscard]] static game_particle_stats get_stats(const entt::registry& registry);
+
+        /**
+         * @brief Pool of an emitter, or null before its first update.
+         */
+        [[nodiscard]] static const game_particle_pool* get_pool(const entt::registry& registry,
+                                                                entt::entity entity);
     };
 }  // namespace engine
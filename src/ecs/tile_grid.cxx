@@ -0,0 +1,293 @@
+/**
+ * @file tile_grid.cxx
+ * @brief Chunked tile grid implementation.
+ */
+
+#include "tile_grid.hxx"
+
+#include <algorithm>
+#include <bit>
+
+namespace engine {
+    namespace {
+        constexpr int chunk_shift = 6;
+        constexpr int chunk_mask = game_tile_grid::chunk_size - 1;
+
+        static_assert(game_tile_grid::chunk_size == 1 << chunk_shift,
+                      "A chunk row must be exactly one 64 bit word.");
+
+        /**
+         * @brief Share of a tile by which boxes are shrunk when tested, so a box resting flush
+         *        against a tile is not taken to overlap it through rounding.
+         */
+        constexpr float tile_skin = 1e-3f;
+
+        std::uint64_t get_chunk_key(const int x, const int y) {
+            return (std::uint64_t{static_cast<std::uint32_t>(x)} << 32) |
+                   static_cast<std::uint32_t>(y);
+        }
+
+        /**
+         * @brief Bits `first` to `last` inclusive of a row word.
+         */
+        std::uint64_t get_span_mask(const int first, const int last) {
+            return (~std::uint64_t{0} >> (chunk_mask - last)) & (~std::uint64_t{0} << first);
+        }
+
+        /**
+         * @brief Rounding through truncation, which unlike `std::floor` needs no library call
+         *        without SSE4.1.
+         */
+        int floor_to_int(const float value) {
+            const int truncated = static_cast<int>(value);
+            return truncated - static_cast<int>(value < static_cast<float>(truncated));
+        }
+
+        int ceil_to_int(const float value) {
+            const int truncated = static_cast<int>(value);
+            return truncated + static_cast<int>(value > static_cast<float>(truncated));
+        }
+    }  // namespace
+
+    void game_tile_grid::set_tile_size(const float tile_size) noexcept {
+        if (tile_size <= 0.0f) {
+            return;
+        }
+
+        m_tile_size = tile_size;
+        m_inverse_tile_size = 1.0f / tile_size;
+    }
+
+    void game_tile_grid::set_solid(const glm::ivec2& tile, const bool is_solid) {
+        fill(tile, tile, is_solid);
+    }
+
+    void game_tile_grid::fill(const glm::ivec2& min, const glm::ivec2& max, const bool is_solid) {
+        for (int y = min.y; y <= max.y; ++y) {
+            for (int chunk_x = min.x >> chunk_shift; chunk_x <= max.x >> chunk_shift; ++chunk_x) {
+                const int base = chunk_x * chunk_size;
+                const std::uint64_t mask = get_span_mask(std::max(min.x, base) - base,
+                                                         std::min(max.x, base + chunk_mask) - base);
+
+                if (is_solid == true) {
+                    get_or_create_chunk(chunk_x, y >> chunk_shift).rows[y & chunk_mask] |= mask;
+                    continue;
+                }
+
+                // Clearing never creates chunks, and emptied ones are kept for the next fill.
+                const auto found = m_chunk_indices.find(get_chunk_key(chunk_x, y >> chunk_shift));
+                if (found != m_chunk_indices.end()) {
+                    m_chunks[found->second].rows[y & chunk_mask] &= ~mask;
+                }
+            }
+        }
+    }
+
+    bool game_tile_grid::is_solid(const glm::ivec2& tile) const {
+        const chunk* found = find_chunk(tile.x >> chunk_shift, tile.y >> chunk_shift);
+        return found != nullptr &&
+               (found->rows[tile.y & chunk_mask] >> (tile.x & chunk_mask) & 1) != 0;
+    }
+
+    bool game_tile_grid::is_area_solid(const glm::vec2& min, const glm::vec2& max) const {
+        const glm::ivec2 columns = get_tile_span(min.x, max.x);
+        const glm::ivec2 rows = get_tile_span(min.y, max.y);
+
+        for (int y = rows.x; y <= rows.y; ++y) {
+            if (is_row_solid(y, columns.x, columns.y) == true) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    game_tile_move game_tile_grid::move(const glm::vec2& center, const glm::vec2& half_size,
+                                        const glm::vec2& motion) const {
+        game_tile_move result = {center};
+
+        if (motion.x != 0.0f) {
+            result.center.x =
+                move_along_x(result.center, half_size, motion.x, result.is_blocked_x);
+        }
+
+        if (motion.y != 0.0f) {
+            result.center.y =
+                move_along_y(result.center, half_size, motion.y, result.is_blocked_y);
+        }
+
+        return result;
+    }
+
+    void game_tile_grid::clear() {
+        m_chunk_indices.clear();
+        m_chunks.clear();
+    }
+
+    const game_tile_grid::chunk* game_tile_grid::find_chunk(const int chunk_x,
+                                                            const int chunk_y) const {
+        const auto found = m_chunk_indices.find(get_chunk_key(chunk_x, chunk_y));
+        return found != m_chunk_indices.end() ? &m_chunks[found->second] : nullptr;
+    }
+
+    game_tile_grid::chunk& game_tile_grid::get_or_create_chunk(const int chunk_x,
+                                                               const int chunk_y) {
+        const auto [found, is_new] = m_chunk_indices.try_emplace(
+            get_chunk_key(chunk_x, chunk_y), static_cast<std::uint32_t>(m_chunks.size()));
+        if (is_new == true) {
+            m_chunks.emplace_back();
+        }
+
+        return m_chunks[found->second];
+    }
+
+    bool game_tile_grid::find_solid_in_row(const int y, const int first, const int last,
+                                           int& found) const {
+        const int chunk_y = y >> chunk_shift;
+        const int row = y & chunk_mask;
+
+        if (first <= last) {
+            for (int chunk_x = first >> chunk_shift; chunk_x <= last >> chunk_shift; ++chunk_x) {
+                const chunk* tiles = find_chunk(chunk_x, chunk_y);
+                if (tiles == nullptr) {
+                    continue;
+                }
+
+                const int base = chunk_x * chunk_size;
+                const std::uint64_t bits =
+                    tiles->rows[row] & get_span_mask(std::max(first, base) - base,
+                                                     std::min(last, base + chunk_mask) - base);
+                if (bits != 0) {
+                    found = base + std::countr_zero(bits);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        for (int chunk_x = first >> chunk_shift; chunk_x >= last >> chunk_shift; --chunk_x) {
+            const chunk* tiles = find_chunk(chunk_x, chunk_y);
+            if (tiles == nullptr) {
+                continue;
+            }
+
+            const int base = chunk_x * chunk_size;
+            const std::uint64_t bits =
+                tiles->rows[row] & get_span_mask(std::max(last, base) - base,
+                                                 std::min(first, base + chunk_mask) - base);
+            if (bits != 0) {
+                found = base + chunk_mask - std::countl_zero(bits);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    float game_tile_grid::move_along_x(const glm::vec2& center, const glm::vec2& half_size,
+                                       const float motion, bool& is_blocked) const {
+        const float skin = m_tile_size * tile_skin;
+
+        // Each covered row is scanned for its nearest solid tile among the columns entered, the
+        // search narrowing to what is nearer than the best found so far. Most moves enter none.
+        if (motion > 0.0f) {
+            const float edge = center.x + half_size.x;
+            const int first = ceil_to_int((edge - skin) * m_inverse_tile_size);
+            const int last = ceil_to_int((edge + motion - skin) * m_inverse_tile_size) - 1;
+            if (first > last) {
+                return center.x + motion;
+            }
+
+            const glm::ivec2 rows = get_tile_span(center.y - half_size.y, center.y + half_size.y);
+            int nearest = last + 1;
+            for (int y = rows.x; y <= rows.y && first < nearest; ++y) {
+                int found = 0;
+                if (find_solid_in_row(y, first, nearest - 1, found) == true) {
+                    nearest = found;
+                }
+            }
+
+            is_blocked = nearest <= last;
+            return is_blocked == true ? (static_cast<float>(nearest) * m_tile_size) - half_size.x
+                                      : center.x + motion;
+        }
+
+        const float edge = center.x - half_size.x;
+        const int first = floor_to_int((edge + skin) * m_inverse_tile_size) - 1;
+        const int last = floor_to_int((edge + motion + skin) * m_inverse_tile_size);
+        if (first < last) {
+            return center.x + motion;
+        }
+
+        const glm::ivec2 rows = get_tile_span(center.y - half_size.y, center.y + half_size.y);
+        int nearest = last - 1;
+        for (int y = rows.x; y <= rows.y && first > nearest; ++y) {
+            int found = 0;
+            if (find_solid_in_row(y, first, nearest + 1, found) == true) {
+                nearest = found;
+            }
+        }
+
+        is_blocked = nearest >= last;
+        return is_blocked == true ? (static_cast<float>(nearest + 1) * m_tile_size) + half_size.x
+                                  : center.x + motion;
+    }
+
+    float game_tile_grid::move_along_y(const glm::vec2& center, const glm::vec2& half_size,
+                                       const float motion, bool& is_blocked) const {
+        const float skin = m_tile_size * tile_skin;
+
+        // Rows are entered one after the other, each tested as a masked word per chunk.
+        if (motion > 0.0f) {
+            const float edge = center.y + half_size.y;
+            const int first = ceil_to_int((edge - skin) * m_inverse_tile_size);
+            const int last = ceil_to_int((edge + motion - skin) * m_inverse_tile_size) - 1;
+            if (first > last) {
+                return center.y + motion;
+            }
+
+            const glm::ivec2 columns =
+                get_tile_span(center.x - half_size.x, center.x + half_size.x);
+            for (int y = first; y <= last; ++y) {
+                if (is_row_solid(y, columns.x, columns.y) == true) {
+                    is_blocked = true;
+                    return (static_cast<float>(y) * m_tile_size) - half_size.y;
+                }
+            }
+
+            return center.y + motion;
+        }
+
+        const float edge = center.y - half_size.y;
+        const int first = floor_to_int((edge + skin) * m_inverse_tile_size) - 1;
+        const int last = floor_to_int((edge + motion + skin) * m_inverse_tile_size);
+        if (first < last) {
+            return center.y + motion;
+        }
+
+        const glm::ivec2 columns = get_tile_span(center.x - half_size.x, center.x + half_size.x);
+        for (int y = first; y >= last; --y) {
+            if (is_row_solid(y, columns.x, columns.y) == true) {
+                is_blocked = true;
+                return (static_cast<float>(y + 1) * m_tile_size) + half_size.y;
+            }
+        }
+
+        return center.y + motion;
+    }
+
+    bool game_tile_grid::is_row_solid(const int y, const int min, const int max) const {
+        int found = 0;
+        return find_solid_in_row(y, min, max, found);
+    }
+
+    glm::ivec2 game_tile_grid::get_tile_span(const float min, const float max) const noexcept {
+        // Shrunk by the skin, so boxes flush against a tile do not cover it.
+        const float skin = m_tile_size * tile_skin;
+        const int first = floor_to_int((min + skin) * m_inverse_tile_size);
+        const int last = ceil_to_int((max - skin) * m_inverse_tile_size) - 1;
+
+        return {first, std::max(first, last)};
+    }
+}  // namespace engine
@@ -0,0 +1,136 @@
+/**
+ * @file tile_grid.hxx
+ * @brief Chunked, bit-packed grid of solid tiles for top-down worlds.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace engine {
+    /**
+     * @brief Where `game_tile_grid::move` left a box, and the axes it was stopped on.
+     */
+    struct game_tile_move {
+        glm::vec2 center = {0.0f, 0.0f};
+        bool is_blocked_x = false;
+        bool is_blocked_y = false;
+    };
+
+    /**
+     * @brief Unbounded grid of square tiles that are either solid or empty.
+     *
+     * Tiles are stored one bit each, in chunks of 64 x 64 that hold one 64 bit word per row and
+     * are created when a tile in them first turns solid. Tests over a span of a row are a mask
+     * and a bit scan per chunk crossed, so a box is tested against the tiles it covers, never
+     * against the walls one by one, and a large map costs a few bits per tile it spans.
+     *
+     * Tile `(x, y)` covers world positions from `(x, y) * tile_size` up to, but not including,
+     * `(x + 1, y + 1) * tile_size`.
+     */
+    class game_tile_grid {
+    public:
+        static constexpr int chunk_size = 64;
+
+        /**
+         * @brief Width of a tile in world units, 32 by default. Tiles keep their coordinates.
+         */
+        void set_tile_size(float tile_size) noexcept;
+        [[nodiscard]] float get_tile_size() const noexcept;
+
+        /**
+         * @brief Tile containing a world position.
+         */
+        [[nodiscard]] glm::ivec2 get_tile(const glm::vec2& position) const noexcept;
+
+        void set_solid(const glm::ivec2& tile, bool is_solid);
+
+        /**
+         * @brief Set every tile from `min` to `max` inclusive, a word at a time.
+         */
+        void fill(const glm::ivec2& min, const glm::ivec2& max, bool is_solid);
+
+        [[nodiscard]] bool is_solid(const glm::ivec2& tile) const;
+
+        /**
+         * @brief Whether any solid tile overlaps the box from `min` to `max`.
+         */
+        [[nodiscard]] bool is_area_solid(const glm::vec2& min, const glm::vec2& max) const;
+
+        /**
+         * @brief Move a box by `motion`, first along x and then along y, stopping flush against
+         *        the first solid tile on each axis.
+         * @note Only tiles the box enters are tested, so a box that starts inside solid tiles is
+         *       free to move out of them.
+         */
+        [[nodiscard]] game_tile_move move(const glm::vec2& center, const glm::vec2& half_size,
+                                          const glm::vec2& motion) const;
+
+        void clear();
+
+        [[nodiscard]] std::size_t get_chunk_count() const noexcept;
+
+        /**
+         * @brief Bytes held by the chunks, which is all the grid stores per tile.
+         */
+        [[nodiscard]] std::size_t get_memory_size() const noexcept;
+
+    private:
+        struct chunk {
+            std::array<std::uint64_t, chunk_size> rows = {};  ///< Bit x of row y is tile (x, y).
+        };
+
+        [[nodiscard]] const chunk* find_chunk(int chunk_x, int chunk_y) const;
+        chunk& get_or_create_chunk(int chunk_x, int chunk_y);
+
+        /**
+         * @brief Move a box along one axis, stopping at the first solid tile it enters.
+         * @return The new centre on that axis.
+         */
+        [[nodiscard]] float move_along_x(const glm::vec2& center, const glm::vec2& half_size,
+                                         float motion, bool& is_blocked) const;
+        [[nodiscard]] float move_along_y(const glm::vec2& center, const glm::vec2& half_size,
+                                         float motion, bool& is_blocked) const;
+
+        /**
+         * @brief Nearest solid tile of row `y` from `first` towards `last`, either way round.
+         * @return Whether one was found, written to `found`.
+         */
+        [[nodiscard]] bool find_solid_in_row(int y, int first, int last, int& found) const;
+
+        /**
+         * @brief Whether any tile of row `y` from `min` to `max` is solid.
+         */
+        [[nodiscard]] bool is_row_solid(int y, int min, int max) const;
+
+        /**
+         * @brief Range of tiles covered by the half-open world span from `min` to `max`.
+         */
+        [[nodiscard]] glm::ivec2 get_tile_span(float min, float max) const noexcept;
+
+        std::unordered_map<std::uint64_t, std::uint32_t> m_chunk_indices;
+        std::vector<chunk> m_chunks;
+        float m_tile_size = 32.0f;
+        float m_inverse_tile_size = 1.0f / 32.0f;
+    };
+
+    inline float game_tile_grid::get_tile_size() const noexcept {
+        return m_tile_size;
+    }
+
+    inline glm::ivec2 game_tile_grid::get_tile(const glm::vec2& position) const noexcept {
+        return glm::ivec2(glm::floor(position * m_inverse_tile_size));
+    }
+
+    inline std::size_t game_tile_grid::get_chunk_count() const noexcept {
+        return m_chunks.size();
+    }
+
+    inline std::size_t game_tile_grid::get_memory_size() const noexcept {
+        return m_chunks.size() * sizeof(chunk);
+    }
+}  // namespace engine
@@ -20,6 +20,8 @@ namespace engine {
           m_window(std::make_unique<game_window>(title, size, game_window_type::resizable)),
           m_renderer(std::make_unique<game_renderer>(m_window->get_laya_window())),
           m_input(std::make_unique<game_input>()),
+          m_workers(std::make_unique<game_workers>(game_workers::default_thread_count())),
+          m_jobs(std::make_unique<game_jobs>()),
           m_scenes(std::make_unique<game_scenes>(this)),
           m_tick_interval_seconds(-1.f),
           m_fraction_to_next_tick(-1.f),
@@ -27,6 +29,8 @@ namespace engine {
         // Set a default icon, can be overridden later.
         m_window->set_icon("assets/helipad/icons/default");
 
+        laya::log_info("Worker pool started with {} threads", m_workers->get_thread_count());
+
         // Set the default tick rate.
         set_tick_rate(32.f);
 
@@ -74,7 +78,16 @@ namespace engine {
             while (seconds_since_last_tick >= m_tick_interval_seconds) [[likely]] {
                 m_scenes->on_engine_tick(m_tick_interval_seconds);
                 invoke_void(m_callbacks.on_tick, this, m_tick_interval_seconds);
+
+                // Sync point: everything deferred during the tick lands before the next one.
+                m_scenes->on_engine_sync();
+
                 seconds_since_last_tick -= m_tick_interval_seconds;
+
+                // Catching up already overruns the frame, so only the last tick runs jobs.
+                if (seconds_since_last_tick < m_tick_interval_seconds) {
+                    m_jobs->run(game_job_phase::tick);
+                }
             }
 
             m_fraction_to_next_tick = seconds_since_last_tick / m_tick_interval_seconds;
@@ -82,6 +95,8 @@ namespace engine {
             m_scenes->on_engine_frame(m_frame_interval_seconds);
             invoke_void(m_callbacks.on_frame, this, m_frame_interval_seconds);
 
+            m_jobs->run(game_job_phase::frame);
+
             m_renderer->draw_begin();
             m_scenes->on_engine_draw(m_fraction_to_next_tick);
             invoke_void(m_callbacks.on_draw, this, m_fraction_to_next_tick);
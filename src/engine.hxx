@@ -16,6 +16,8 @@
 #include "utils/scenes.hxx"
 #include "ecs/entities.hxx"
 #include "utils/timing.hxx"
+#include "utils/workers.hxx"
+#include "utils/jobs.hxx"
 #include <laya/subsystems.hpp>
 
 /**
@@ -110,6 +112,8 @@ namespace engine {
         [[nodiscard]] game_renderer* get_renderer() noexcept;
         [[nodiscard]] game_input* get_input() noexcept;
         [[nodiscard]] game_scenes* get_scenes() noexcept;
+        [[nodiscard]] game_workers* get_workers() noexcept;
+        [[nodiscard]] game_jobs* get_jobs() noexcept;
 
         [[nodiscard]] float get_tick_rate() noexcept;
         void set_tick_rate(float tick_rate_seconds);
@@ -145,6 +149,8 @@ namespace engine {
         std::unique_ptr<game_window> m_window;
         std::unique_ptr<game_renderer> m_renderer;
         std::unique_ptr<game_input> m_input;
+        std::unique_ptr<game_workers> m_workers;  ///< Declared before scenes, which borrow it.
+        std::unique_ptr<game_jobs> m_jobs;
         std::unique_ptr<game_scenes> m_scenes;
 
         float m_tick_interval_seconds;  ///< The amount of time (seconds) between each fixed update.
@@ -174,6 +180,14 @@ namespace engine {
         return m_scenes.get();
     }
 
+    inline game_workers* game_engine::get_workers() noexcept {
+        return m_workers.get();
+    }
+
+    inline game_jobs* game_engine::get_jobs() noexcept {
+        return m_jobs.get();
+    }
+
     inline float game_engine::get_tick_rate() noexcept {
         return ticks_rate_to_interval(m_tick_interval_seconds);
     }
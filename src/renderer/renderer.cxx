@@ -36,7 +36,11 @@ namespace engine {
           m_sdl_text_engine(other.m_sdl_text_engine),
           m_camera(other.m_camera),
           m_viewport(other.m_viewport),
-          m_viewports(std::move(other.m_viewports)) {
+          m_viewports(std::move(other.m_viewports)),
+          m_quad_positions(std::move(other.m_quad_positions)),
+          m_quad_colors(std::move(other.m_quad_colors)),
+          m_quad_uvs(std::move(other.m_quad_uvs)),
+          m_quad_indices(std::move(other.m_quad_indices)) {
         other.m_sdl_text_engine = nullptr;
         other.m_camera = nullptr;
         other.m_viewport = nullptr;
@@ -55,6 +59,10 @@ namespace engine {
             m_camera = other.m_camera;
             m_viewport = other.m_viewport;
             m_viewports = std::move(other.m_viewports);
+            m_quad_positions = std::move(other.m_quad_positions);
+            m_quad_colors = std::move(other.m_quad_colors);
+            m_quad_uvs = std::move(other.m_quad_uvs);
+            m_quad_indices = std::move(other.m_quad_indices);
 
             // Reset other
             other.m_sdl_text_engine = nullptr;
@@ -137,6 +145,77 @@ namespace engine {
                                  sprite->get_rotation(), &center, SDL_FLIP_NONE);
     }
 
+    void game_renderer::quads_draw_world(const game_sprite* sprite,
+                                         const game_quad_batch& batch) {
+        static_assert(sizeof(SDL_FColor) == 4 * sizeof(float));
+
+        if (batch.count == 0 || (sprite != nullptr && sprite->is_valid() == false)) {
+            return;
+        }
+
+        // The view is a scale and an offset, so one pair of them places every corner.
+        glm::vec2 offset = {0.0f, 0.0f};
+        float zoom = 1.0f;
+        if (m_camera != nullptr && m_viewport != nullptr) {
+            offset = m_viewport->world_to_screen(*m_camera, {0.0f, 0.0f});
+            zoom = m_camera->get_zoom();
+        }
+
+        const std::size_t vertex_count = batch.count * 4;
+        m_quad_positions.resize(vertex_count * 2);
+        m_quad_colors.resize(vertex_count * 4);
+
+        const bool has_velocity = batch.velocity_x != nullptr && batch.velocity_y != nullptr;
+        for (std::size_t i = 0; i < batch.count; ++i) {
+            float x = batch.x[i];
+            float y = batch.y[i];
+            if (has_velocity == true) {
+                x += batch.velocity_x[i] * batch.lead_seconds;
+                y += batch.velocity_y[i] * batch.lead_seconds;
+            }
+
+            const float half = batch.sizes[i] * 0.5f * zoom;
+            const float left = (x * zoom) + offset.x - half;
+            const float top = (y * zoom) + offset.y - half;
+            const float right = left + (half * 2.0f);
+            const float bottom = top + (half * 2.0f);
+
+            float* position = &m_quad_positions[i * 8];
+            position[0] = left;
+            position[1] = top;
+            position[2] = right;
+            position[3] = top;
+            position[4] = right;
+            position[5] = bottom;
+            position[6] = left;
+            position[7] = bottom;
+
+            float* color = &m_quad_colors[i * 16];
+            for (std::size_t corner = 0; corner < 4; ++corner) {
+                color[(corner * 4) + 0] = batch.red[i];
+                color[(corner * 4) + 1] = batch.green[i];
+                color[(corner * 4) + 2] = batch.blue[i];
+                color[(corner * 4) + 3] = batch.alpha[i];
+            }
+        }
+
+        // Texture coordinates and indices only depend on the count, so they only ever grow.
+        for (std::size_t i = m_quad_indices.size() / 6; i < batch.count; ++i) {
+            const auto first = static_cast<std::uint32_t>(i * 4);
+            m_quad_indices.insert(m_quad_indices.end(), {first, first + 1, first + 2, first,
+                                                         first + 2, first + 3});
+            m_quad_uvs.insert(m_quad_uvs.end(),
+                              {0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f});
+        }
+
+        SDL_RenderGeometryRaw(
+            m_renderer.native_handle(), sprite != nullptr ? sprite->get_sdl_texture() : nullptr,
+            m_quad_positions.data(), 2 * sizeof(float),
+            reinterpret_cast<const SDL_FColor*>(m_quad_colors.data()), sizeof(SDL_FColor),
+            m_quad_uvs.data(), 2 * sizeof(float), static_cast<int>(vertex_count),
+            m_quad_indices.data(), static_cast<int>(batch.count * 6), sizeof(std::uint32_t));
+    }
+
     void game_renderer::text_draw_world(const game_text_dynamic* text,
                                         const glm::vec2& world_position) {
         if (text == nullptr || text->is_valid() == false) {
@@ -3,10 +3,12 @@
 #include "sprite.hxx"
 #include "text.hxx"
 
+#include <cstdint>
 #include <unordered_map>
 #include <memory>
 #include <string_view>
 #include <string>
+#include <vector>
 
 #include <laya/renderers/renderer.hpp>
 
@@ -17,6 +19,30 @@ namespace engine {
     class game_camera;
     class game_viewport;
 
+    /**
+     * @brief Square quads drawn together, given as one array per value so particle pools can be
+     *        drawn without copying. Colours run from 0 to 1.
+     */
+    struct game_quad_batch {
+        const float* x = nullptr;
+        const float* y = nullptr;
+        const float* sizes = nullptr;
+        const float* red = nullptr;
+        const float* green = nullptr;
+        const float* blue = nullptr;
+        const float* alpha = nullptr;
+
+        /**
+         * @brief Optional velocities, each quad being drawn `lead_seconds` further along them to
+         *        smooth motion between fixed ticks.
+         */
+        const float* velocity_x = nullptr;
+        const float* velocity_y = nullptr;
+        float lead_seconds = 0.0f;
+
+        std::size_t count = 0;
+    };
+
     /**
      * @brief Handles rendering of sprites and text with support for camera and viewport.
      */
@@ -62,6 +88,14 @@ namespace engine {
         void sprite_draw_world(const game_sprite* sprite, const glm::vec2& world_position);
         void sprite_draw_screen(const game_sprite* sprite, const glm::vec2& screen_position);
 
+        /**
+         * @brief Draw every quad of a batch centred on its world position, in a single geometry
+         *        call.
+         * @param sprite Texture stretched over each quad, or null for flat coloured squares.
+         * @note Quads are not culled one by one, the GPU clips those out of view.
+         */
+        void quads_draw_world(const game_sprite* sprite, const game_quad_batch& batch);
+
         void text_draw_world(const game_text_dynamic* text, const glm::vec2& world_position);
         void text_draw_screen(const game_text_dynamic* text, const glm::vec2& screen_position);
 
@@ -81,6 +115,12 @@ namespace engine {
         const game_camera* m_camera;
         const game_viewport* m_viewport;
         std::unordered_map<std::string, std::unique_ptr<game_viewport>> m_viewports;
+
+        // Vertex scratch of `quads_draw_world`, kept for its storage.
+        std::vector<float> m_quad_positions;
+        std::vector<float> m_quad_colors;
+        std::vector<float> m_quad_uvs;
+        std::vector<std::uint32_t> m_quad_indices;
     };
 
     inline SDL_Renderer* game_renderer::get_sdl_renderer() const {
@@ -0,0 +1,102 @@
+/**
+ * @file jobs.cxx
+ * @brief Time-sliced jobs implementation.
+ */
+
+#include "jobs.hxx"
+
+#include <algorithm>
+#include "timing.hxx"
+
+namespace engine {
+    bool game_jobs::add(std::string_view name, const game_job_function function,
+                        const std::uint32_t budget_microseconds, const game_job_phase phase,
+                        void* user_data) {
+        if (function == nullptr || find(name) != nullptr) {
+            return false;
+        }
+
+        const float budget_seconds = static_cast<float>(budget_microseconds) * 1e-6f;
+        m_jobs.push_back({std::string(name), function, user_data, budget_seconds, phase, {}});
+
+        return true;
+    }
+
+    bool game_jobs::remove(std::string_view name) {
+        const auto it = std::find_if(m_jobs.begin(), m_jobs.end(),
+                                     [&](const job_entry& job) { return job.name == name; });
+        if (it == m_jobs.end()) {
+            return false;
+        }
+
+        m_jobs.erase(it);
+
+        return true;
+    }
+
+    bool game_jobs::contains(std::string_view name) const {
+        return find(name) != nullptr;
+    }
+
+    bool game_jobs::is_finished(std::string_view name) const {
+        const job_entry* job = find(name);
+        return job != nullptr && job->stats.is_finished == true;
+    }
+
+    game_job_stats game_jobs::get_stats(std::string_view name) const {
+        const job_entry* job = find(name);
+        return job != nullptr ? job->stats : game_job_stats{};
+    }
+
+    void game_jobs::run(const game_job_phase phase) {
+        for (job_entry& job : m_jobs) {
+            const bool is_due =
+                (static_cast<std::uint8_t>(job.phase) & static_cast<std::uint8_t>(phase)) != 0;
+
+            if (is_due == true && job.stats.is_finished == false) {
+                run_slice(job);
+            }
+        }
+    }
+
+    const game_jobs::job_entry* game_jobs::find(std::string_view name) const {
+        for (const job_entry& job : m_jobs) {
+            if (job.name == name) {
+                return &job;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void game_jobs::run_slice(job_entry& job) {
+        game_job_stats& stats = job.stats;
+        const std::uint64_t start = performance_counter_value_current();
+        float elapsed_seconds = 0.0f;
+        std::uint32_t steps = 0;
+
+        // Only start another step while one more of the slice's average step still fits.
+        do {
+            stats.progress = job.function(job.user_data);
+            ++steps;
+            elapsed_seconds = performance_counter_seconds_since(start);
+        } while (stats.progress < 1.0f &&
+                 elapsed_seconds + (elapsed_seconds / static_cast<float>(steps)) <=
+                     job.budget_seconds);
+
+        stats.step_count += steps;
+        ++stats.slice_count;
+        stats.total_seconds += elapsed_seconds;
+
+        if (stats.progress >= 1.0f) {
+            stats.progress = 1.0f;
+            stats.is_finished = true;
+        }
+
+        if (elapsed_seconds > job.budget_seconds) {
+            ++stats.overrun_count;
+            stats.overrun_seconds_max =
+                std::max(stats.overrun_seconds_max, elapsed_seconds - job.budget_seconds);
+        }
+    }
+}  // namespace engine
@@ -0,0 +1,107 @@
+/**
+ * @file jobs.hxx
+ * @brief Time-sliced jobs that spread long-running work over many ticks and frames.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine {
+    /**
+     * @brief Do one small, bounded step of a job.
+     * @return Overall progress, 1 or more once the job is done.
+     * @note Steps are never interrupted, so keep each one well below the job's budget.
+     */
+    using game_job_function = float (*)(void* user_data);
+
+    /**
+     * @brief When the engine gives a job its slice.
+     */
+    enum class game_job_phase : std::uint8_t {
+        tick = 1 << 0,   ///< After a tick's deferred commands were applied.
+        frame = 1 << 1,  ///< After the frame callbacks, before drawing.
+        tick_and_frame = tick | frame,
+    };
+
+    /**
+     * @brief Progress and budget accounting of one job.
+     */
+    struct game_job_stats {
+        float progress = 0.0f;
+        bool is_finished = false;
+
+        std::uint64_t slice_count = 0;  ///< Times the job was given its budget.
+        std::uint64_t step_count = 0;   ///< Calls to the job function.
+
+        std::uint64_t overrun_count = 0;  ///< Slices that ran past the budget.
+        float overrun_seconds_max = 0.0f;  ///< Largest amount a slice ran past the budget.
+
+        double total_seconds = 0.0;
+    };
+
+    /**
+     * @brief Resumable jobs run a budget at a time.
+     *
+     * Each slice calls the job function until it finishes or another step of the slice's average
+     * length would not fit in the job's budget. A job always makes at least one step per slice,
+     * so a slice only overruns when a step is much longer than the ones before it. Finished jobs
+     * stop running but keep their stats until removed.
+     *
+     * While the engine catches up with several ticks in a row only the last of them runs tick
+     * slices, so jobs never add to the backlog that caused the catch-up.
+     */
+    class game_jobs {
+    public:
+        game_jobs() = default;
+        ~game_jobs() = default;
+
+        game_jobs(const game_jobs&) = delete;
+        game_jobs& operator=(const game_jobs&) = delete;
+        game_jobs(game_jobs&&) = default;
+        game_jobs& operator=(game_jobs&&) = default;
+
+        /**
+         * @brief Register a job, it gets its first slice in the next matching phase.
+         * @return False if a job with this name already exists.
+         */
+        bool add(std::string_view name, game_job_function function,
+                 std::uint32_t budget_microseconds, game_job_phase phase = game_job_phase::tick,
+                 void* user_data = nullptr);
+
+        /**
+         * @brief Forget a job, finished or not.
+         */
+        bool remove(std::string_view name);
+
+        [[nodiscard]] bool contains(std::string_view name) const;
+        [[nodiscard]] bool is_finished(std::string_view name) const;
+        [[nodiscard]] game_job_stats get_stats(std::string_view name) const;
+
+        /**
+         * @brief Give every unfinished job of `phase` one slice, in registration order.
+         * @note The engine calls this itself, a job must not add or remove jobs from its step.
+         */
+        void run(game_job_phase phase);
+
+    private:
+        struct job_entry {
+            std::string name;
+            game_job_function function;
+            void* user_data;
+            float budget_seconds;
+            game_job_phase phase;
+            game_job_stats stats;
+        };
+
+        [[nodiscard]] const job_entry* find(std::string_view name) const;
+
+        static void run_slice(job_entry& job);
+
+    private:
+        std::vector<job_entry> m_jobs;
+    };
+}  // namespace engine
@@ -35,7 +35,9 @@ namespace engine {
           m_fonts(std::move(other.m_fonts)),
           m_static_texts(std::move(other.m_static_texts)),
           m_dynamic_texts(std::move(other.m_dynamic_texts)),
-          m_renderer(other.m_renderer) {
+          m_renderer(other.m_renderer),
+          m_generation(other.m_generation) {
+        ++other.m_generation;
     }
 
     game_resources& game_resources::operator=(game_resources&& other) noexcept {
@@ -52,6 +54,7 @@ namespace engine {
             m_static_texts = std::move(other.m_static_texts);
             m_dynamic_texts = std::move(other.m_dynamic_texts);
             m_renderer = other.m_renderer;
+            ++other.m_generation;
         }
 
         return *this;
@@ -68,6 +71,7 @@ namespace engine {
         auto sprite = std::make_unique<game_sprite>(file_path, texture);
         auto* sprite_ptr = sprite.get();
         m_sprites[std::string(key)] = std::move(sprite);
+        ++m_generation;
 
         laya::log_info("Created sprite: {}", key);
 
@@ -84,6 +88,7 @@ namespace engine {
         if (it != m_sprites.end()) {
             laya::log_info("Destroyed sprite: {}", key);
             m_sprites.erase(it);
+            ++m_generation;
         }
     }
 
@@ -220,6 +225,7 @@ namespace engine {
                                                             m_renderer->get_sdl_renderer(), font);
         game_text_dynamic* ptr = text_obj.get();
         m_dynamic_texts[std::string(key)] = std::move(text_obj);
+        ++m_generation;
 
         laya::log_info("Created dynamic text resource: {}", key);
         return ptr;
@@ -248,12 +254,14 @@ namespace engine {
         if (it != m_dynamic_texts.end()) {
             laya::log_info("Unloaded dynamic text: {}", key);
             m_dynamic_texts.erase(it);
+            ++m_generation;
         }
     }
 
     void game_resources::sprites_clear() {
         laya::log_info("Unloading {} sprite resources.", m_sprites.size());
         m_sprites.clear();
+        ++m_generation;
     }
 
     void game_resources::texts_clear() {
@@ -262,5 +270,6 @@ namespace engine {
 
         laya::log_info("Unloading {} dynamic text resources.", m_dynamic_texts.size());
         m_dynamic_texts.clear();
+        ++m_generation;
     }
 }  // namespace engine
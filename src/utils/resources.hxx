@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <unordered_map>
 #include <string>
 #include <memory>
@@ -49,6 +50,12 @@ namespace engine {
         void sprites_clear();
         void texts_clear();
 
+        /**
+         * @brief Changes whenever a sprite or dynamic text is created or destroyed.
+         * @note Lets callers that cache resource pointers know when to look them up again.
+         */
+        [[nodiscard]] std::uint64_t get_generation() const noexcept;
+
     private:
         SDL_Texture* texture_get_or_create(std::string_view file_path);
         void texture_destroy(std::string_view file_path);
@@ -68,5 +75,10 @@ namespace engine {
         std::unordered_map<std::string, game_text_dynamic::uptr> m_dynamic_texts;
 
         game_renderer* m_renderer;
+        std::uint64_t m_generation = 0;
     };
+
+    inline std::uint64_t game_resources::get_generation() const noexcept {
+        return m_generation;
+    }
 }  // namespace engine
@@ -24,6 +24,15 @@ namespace engine {
           m_viewports() {
         paranoid_ensure(name.empty() != true, "Scene name cannot be empty");
 
+        // Physics, flow fields, flocking, particles and scheduled systems are spread over the
+        // engine's workers; results do not depend on the thread count.
+        m_entities->get_physics_settings().workers = engine->get_workers();
+        m_entities->get_flow_settings().workers = engine->get_workers();
+        m_entities->get_flocking_settings().workers = engine->get_workers();
+        m_entities->get_particles_settings().workers = engine->get_workers();
+        m_entities->systems().set_workers(engine->get_workers());
+        m_entities->set_spatial_resources(m_resources.get());
+
         m_cameras[std::string(game_camera::default_name)] =
             std::make_unique<game_camera>(game_camera::default_name, glm::vec2{0.0f, 0.0f}, 1.0f);
 
@@ -144,8 +153,18 @@ namespace engine {
         }
     }
 
+    void game_scene::update_lod_focus() {
+        std::vector<glm::vec2>& focus = m_entities->get_physics_settings().lod_focus;
+        focus.clear();
+
+        for (const auto& [camera_name, camera] : m_cameras) {
+            focus.push_back(camera->get_position());
+        }
+    }
+
     void game_scenes::on_engine_tick(const float tick_interval) {
         if (game_scene* active_scene = get_active_scene(); active_scene != nullptr) {
+            active_scene->update_lod_focus();
             invoke_void(active_scene->get_callbacks().on_tick, active_scene, tick_interval);
         }
     }
@@ -168,6 +187,13 @@ namespace engine {
         }
     }
 
+    void game_scenes::on_engine_sync() {
+        // Commands may be recorded into any loaded scene, not only the active one.
+        for (auto& [scene_id, scene] : m_scenes) {
+            scene->get_entities()->deferred_flush();
+        }
+    }
+
     void game_scenes::update_renderer_for_active_scene() {
         if (game_scene* active_scene = get_active_scene(); active_scene != nullptr) {
             if (game_renderer* renderer = m_engine->get_renderer(); renderer != nullptr) {
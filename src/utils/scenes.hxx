@@ -78,6 +78,12 @@ namespace engine {
         [[nodiscard]] game_camera* get_camera(std::string_view name);
         [[nodiscard]] game_viewport* get_viewport(std::string_view name);
 
+        /**
+         * @brief Measure physics update-rate LOD from this scene's cameras.
+         * @note Called by `game_scenes` before every tick of the active scene.
+         */
+        void update_lod_focus();
+
     private:
         std::string m_name;
 
@@ -166,6 +172,11 @@ namespace engine {
         void on_engine_draw(float fraction_to_next_tick);
         void on_engine_input();
 
+        /**
+         * @brief Sync point after each tick, applies deferred entity commands of every scene.
+         */
+        void on_engine_sync();
+
     private:
         void update_renderer_for_active_scene();
         void reset_renderer_to_global();
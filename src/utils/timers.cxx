@@ -0,0 +1,93 @@
+/**
+ * @file timers.cxx
+ * @brief Hierarchical timing wheel implementation.
+ */
+
+#include "timers.hxx"
+
+#include <algorithm>
+
+namespace engine {
+    void game_timer_wheel::insert(const std::uint64_t expiry_tick, const std::uint64_t key) {
+        place({std::max(expiry_tick, m_tick + 1), key});
+        ++m_size;
+    }
+
+    void game_timer_wheel::advance(std::vector<std::uint64_t>& expired) {
+        constexpr std::uint64_t mask = buckets_per_level - 1;
+
+        ++m_tick;
+
+        // Crossing into a new bucket of a higher level files its timers one level closer. Go
+        // from the highest level that rolled over downwards, so nothing is skipped on the way.
+        if ((m_tick & mask) == 0) {
+            int top = 1;
+            while (top < level_count && ((m_tick >> (bits_per_level * top)) & mask) == 0) {
+                ++top;
+            }
+
+            if (top == level_count) {
+                m_cascading.clear();
+                m_cascading.swap(m_far);
+
+                for (const entry& timer : m_cascading) {
+                    place(timer);
+                }
+            }
+
+            for (int level_index = std::min(top, level_count - 1); level_index > 0; --level_index) {
+                cascade(level_index);
+            }
+        }
+
+        std::vector<entry>& bucket = m_levels[0][m_tick & mask];
+        for (const entry& timer : bucket) {
+            expired.push_back(timer.key);
+        }
+
+        m_size -= bucket.size();
+        bucket.clear();
+    }
+
+    void game_timer_wheel::clear() {
+        for (level& buckets : m_levels) {
+            for (std::vector<entry>& bucket : buckets) {
+                bucket.clear();
+            }
+        }
+
+        m_far.clear();
+        m_size = 0;
+    }
+
+    void game_timer_wheel::place(const entry& timer) {
+        constexpr std::uint64_t mask = buckets_per_level - 1;
+
+        // A timer lives on the lowest level whose window it shares with the current tick.
+        for (int level_index = 0; level_index < level_count; ++level_index) {
+            const int window_shift = bits_per_level * (level_index + 1);
+
+            if ((timer.expiry_tick >> window_shift) == (m_tick >> window_shift)) {
+                const std::uint64_t bucket =
+                    (timer.expiry_tick >> (bits_per_level * level_index)) & mask;
+                m_levels[level_index][bucket].push_back(timer);
+                return;
+            }
+        }
+
+        m_far.push_back(timer);
+    }
+
+    void game_timer_wheel::cascade(const int level_index) {
+        constexpr std::uint64_t mask = buckets_per_level - 1;
+        std::vector<entry>& bucket =
+            m_levels[level_index][(m_tick >> (bits_per_level * level_index)) & mask];
+
+        m_cascading.clear();
+        m_cascading.swap(bucket);
+
+        for (const entry& timer : m_cascading) {
+            place(timer);
+        }
+    }
+}  // namespace engine
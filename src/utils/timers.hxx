@@ -0,0 +1,87 @@
+/**
+ * @file timers.hxx
+ * @brief Hierarchical timing wheel for scheduling work on future ticks.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+    /**
+     * @brief Hierarchical timing wheel keyed by expiry tick.
+     *
+     * Timers are filed into one of four levels of 256 buckets depending on how far away they
+     * expire, and move down a level only when the wheel reaches their bucket. Advancing a tick
+     * therefore costs time proportional to the timers that actually expire (plus an occasional
+     * cascade), no matter how many are scheduled.
+     *
+     * The wheel only stores opaque 64-bit keys; cancelling is left to the owner, which can
+     * simply ignore keys that are no longer interesting when they come out.
+     */
+    class game_timer_wheel {
+    public:
+        game_timer_wheel() = default;
+        ~game_timer_wheel() = default;
+
+        game_timer_wheel(const game_timer_wheel&) = delete;
+        game_timer_wheel& operator=(const game_timer_wheel&) = delete;
+        game_timer_wheel(game_timer_wheel&&) = default;
+        game_timer_wheel& operator=(game_timer_wheel&&) = default;
+
+        /**
+         * @brief The last tick that `advance` reached.
+         */
+        [[nodiscard]] std::uint64_t get_tick() const noexcept;
+
+        /**
+         * @brief Number of keys waiting in the wheel, including ones the owner has abandoned.
+         */
+        [[nodiscard]] std::size_t get_size() const noexcept;
+
+        /**
+         * @brief Schedule `key` to come out of `advance` on `expiry_tick`.
+         * @note Ticks that already passed are moved to the next tick.
+         */
+        void insert(std::uint64_t expiry_tick, std::uint64_t key);
+
+        /**
+         * @brief Move to the next tick and append every key due on it to `expired`.
+         */
+        void advance(std::vector<std::uint64_t>& expired);
+
+        void clear();
+
+    private:
+        struct entry {
+            std::uint64_t expiry_tick;
+            std::uint64_t key;
+        };
+
+        static constexpr int bits_per_level = 8;
+        static constexpr std::size_t buckets_per_level = std::size_t{1} << bits_per_level;
+        static constexpr int level_count = 4;
+
+        using level = std::array<std::vector<entry>, buckets_per_level>;
+
+        void place(const entry& timer);
+        void cascade(int level_index);
+
+    private:
+        std::array<level, level_count> m_levels;
+        std::vector<entry> m_far;  ///< Timers beyond the top level, refiled when it wraps.
+        std::vector<entry> m_cascading;
+        std::uint64_t m_tick = 0;
+        std::size_t m_size = 0;
+    };
+
+    inline std::uint64_t game_timer_wheel::get_tick() const noexcept {
+        return m_tick;
+    }
+
+    inline std::size_t game_timer_wheel::get_size() const noexcept {
+        return m_size;
+    }
+}  // namespace engine
@@ -0,0 +1,161 @@
+/**
+ * @file workers.cxx
+ * @brief Worker pool implementation.
+ */
+
+#include "workers.hxx"
+
+#include <algorithm>
+#include <SDL3/SDL.h>
+
+namespace engine {
+    namespace {
+        /**
+         * @brief Pool whose tasks the current thread is running, if any.
+         */
+        thread_local const game_workers* running_pool = nullptr;
+    }  // namespace
+
+    game_workers::game_workers(const std::size_t thread_count)
+        : m_threads(),
+          m_dispatch_mutex(),
+          m_mutex(),
+          m_wake(),
+          m_done(),
+          m_task(nullptr),
+          m_user_data(nullptr),
+          m_task_count(0),
+          m_tasks_finished(0),
+          m_workers_active(0),
+          m_generation(0),
+          m_is_stopping(false),
+          m_next_task(0) {
+        const std::size_t background_count = std::max<std::size_t>(thread_count, 1) - 1;
+
+        m_threads.reserve(background_count);
+        for (std::size_t i = 0; i < background_count; ++i) {
+            m_threads.emplace_back(&game_workers::worker_loop, this);
+        }
+    }
+
+    game_workers::~game_workers() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_is_stopping = true;
+        }
+
+        m_wake.notify_all();
+
+        for (std::thread& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    std::size_t game_workers::default_thread_count() {
+        return static_cast<std::size_t>(std::max(SDL_GetNumLogicalCPUCores(), 1));
+    }
+
+    void game_workers::parallel_for(const std::size_t task_count, const task_function task,
+                                    void* user_data) {
+        if (task_count == 0 || task == nullptr) {
+            return;
+        }
+
+        // Tasks of this pool that dispatch again run inline, the pool is already theirs.
+        std::unique_lock dispatch(m_dispatch_mutex, std::defer_lock);
+        if (running_pool != this) {
+            dispatch.try_lock();
+        }
+
+        if (m_threads.empty() == true || task_count == 1 || dispatch.owns_lock() == false) {
+            // A lone task may dispatch on its own, so it does not keep the pool.
+            if (dispatch.owns_lock() == true) {
+                dispatch.unlock();
+            }
+
+            for (std::size_t i = 0; i < task_count; ++i) {
+                task(i, user_data);
+            }
+            return;
+        }
+
+        {
+            std::unique_lock lock(m_mutex);
+
+            // A worker that woke up late for the previous dispatch may still hold its task.
+            m_done.wait(lock, [this] { return m_workers_active == 0; });
+
+            m_task = task;
+            m_user_data = user_data;
+            m_task_count = task_count;
+            m_tasks_finished = 0;
+            m_next_task.store(0, std::memory_order_relaxed);
+            ++m_generation;
+        }
+
+        m_wake.notify_all();
+
+        const std::size_t finished = run_tasks(task, user_data, task_count);
+
+        std::unique_lock lock(m_mutex);
+        m_tasks_finished += finished;
+        m_done.wait(lock, [this] {
+            return m_tasks_finished == m_task_count && m_workers_active == 0;
+        });
+    }
+
+    void game_workers::worker_loop() {
+        std::uint64_t seen_generation = 0;
+
+        while (true) {
+            task_function task = nullptr;
+            void* user_data = nullptr;
+            std::size_t task_count = 0;
+
+            {
+                std::unique_lock lock(m_mutex);
+                m_wake.wait(lock, [&] {
+                    return m_is_stopping == true || m_generation != seen_generation;
+                });
+
+                if (m_is_stopping == true) {
+                    return;
+                }
+
+                seen_generation = m_generation;
+                task = m_task;
+                user_data = m_user_data;
+                task_count = m_task_count;
+                ++m_workers_active;
+            }
+
+            const std::size_t finished = run_tasks(task, user_data, task_count);
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_tasks_finished += finished;
+                --m_workers_active;
+            }
+
+            m_done.notify_all();
+        }
+    }
+
+    std::size_t game_workers::run_tasks(const task_function task, void* user_data,
+                                        const std::size_t task_count) {
+        std::size_t finished = 0;
+
+        const game_workers* const previous_pool = running_pool;
+        running_pool = this;
+
+        for (std::size_t i = m_next_task.fetch_add(1, std::memory_order_relaxed); i < task_count;
+             i = m_next_task.fetch_add(1, std::memory_order_relaxed)) {
+            task(i, user_data);
+            ++finished;
+        }
+
+        running_pool = previous_pool;
+
+        return finished;
+    }
+}  // namespace engine
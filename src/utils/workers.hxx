@@ -0,0 +1,91 @@
+/**
+ * @file workers.hxx
+ * @brief A small pool of worker threads for data-parallel engine work.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine {
+    /**
+     * @brief Fixed pool of worker threads that run indexed tasks in parallel.
+     *
+     * The calling thread always takes part in `parallel_for`, so a pool of one thread simply runs
+     * everything inline. Only one `parallel_for` is in flight at a time; calls made while the pool
+     * is busy (for example from inside a task) run inline on the calling thread instead of
+     * deadlocking.
+     */
+    class game_workers {
+    public:
+        /**
+         * @brief A task invoked once per index, must not throw.
+         */
+        using task_function = void (*)(std::size_t task_index, void* user_data);
+
+        game_workers() = delete;
+
+        /**
+         * @brief Start a pool.
+         * @param thread_count Total threads including the caller, clamped to at least one.
+         */
+        explicit game_workers(std::size_t thread_count);
+        ~game_workers();
+
+        game_workers(const game_workers&) = delete;
+        game_workers& operator=(const game_workers&) = delete;
+        game_workers(game_workers&&) = delete;
+        game_workers& operator=(game_workers&&) = delete;
+
+        /**
+         * @brief Number of logical cores, which is what the engine's own pool uses.
+         */
+        [[nodiscard]] static std::size_t default_thread_count();
+
+        /**
+         * @brief Total threads that run tasks, including the caller of `parallel_for`.
+         */
+        [[nodiscard]] std::size_t get_thread_count() const noexcept;
+
+        /**
+         * @brief Run `task(i, user_data)` for every `i` in `[0, task_count)` and wait for all of
+         *        them to finish.
+         * @note Tasks are claimed in any order by any thread, so they must not depend on each
+         *       other or on which thread runs them.
+         */
+        void parallel_for(std::size_t task_count, task_function task, void* user_data);
+
+    private:
+        void worker_loop();
+        std::size_t run_tasks(task_function task, void* user_data, std::size_t task_count);
+
+    private:
+        std::vector<std::thread> m_threads;
+
+        std::mutex m_dispatch_mutex;  ///< Held by the thread that owns the current dispatch.
+
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+
+        task_function m_task;
+        void* m_user_data;
+        std::size_t m_task_count;
+        std::size_t m_tasks_finished;
+        std::size_t m_workers_active;
+        std::uint64_t m_generation;
+        bool m_is_stopping;
+
+        std::atomic<std::size_t> m_next_task;
+    };
+
+    inline std::size_t game_workers::get_thread_count() const noexcept {
+        return m_threads.size() + 1;
+    }
+}  // namespace engine